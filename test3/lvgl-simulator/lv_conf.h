@@ -48,6 +48,20 @@
 #if LV_MEM_CUSTOM == 0
 /*Size of the memory available for `lv_mem_alloc()` in bytes (>= 2kB)*/
 #define LV_MEM_SIZE (320U * 1024U)
+
+/*Allocate the blocks up to this size from pages of fixed size classes (8, 16, 24, 32, 48, 64, 96, 128, 192, 256, 384, 512 bytes)
+ *instead of the general allocator. It's faster and reduces the fragmentation caused by many small allocations.
+ *Larger blocks still use the general allocator. [bytes] 0: disable the size classes*/
+#define LV_MEM_SLAB_MAX_SIZE 0
+
+/*Make `lv_mem_alloc()`, `lv_mem_free()` and `lv_mem_realloc()` callable from any thread (requires pthread).
+ *The other LVGL functions (including `lv_mem_buf_get()`) still can be called only from the UI thread.*/
+#define LV_MEM_THREAD_SAFE 0
+#if LV_MEM_THREAD_SAFE
+    /*Number of freed small blocks (<= 256 bytes) kept per size by each thread to reuse them without locking.
+     *0: always lock*/
+    #define LV_MEM_THREAD_CACHE_CNT 8
+#endif
 #else     /* LV_MEM_CUSTOM */
 /*Header for the dynamic memory function*/
 #define LV_MEM_CUSTOM_INCLUDE <stdlib.h>
@@ -63,6 +77,17 @@
  *You will see an error log message if there wasn't enough buffers. */
 #define LV_MEM_BUF_MAX_NUM 16
 
+/*Serve the intermediate buffers from a static arena instead of `LV_MEM_BUF_MAX_NUM` slots allocated by `lv_mem_alloc()`.
+ *The buffers are taken from the arena with a bump pointer and it's reset after every refresh.
+ *If it's not enough extra chunks are allocated for the frame. `lv_mem_buf_arena_monitor()` tells the required size.
+ *[bytes] 0: use the slots*/
+#define LV_MEM_BUF_ARENA_SIZE 0
+
+/*Record which subsystem (objects, styles, image cache, fonts, etc) allocated each memory block.
+ *`lv_mem_tag_monitor()` and `lv_mem_tag_dump()` tell the live heap usage per subsystem.
+ *Adds a small header to each allocation, the counters are updated in constant time.*/
+#define LV_MEM_TAG 0
+
 /*Use the standard `memcpy` and `memset` instead of LVGL's own functions. (Might or might not be faster).*/
 #define LV_MEMCPY_MEMSET_STD 0
 
@@ -73,6 +98,10 @@
 /*Default display refresh period in milliseconds. LVG will redraw changed areas with this period time*/
 #define LV_DISP_DEF_REFR_PERIOD 30
 
+/*1: Step the animations right before a display is refreshed instead of in their own timer.
+ *The animations are evaluated at the expected time of showing the frame (start + average render time)*/
+#define LV_ANIM_REFR_SYNC 0
+
 /*Input device read period in milliseconds*/
 #define LV_INDEV_DEF_READ_PERIOD 30
 
@@ -130,6 +159,27 @@
 #define LV_LAYER_SIMPLE_BUF_SIZE (24U * 1024U)
 #define LV_LAYER_SIMPLE_FALLBACK_BUF_SIZE (3U * 1024U)
 
+/*Number of layer buffers to keep for reuse when a layer is destroyed (per display).
+ *The next layers (e.g. in the next band or frame) can use them instead of allocating new buffers.
+ *The kept buffers are freed if a new buffer can't be allocated. 0: always free the layer buffers*/
+#define LV_LAYER_BUF_POOL_CNT 0
+
+/*Objects with `LV_OBJ_FLAG_RENDER_CACHE` are rendered once together with their children
+ *and redrawn from the rendered image until something changes in them. Moving them only moves the image.
+ *[bytes] the max. memory all the cached images can use together. 0: to disable the render cache*/
+#define LV_OBJ_RENDER_CACHE_SIZE 0
+
+/*Cache the resolved values of the frequently used style properties (background, border, outline, shadow,
+ *padding, text, radius and opacity) per object and part, so drawing doesn't have to look them up in the styles.
+ *Styles modified after they were added to objects need `lv_obj_report_style_change()` to update the cache.
+ *It uses about 50 * `sizeof(void *)` bytes for each drawn part of the objects*/
+#define LV_OBJ_STYLE_CACHE 0
+
+/*If the draw buffer is smaller than an area to redraw, record the draw operations of the area once
+ *and replay them in every band instead of drawing the widgets again for each band.
+ *[bytes] the max. size of the recorded draw operations. 0: to disable the draw list*/
+#define LV_DRAW_LIST_SIZE 0
+
 /*Default image cache size. Image caching keeps the images opened.
  *If only the built-in image formats are used there is no real advantage of caching. (I.e. if no new image decoder is added)
  *With complex image decoders (e.g. PNG or JPG) caching can save the continuous open/decode of images.
@@ -163,6 +213,12 @@
  *Only used if software rotation is enabled in the display driver.*/
 #define LV_DISP_ROT_MAX_BUF (10U * 1024U)
 
+/*In direct mode move the already rendered content of the scrolled objects in the frame buffer
+ *and redraw only the newly exposed parts instead of the whole object.
+ *Used only for opaque, not transformed objects which don't draw anything else than their children
+ *(e.g. simple containers and lists) and only without rotation.*/
+#define LV_USE_SCROLL_COPY 0
+
 /*-------------
  * GPU
  *-----------*/
@@ -479,6 +535,11 @@
  *----------*/
 
 #define LV_USE_ANALOGCLOCK 0
+#if LV_USE_ANALOGCLOCK
+/*1: Render the ticks and labels once into a cached layer and redraw only the needles when the time changes.
+ *Needs `(width + ext. draw size) * (height + ext. draw size) * LV_IMG_PX_SIZE_ALPHA_BYTE` bytes from `lv_mem`*/
+#define LV_ANALOGCLOCK_CACHE_SCALE 0
+#endif    /* LV_USE_ANALOGCLOCK */
 
 #define LV_USE_ANIMIMG 1
 
@@ -532,6 +593,17 @@
 #define LV_USE_TILEVIEW 1
 
 #define LV_USE_VIDEO 0
+#if LV_USE_VIDEO
+/*1: Decode and convert the videos in separate threads and show the frames from an `lv_timer`.
+ *Used only with LV_USE_GUIDER_SIMULATOR. Requires pthread.*/
+#define LV_VIDEO_USE_THREADS 0
+#if LV_VIDEO_USE_THREADS
+/*Number of frame buffers: one is shown and the others are filled by the decoder threads (at least 2)*/
+#define LV_VIDEO_FRAME_CNT 3
+/*Number of decoder threads shared by all playing videos*/
+#define LV_VIDEO_THREAD_CNT 2
+#endif    /* LV_VIDEO_USE_THREADS */
+#endif    /* LV_USE_VIDEO */
 
 #define LV_USE_WIN 1
 
@@ -634,6 +706,13 @@
 
 /*PNG decoder library*/
 #define LV_USE_PNG 0
+#if LV_USE_PNG
+/*1: Decode large PNGs row by row while drawing instead of decoding the whole image on open.
+ *Lowers the peak memory usage as no 32 bit copy of the image is created.*/
+#define LV_PNG_STREAM_DECODE 0
+/*Stream only the images having at least this many pixels*/
+#define LV_PNG_STREAM_MIN_PX (128 * 128)
+#endif    /* LV_USE_PNG */
 
 /*BMP decoder library*/
 #define LV_USE_BMP 0
@@ -641,9 +720,26 @@
 /* JPG + split JPG decoder library.
  * Split JPG is a custom format optimized for embedded systems. */
 #define LV_USE_SJPG 0
+#if LV_USE_SJPG
+/*Memory for caching decoded fragments [bytes]. At least one fragment is always cached.*/
+#define LV_SJPG_FRAG_CACHE_SIZE 0
+/*1: Decode the next fragments in the direction of reading in worker threads. Requires pthread.*/
+#define LV_SJPG_USE_THREADS 0
+#if LV_SJPG_USE_THREADS
+/*Number of worker threads*/
+#define LV_SJPG_THREAD_CNT 2
+/*Fragments to decode ahead. Limited by the fragments fitting into `LV_SJPG_FRAG_CACHE_SIZE`*/
+#define LV_SJPG_PREFETCH_CNT 2
+#endif    /* LV_SJPG_USE_THREADS */
+#endif    /* LV_USE_SJPG */
 
 /*GIF decoder library*/
 #define LV_USE_GIF 0
+#if LV_USE_GIF
+/*Memory for keeping the composed frames of looping GIFs to replay them without decoding [bytes].
+ *0: disable the frame cache*/
+#define LV_GIF_CACHE_SIZE 0
+#endif    /* LV_USE_GIF */
 
 /*QR code library*/
 #define LV_USE_QRCODE 1
@@ -667,6 +763,16 @@
 
 /*Rlottie library*/
 #define LV_USE_RLOTTIE 0
+#if LV_USE_RLOTTIE
+/*1: Render the next frames in a worker thread while the current one is shown. Requires pthread.*/
+#define LV_RLOTTIE_USE_THREADS 0
+#if LV_RLOTTIE_USE_THREADS
+/*Number of frame buffers: one is shown and the others are rendered ahead (at least 2)*/
+#define LV_RLOTTIE_RING_SIZE 3
+#endif    /* LV_RLOTTIE_USE_THREADS */
+/*Memory to keep all the frames of an animation if they fit into it [bytes]. 0: disable*/
+#define LV_RLOTTIE_CACHE_SIZE 0
+#endif    /* LV_USE_RLOTTIE */
 
 /*FFmpeg library for image decoding and playing videos
  *Supports all major image formats so do not enable other image decoder with it*/
@@ -674,6 +780,12 @@
 #if LV_USE_FFMPEG
 /*Dump input information to stderr*/
 #define LV_FFMPEG_DUMP_FORMAT 0
+/*1: Decode the video in a separate thread into a queue of frames. Requires pthread.*/
+#define LV_FFMPEG_PLAYER_USE_THREADS 0
+#if LV_FFMPEG_PLAYER_USE_THREADS
+/*Number of frame buffers: one is shown and the others are filled by the decoder thread (at least 2)*/
+#define LV_FFMPEG_PLAYER_FRAME_CNT 3
+#endif    /* LV_FFMPEG_PLAYER_USE_THREADS */
 #endif    /* LV_USE_FFMPEG */
 
 /*-----------
@@ -272,6 +272,14 @@ bool lv_obj_remove_event_dsc(struct _lv_obj_t * obj, struct _lv_event_dsc_t * ev
  */
 void * lv_obj_get_event_user_data(struct _lv_obj_t * obj, lv_event_cb_t event_cb);
 
+/**
+ * Tell whether an object has an event handler which can draw on the object,
+ * i.e. it was added for `LV_EVENT_ALL` or for one of the drawing events
+ * @param obj               pointer to an object
+ * @return                  true: there is at least one drawing event handler
+ */
+bool _lv_obj_has_draw_event_cb(const struct _lv_obj_t * obj);
+
 /**
  * Get the input device passed as parameter to indev related events.
  * @param e     pointer to an event
@@ -139,7 +139,12 @@ void _lv_indev_scroll_throw_handler(_lv_indev_proc_t * proc)
             proc->types.pointer.scroll_throw_vect.y = elastic_diff(scroll_obj, proc->types.pointer.scroll_throw_vect.y, st, sb,
                                                                    LV_DIR_VER);
 
+#if LV_USE_SCROLL_COPY
+            /*Don't send SCROLL_BEGIN/END on every step to keep the copied area valid*/
+            _lv_obj_scroll_by_raw(scroll_obj, 0, proc->types.pointer.scroll_throw_vect.y);
+#else
             lv_obj_scroll_by(scroll_obj, 0, proc->types.pointer.scroll_throw_vect.y, LV_ANIM_OFF);
+#endif
         }
         /*With snapping find the nearest snap point and scroll there*/
         else {
@@ -163,7 +168,12 @@ void _lv_indev_scroll_throw_handler(_lv_indev_proc_t * proc)
             proc->types.pointer.scroll_throw_vect.x = elastic_diff(scroll_obj, proc->types.pointer.scroll_throw_vect.x, sl, sr,
                                                                    LV_DIR_HOR);
 
+#if LV_USE_SCROLL_COPY
+            /*Don't send SCROLL_BEGIN/END on every step to keep the copied area valid*/
+            _lv_obj_scroll_by_raw(scroll_obj, proc->types.pointer.scroll_throw_vect.x, 0);
+#else
             lv_obj_scroll_by(scroll_obj, proc->types.pointer.scroll_throw_vect.x, 0, LV_ANIM_OFF);
+#endif
         }
         /*With snapping find the nearest snap point and scroll there*/
         else {
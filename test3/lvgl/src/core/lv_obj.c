@@ -279,6 +279,10 @@ void lv_obj_clear_flag(lv_obj_t * obj, lv_obj_flag_t f)
 
     obj->flags &= (~f);
 
+#if LV_OBJ_RENDER_CACHE_SIZE
+    if(f & LV_OBJ_FLAG_RENDER_CACHE) _lv_refr_render_cache_free(obj);
+#endif
+
     if(f & LV_OBJ_FLAG_HIDDEN) {
         lv_obj_invalidate(obj);
         if(lv_obj_is_layout_positioned(obj)) {
@@ -364,7 +368,9 @@ void lv_obj_allocate_spec_attr(lv_obj_t * obj)
     if(obj->spec_attr == NULL) {
         static uint32_t x = 0;
         x++;
+        lv_mem_tag_t tag_prev = lv_mem_tag_set(LV_MEM_TAG_OBJ);
         obj->spec_attr = lv_mem_alloc(sizeof(_lv_obj_spec_attr_t));
+        lv_mem_tag_set(tag_prev);
         LV_ASSERT_MALLOC(obj->spec_attr);
         if(obj->spec_attr == NULL) return;
 
@@ -476,10 +482,17 @@ static void lv_obj_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
             lv_mem_free(obj->spec_attr->event_dsc);
             obj->spec_attr->event_dsc = NULL;
         }
+#if LV_OBJ_RENDER_CACHE_SIZE
+        _lv_refr_render_cache_free(obj);
+#endif
 
         lv_mem_free(obj->spec_attr);
         obj->spec_attr = NULL;
     }
+
+#if LV_OBJ_STYLE_CACHE
+    _lv_obj_style_cache_free(obj);
+#endif
 }
 
 static void lv_obj_draw(lv_event_t * e)
@@ -892,6 +905,11 @@ static void lv_obj_set_state(lv_obj_t * obj, lv_state_t new_state)
     /*If there is no difference in styles there is nothing else to do*/
     if(cmp_res == _LV_STYLE_STATE_CMP_SAME) return;
 
+#if LV_OBJ_STYLE_CACHE
+    /*The children can inherit the values of the new state*/
+    _lv_obj_style_cache_invalidate(obj, true);
+#endif
+
     _lv_obj_style_transition_dsc_t * ts = lv_mem_buf_get(sizeof(_lv_obj_style_transition_dsc_t) * STYLE_TRANSITION_MAX);
     lv_memset_00(ts, sizeof(_lv_obj_style_transition_dsc_t) * STYLE_TRANSITION_MAX);
     uint32_t tsi = 0;
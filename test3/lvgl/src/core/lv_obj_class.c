@@ -44,8 +44,12 @@ lv_obj_t * lv_obj_class_create_obj(const lv_obj_class_t * class_p, lv_obj_t * pa
 {
     LV_TRACE_OBJ_CREATE("Creating object with %p class on %p parent", (void *)class_p, (void *)parent);
     uint32_t s = get_instance_size(class_p);
+    lv_mem_tag_t tag_prev = lv_mem_tag_set(LV_MEM_TAG_OBJ);
     lv_obj_t * obj = lv_mem_alloc(s);
-    if(obj == NULL) return NULL;
+    if(obj == NULL) {
+        lv_mem_tag_set(tag_prev);
+        return NULL;
+    }
     lv_memset_00(obj, s);
     obj->class_p = class_p;
     obj->parent = parent;
@@ -57,6 +61,7 @@ lv_obj_t * lv_obj_class_create_obj(const lv_obj_class_t * class_p, lv_obj_t * pa
         if(!disp) {
             LV_LOG_WARN("No display created yet. No place to assign the new screen");
             lv_mem_free(obj);
+            lv_mem_tag_set(tag_prev);
             return NULL;
         }
 
@@ -98,6 +103,7 @@ lv_obj_t * lv_obj_class_create_obj(const lv_obj_class_t * class_p, lv_obj_t * pa
         }
     }
 
+    lv_mem_tag_set(tag_prev);
     return obj;
 }
 
@@ -187,7 +193,11 @@ static void lv_obj_construct(lv_obj_t * obj)
     /*Restore the original class*/
     obj->class_p = original_class_p;
 
-    if(obj->class_p->constructor_cb) obj->class_p->constructor_cb(obj->class_p, obj);
+    if(obj->class_p->constructor_cb) {
+        lv_mem_tag_t tag_prev = lv_mem_tag_set(LV_MEM_TAG_OBJ);
+        obj->class_p->constructor_cb(obj->class_p, obj);
+        lv_mem_tag_set(tag_prev);
+    }
 }
 
 static uint32_t get_instance_size(const lv_obj_class_t * class_p)
@@ -32,6 +32,9 @@ static void transform_point(const lv_obj_t * obj, lv_point_t * p, bool inv);
  *  STATIC VARIABLES
  **********************/
 static uint32_t layout_cnt;
+#if LV_OBJ_RENDER_CACHE_SIZE
+    static const lv_obj_t * moved_obj;  /*Invalidated by `_lv_obj_invalidate_moved()`*/
+#endif
 
 /**********************
  *      MACROS
@@ -740,7 +743,7 @@ void lv_obj_move_to(lv_obj_t * obj, lv_coord_t x, lv_coord_t y)
     if(diff.x == 0 && diff.y == 0) return;
 
     /*Invalidate the original area*/
-    lv_obj_invalidate(obj);
+    _lv_obj_invalidate_moved(obj);
 
     /*Save the original coordinates*/
     lv_area_t ori;
@@ -769,7 +772,7 @@ void lv_obj_move_to(lv_obj_t * obj, lv_coord_t x, lv_coord_t y)
     if(parent) lv_event_send(parent, LV_EVENT_CHILD_CHANGED, obj);
 
     /*Invalidate the new area*/
-    lv_obj_invalidate(obj);
+    _lv_obj_invalidate_moved(obj);
 
     /*If the object was out of the parent invalidate the new scrollbar area too.
      *If it wasn't out of the parent but out now, also invalidate the srollbars*/
@@ -838,6 +841,12 @@ void lv_obj_invalidate_area(const lv_obj_t * obj, const lv_area_t * area)
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
+#if LV_OBJ_RENDER_CACHE_SIZE
+    /*Even if the area is not visible now it will be in the cached image.
+     *A moved object's own image is still valid as it's drawn to the object's current position.*/
+    _lv_refr_render_cache_invalidate(obj == moved_obj ? lv_obj_get_parent(obj) : obj);
+#endif
+
     lv_disp_t * disp   = lv_obj_get_disp(obj);
     if(!lv_disp_is_invalidation_enabled(disp)) return;
 
@@ -848,6 +857,17 @@ void lv_obj_invalidate_area(const lv_obj_t * obj, const lv_area_t * area)
     _lv_inv_area(lv_obj_get_disp(obj),  &area_tmp);
 }
 
+void _lv_obj_invalidate_moved(const lv_obj_t * obj)
+{
+#if LV_OBJ_RENDER_CACHE_SIZE
+    moved_obj = obj;
+    lv_obj_invalidate(obj);
+    moved_obj = NULL;
+#else
+    lv_obj_invalidate(obj);
+#endif
+}
+
 void lv_obj_invalidate(const lv_obj_t * obj)
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
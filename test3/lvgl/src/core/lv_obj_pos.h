@@ -380,6 +380,13 @@ void lv_obj_invalidate_area(const struct _lv_obj_t * obj, const lv_area_t * area
  */
 void lv_obj_invalidate(const struct _lv_obj_t * obj);
 
+/**
+ * Mark the object as invalid like `lv_obj_invalidate()` when only its position changes.
+ * The object's cached image (see `LV_OBJ_FLAG_RENDER_CACHE`) stays valid, only its parents' are outdated.
+ * @param obj       pointer to an object
+ */
+void _lv_obj_invalidate_moved(const struct _lv_obj_t * obj);
+
 /**
  * Tell whether an area of an object is visible (even partially) now or not
  * @param obj       pointer to an object
@@ -11,6 +11,7 @@
 #include "lv_indev.h"
 #include "lv_disp.h"
 #include "lv_indev_scroll.h"
+#include "lv_refr.h"
 
 /*********************
  *      DEFINES
@@ -36,6 +37,10 @@ static void scroll_y_anim(void * obj, int32_t v);
 static void scroll_anim_ready_cb(lv_anim_t * a);
 static void scroll_area_into_view(const lv_area_t * area, lv_obj_t * child, lv_point_t * scroll_value,
                                   lv_anim_enable_t anim_en);
+#if LV_USE_SCROLL_COPY
+    static bool scroll_copy(lv_obj_t * obj, lv_coord_t x, lv_coord_t y);
+    static bool scroll_copy_inv_above(lv_obj_t * parent, uint32_t start_id, const lv_area_t * area);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -421,6 +426,9 @@ lv_res_t _lv_obj_scroll_by_raw(lv_obj_t * obj, lv_coord_t x, lv_coord_t y)
     lv_obj_move_children_by(obj, x, y, true);
     lv_res_t res = lv_event_send(obj, LV_EVENT_SCROLL, NULL);
     if(res != LV_RES_OK) return res;
+#if LV_USE_SCROLL_COPY
+    if(scroll_copy(obj, x, y)) return LV_RES_OK;
+#endif
     lv_obj_invalidate(obj);
     return LV_RES_OK;
 }
@@ -798,3 +806,152 @@ static void scroll_area_into_view(const lv_area_t * area, lv_obj_t * child, lv_p
     scroll_value->y += anim_en == LV_ANIM_OFF ? 0 : y_scroll;
     lv_obj_scroll_by(parent, x_scroll, y_scroll, anim_en);
 }
+
+#if LV_USE_SCROLL_COPY
+/**
+ * Move the already rendered content of a scrolled object in the frame buffer instead of redrawing it.
+ * Only the newly exposed parts, the edges and the scrollbars are invalidated.
+ * @param obj   pointer to an object which was just scrolled
+ * @param x     the horizontal scroll distance
+ * @param y     the vertical scroll distance
+ * @return      true: the necessary areas are invalidated; false: the object should be invalidated
+ */
+static bool scroll_copy(lv_obj_t * obj, lv_coord_t x, lv_coord_t y)
+{
+    lv_disp_t * disp = lv_obj_get_disp(obj);
+    if(!disp->driver->direct_mode) return false;
+    if(disp->prev_scr) return false;
+
+    /*The content moved by scrolling is drawn only by the children and clipped to the object*/
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_OVERFLOW_VISIBLE)) return false;
+    if(_lv_obj_has_draw_event_cb(obj)) return false;
+
+    /*Widgets can draw things which are not moved by scrolling*/
+    const lv_obj_class_t * class_p;
+    for(class_p = obj->class_p; class_p != &lv_obj_class; class_p = class_p->base_class) {
+        if(class_p == NULL || class_p->event_cb) return false;
+    }
+
+    uint32_t i;
+    uint32_t child_cnt = lv_obj_get_child_cnt(obj);
+    for(i = 0; i < child_cnt; i++) {
+        lv_obj_t * child = obj->spec_attr->children[i];
+        if(lv_obj_has_flag(child, LV_OBJ_FLAG_FLOATING) && !lv_obj_has_flag(child, LV_OBJ_FLAG_HIDDEN)) return false;
+    }
+
+    /*The children should be drawn on the same opaque color everywhere*/
+    if(lv_obj_get_style_bg_opa(obj, LV_PART_MAIN) < LV_OPA_MAX) return false;
+    if(lv_obj_get_style_bg_grad_dir(obj, LV_PART_MAIN) != LV_GRAD_DIR_NONE) return false;
+    if(lv_obj_get_style_bg_img_src(obj, LV_PART_MAIN)) return false;
+    if(lv_obj_get_style_opa_recursive(obj, LV_PART_MAIN) < LV_OPA_MAX) return false;
+    if(lv_obj_get_style_outline_width(obj, LV_PART_MAIN) && lv_obj_get_style_outline_pad(obj, LV_PART_MAIN) < 0) {
+        return false;
+    }
+
+    lv_obj_t * scr = lv_obj_get_screen(obj);
+    if(scr != disp->act_scr && scr != disp->top_layer && scr != disp->sys_layer) return false;
+
+    /*The rendered pixels can be moved only if they are drawn directly to the screen.
+     *There are no transformations so the visible part is simply clipped by the parents.*/
+    lv_area_t clip_area;
+    lv_area_copy(&clip_area, &obj->coords);
+    lv_obj_t * parent;
+    for(parent = obj; parent; parent = lv_obj_get_parent(parent)) {
+        if(lv_obj_has_flag(parent, LV_OBJ_FLAG_HIDDEN)) return false;
+        if(_lv_obj_get_layer_type(parent) != LV_LAYER_TYPE_NONE) return false;
+        if(lv_obj_has_flag(parent, LV_OBJ_FLAG_RENDER_CACHE)) return false;
+        if(parent != obj && lv_obj_get_style_clip_corner(parent, LV_PART_MAIN)) return false;
+        if(parent != obj && !lv_obj_has_flag(parent, LV_OBJ_FLAG_OVERFLOW_VISIBLE)) {
+            if(!_lv_area_intersect(&clip_area, &clip_area, &parent->coords)) return false;
+        }
+    }
+
+    /*Move only the inner part which is not affected by the border and the rounded corners (or corner clipping).
+     *The corners are cut from the shorter sides to keep the edges to redraw small.*/
+    lv_coord_t w = lv_obj_get_width(obj);
+    lv_coord_t h = lv_obj_get_height(obj);
+    lv_coord_t border = lv_obj_get_style_border_width(obj, LV_PART_MAIN);
+    lv_coord_t radius = lv_obj_get_style_radius(obj, LV_PART_MAIN);
+    radius = LV_MAX(LV_MIN3(radius, w / 2, h / 2), border);
+
+    lv_area_t area;
+    lv_area_copy(&area, &obj->coords);
+    if(w < h) lv_area_increase(&area, -border, -radius);
+    else lv_area_increase(&area, -radius, -border);
+    if(lv_area_get_width(&area) <= 0 || lv_area_get_height(&area) <= 0) return false;
+    if(!_lv_area_intersect(&area, &area, &clip_area)) return false;
+
+    /*Redraw the objects above the area. They are invalidated before moving so they are redrawn on the moved position too*/
+    for(parent = obj; lv_obj_get_parent(parent); parent = lv_obj_get_parent(parent)) {
+        if(!scroll_copy_inv_above(lv_obj_get_parent(parent), lv_obj_get_index(parent) + 1, &area)) return false;
+    }
+
+    if(parent != disp->top_layer && parent != disp->sys_layer) {
+        if(!scroll_copy_inv_above(disp->top_layer, 0, &area)) return false;
+    }
+    if(parent != disp->sys_layer) {
+        if(!scroll_copy_inv_above(disp->sys_layer, 0, &area)) return false;
+    }
+
+    /*The scrollbars are not moved with the content, so redraw their whole track*/
+    lv_area_t hor_area;
+    lv_area_t ver_area;
+    lv_obj_get_scrollbar_area(obj, &hor_area, &ver_area);
+    if(lv_area_get_size(&hor_area) > 0) {
+        hor_area.x1 = area.x1;
+        hor_area.x2 = area.x2;
+        if(_lv_area_intersect(&hor_area, &hor_area, &area)) _lv_inv_area(disp, &hor_area);
+    }
+    if(lv_area_get_size(&ver_area) > 0) {
+        ver_area.y1 = area.y1;
+        ver_area.y2 = area.y2;
+        if(_lv_area_intersect(&ver_area, &ver_area, &area)) _lv_inv_area(disp, &ver_area);
+    }
+
+    if(!_lv_inv_area_scroll(disp, &area, x, y)) return false;
+
+    /*The children are drawn on the border and the rounded corners too*/
+    lv_area_t edges[4];
+    int8_t edge_cnt = _lv_area_diff(edges, &clip_area, &area);
+    int8_t j;
+    for(j = 0; j < edge_cnt; j++) {
+        _lv_inv_area(disp, &edges[j]);
+    }
+
+    return true;
+}
+
+/**
+ * Invalidate the parts of the children of an object which are drawn on an area
+ * @param parent    pointer to an object whose children should be checked
+ * @param start_id  check only the children from this index (the older children are drawn earlier)
+ * @param area      the area to check
+ * @return          false: a child might draw anywhere so the whole area needs to be redrawn
+ */
+static bool scroll_copy_inv_above(lv_obj_t * parent, uint32_t start_id, const lv_area_t * area)
+{
+    /*The top and system layers can have a background too*/
+    if(start_id == 0 && lv_obj_get_style_bg_opa(parent, LV_PART_MAIN) > LV_OPA_MIN) {
+        lv_area_t com;
+        if(_lv_area_intersect(&com, &parent->coords, area)) return false;
+    }
+
+    lv_disp_t * disp = lv_obj_get_disp(parent);
+    uint32_t i;
+    uint32_t child_cnt = lv_obj_get_child_cnt(parent);
+    for(i = start_id; i < child_cnt; i++) {
+        lv_obj_t * child = parent->spec_attr->children[i];
+        if(lv_obj_has_flag(child, LV_OBJ_FLAG_HIDDEN)) continue;
+        if(lv_obj_has_flag(child, LV_OBJ_FLAG_OVERFLOW_VISIBLE)) return false;
+
+        lv_area_t child_area;
+        lv_coord_t ext_size = _lv_obj_get_ext_draw_size(child);
+        lv_area_copy(&child_area, &child->coords);
+        lv_area_increase(&child_area, ext_size, ext_size);
+        lv_obj_get_transformed_area(child, &child_area, false, false);
+        if(_lv_area_intersect(&child_area, &child_area, area)) _lv_inv_area(disp, &child_area);
+    }
+
+    return true;
+}
+#endif
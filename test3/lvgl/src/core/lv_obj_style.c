@@ -15,6 +15,8 @@
  *********************/
 #define MY_CLASS &lv_obj_class
 
+#define STYLE_CACHE_SLOT_CNT 46
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -27,6 +29,16 @@ typedef struct {
     lv_style_value_t end_value;
 } trans_t;
 
+#if LV_OBJ_STYLE_CACHE
+/*The resolved style values of a part of an object*/
+typedef struct _lv_obj_style_cache_t {
+    struct _lv_obj_style_cache_t * next;
+    lv_part_t part;
+    uint32_t valid[(STYLE_CACHE_SLOT_CNT + 31) / 32];   /*A bit for each slot of `values`*/
+    lv_style_value_t values[STYLE_CACHE_SLOT_CNT];
+} _lv_obj_style_cache_t;
+#endif
+
 typedef enum {
     CACHE_ZERO = 0,
     CACHE_TRUE = 1,
@@ -54,12 +66,67 @@ static void trans_anim_ready_cb(lv_anim_t * a);
 static lv_layer_type_t calculate_layer_type(lv_obj_t * obj);
 static void fade_anim_cb(void * obj, int32_t v);
 static void fade_in_anim_ready(lv_anim_t * a);
+#if LV_OBJ_STYLE_CACHE
+static _lv_obj_style_cache_t * style_cache_get(lv_obj_t * obj, lv_part_t part);
+#endif
 
 /**********************
  *  STATIC VARIABLES
  **********************/
 static bool style_refr = true;
 
+#if LV_OBJ_STYLE_CACHE
+/*The index + 1 of the cached properties in `_lv_obj_style_cache_t`'s `values`. 0: not cached*/
+static const uint8_t style_cache_slots[_LV_STYLE_NUM_BUILT_IN_PROPS] = {
+    [LV_STYLE_RADIUS] =                 1,
+    [LV_STYLE_PAD_TOP] =                2,
+    [LV_STYLE_PAD_BOTTOM] =             3,
+    [LV_STYLE_PAD_LEFT] =               4,
+    [LV_STYLE_PAD_RIGHT] =              5,
+    [LV_STYLE_PAD_ROW] =                6,
+    [LV_STYLE_PAD_COLUMN] =             7,
+    [LV_STYLE_BG_COLOR] =               8,
+    [LV_STYLE_BG_OPA] =                 9,
+    [LV_STYLE_BG_GRAD_COLOR] =          10,
+    [LV_STYLE_BG_GRAD_DIR] =            11,
+    [LV_STYLE_BG_MAIN_STOP] =           12,
+    [LV_STYLE_BG_GRAD_STOP] =           13,
+    [LV_STYLE_BG_GRAD] =                14,
+    [LV_STYLE_BG_DITHER_MODE] =         15,
+    [LV_STYLE_BG_IMG_SRC] =             16,
+    [LV_STYLE_BG_IMG_OPA] =             17,
+    [LV_STYLE_BG_IMG_RECOLOR] =         18,
+    [LV_STYLE_BG_IMG_RECOLOR_OPA] =     19,
+    [LV_STYLE_BG_IMG_TILED] =           20,
+    [LV_STYLE_BORDER_COLOR] =           21,
+    [LV_STYLE_BORDER_OPA] =             22,
+    [LV_STYLE_BORDER_WIDTH] =           23,
+    [LV_STYLE_BORDER_SIDE] =            24,
+    [LV_STYLE_BORDER_POST] =            25,
+    [LV_STYLE_OUTLINE_WIDTH] =          26,
+    [LV_STYLE_OUTLINE_COLOR] =          27,
+    [LV_STYLE_OUTLINE_OPA] =            28,
+    [LV_STYLE_OUTLINE_PAD] =            29,
+    [LV_STYLE_SHADOW_WIDTH] =           30,
+    [LV_STYLE_SHADOW_OFS_X] =           31,
+    [LV_STYLE_SHADOW_OFS_Y] =           32,
+    [LV_STYLE_SHADOW_SPREAD] =          33,
+    [LV_STYLE_SHADOW_COLOR] =           34,
+    [LV_STYLE_SHADOW_OPA] =             35,
+    [LV_STYLE_TEXT_COLOR] =             36,
+    [LV_STYLE_TEXT_OPA] =               37,
+    [LV_STYLE_TEXT_FONT] =              38,
+    [LV_STYLE_TEXT_LETTER_SPACE] =      39,
+    [LV_STYLE_TEXT_LINE_SPACE] =        40,
+    [LV_STYLE_TEXT_DECOR] =             41,
+    [LV_STYLE_TEXT_ALIGN] =             42,
+    [LV_STYLE_OPA] =                    43,
+    [LV_STYLE_COLOR_FILTER_DSC] =       44,
+    [LV_STYLE_COLOR_FILTER_OPA] =       45,
+    [LV_STYLE_BLEND_MODE] =             46,
+};
+#endif
+
 /**********************
  *      MACROS
  **********************/
@@ -89,7 +156,9 @@ void lv_obj_add_style(lv_obj_t * obj, lv_style_t * style, lv_style_selector_t se
 
     /*Allocate space for the new style and shift the rest of the style to the end*/
     obj->style_cnt++;
+    lv_mem_tag_t tag_prev = lv_mem_tag_set(LV_MEM_TAG_STYLE);
     obj->styles = lv_mem_realloc(obj->styles, obj->style_cnt * sizeof(_lv_obj_style_t));
+    lv_mem_tag_set(tag_prev);
 
     uint32_t j;
     for(j = obj->style_cnt - 1; j > i ; j--) {
@@ -152,7 +221,10 @@ void lv_obj_remove_style(lv_obj_t * obj, lv_style_t * style, lv_style_selector_t
 
 void lv_obj_report_style_change(lv_style_t * style)
 {
+    /*With the style cache visit the objects anyway to drop their cached values*/
+#if LV_OBJ_STYLE_CACHE == 0
     if(!style_refr) return;
+#endif
     lv_disp_t * d = lv_disp_get_next(NULL);
 
     while(d) {
@@ -168,12 +240,22 @@ void lv_obj_refresh_style(lv_obj_t * obj, lv_style_selector_t selector, lv_style
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
-    if(!style_refr) return;
+#if LV_OBJ_STYLE_CACHE
+    /*Drop the cached values even if refreshing is disabled. The children might inherit the changed property.*/
+    bool cache_recursive = prop == LV_STYLE_PROP_ANY || lv_style_prop_has_flag(prop, LV_STYLE_PROP_INHERIT);
+    _lv_obj_style_cache_invalidate(obj, cache_recursive);
+#endif
 
-    lv_obj_invalidate(obj);
+    if(!style_refr) return;
 
     lv_part_t part = lv_obj_style_get_selector_part(selector);
 
+    /*The position properties move the object without changing how it looks*/
+    bool is_pos_only = prop == LV_STYLE_X || prop == LV_STYLE_Y || prop == LV_STYLE_ALIGN ||
+                       prop == LV_STYLE_TRANSLATE_X || prop == LV_STYLE_TRANSLATE_Y;
+    if(is_pos_only) _lv_obj_invalidate_moved(obj);
+    else lv_obj_invalidate(obj);
+
     bool is_layout_refr = lv_style_prop_has_flag(prop, LV_STYLE_PROP_LAYOUT_REFR);
     bool is_ext_draw = lv_style_prop_has_flag(prop, LV_STYLE_PROP_EXT_DRAW);
     bool is_inheritable = lv_style_prop_has_flag(prop, LV_STYLE_PROP_INHERIT);
@@ -206,7 +288,8 @@ void lv_obj_refresh_style(lv_obj_t * obj, lv_style_selector_t selector, lv_style
     if(prop == LV_STYLE_PROP_ANY || is_ext_draw) {
         lv_obj_refresh_ext_draw_size(obj);
     }
-    lv_obj_invalidate(obj);
+    if(is_pos_only) _lv_obj_invalidate_moved(obj);
+    else lv_obj_invalidate(obj);
 
     if(prop == LV_STYLE_PROP_ANY || (is_inheritable && (is_ext_draw || is_layout_refr))) {
         if(part != LV_PART_SCROLLBAR) {
@@ -222,6 +305,19 @@ void lv_obj_enable_style_refresh(bool en)
 
 lv_style_value_t lv_obj_get_style_prop(const lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop)
 {
+#if LV_OBJ_STYLE_CACHE
+    /*With `skip_trans` the object is queried in a temporary state (e.g. for a transition or a button of a matrix)
+     *so don't use the cached values*/
+    _lv_obj_style_cache_t * cache = NULL;
+    uint32_t slot = 0;
+    if(prop < _LV_STYLE_NUM_BUILT_IN_PROPS && !obj->skip_trans) slot = style_cache_slots[prop];
+    if(slot) {
+        slot--;
+        cache = style_cache_get((lv_obj_t *)obj, part);
+        if(cache && (cache->valid[slot >> 5] & (1UL << (slot & 0x1F)))) return cache->values[slot];
+    }
+#endif
+
     lv_style_value_t value_act;
     bool inheritable = lv_style_prop_has_flag(prop, LV_STYLE_PROP_INHERIT);
     lv_style_res_t found = LV_STYLE_RES_NOT_FOUND;
@@ -264,6 +360,14 @@ lv_style_value_t lv_obj_get_style_prop(const lv_obj_t * obj, lv_part_t part, lv_
             value_act = lv_style_prop_get_default(prop);
         }
     }
+
+#if LV_OBJ_STYLE_CACHE
+    if(cache) {
+        cache->values[slot] = value_act;
+        cache->valid[slot >> 5] |= 1UL << (slot & 0x1F);
+    }
+#endif
+
     return value_act;
 }
 
@@ -352,7 +456,9 @@ void _lv_obj_style_create_transition(lv_obj_t * obj, lv_part_t part, lv_state_t
         }
     }
 
+    lv_mem_tag_t tag_prev = lv_mem_tag_set(LV_MEM_TAG_STYLE);
     tr = _lv_ll_ins_head(&LV_GC_ROOT(_lv_obj_style_trans_ll));
+    lv_mem_tag_set(tag_prev);
     LV_ASSERT_MALLOC(tr);
     if(tr == NULL) return;
     tr->start_value = v1;
@@ -477,6 +583,35 @@ void lv_obj_fade_out(lv_obj_t * obj, uint32_t time, uint32_t delay)
     lv_anim_start(&a);
 }
 
+#if LV_OBJ_STYLE_CACHE
+void _lv_obj_style_cache_invalidate(lv_obj_t * obj, bool recursive)
+{
+    _lv_obj_style_cache_t * cache;
+    for(cache = obj->style_cache; cache; cache = cache->next) {
+        lv_memset_00(cache->valid, sizeof(cache->valid));
+    }
+
+    if(!recursive) return;
+
+    uint32_t i;
+    uint32_t child_cnt = lv_obj_get_child_cnt(obj);
+    for(i = 0; i < child_cnt; i++) {
+        _lv_obj_style_cache_invalidate(obj->spec_attr->children[i], true);
+    }
+}
+
+void _lv_obj_style_cache_free(lv_obj_t * obj)
+{
+    _lv_obj_style_cache_t * cache = obj->style_cache;
+    while(cache) {
+        _lv_obj_style_cache_t * next = cache->next;
+        lv_mem_free(cache);
+        cache = next;
+    }
+    obj->style_cache = NULL;
+}
+#endif
+
 lv_state_t lv_obj_style_get_selector_state(lv_style_selector_t selector)
 {
     return selector & 0xFFFF;
@@ -552,6 +687,7 @@ static lv_style_t * get_local_style(lv_obj_t * obj, lv_style_selector_t selector
     }
 
     obj->style_cnt++;
+    lv_mem_tag_t tag_prev = lv_mem_tag_set(LV_MEM_TAG_STYLE);
     obj->styles = lv_mem_realloc(obj->styles, obj->style_cnt * sizeof(_lv_obj_style_t));
     LV_ASSERT_MALLOC(obj->styles);
 
@@ -564,6 +700,7 @@ static lv_style_t * get_local_style(lv_obj_t * obj, lv_style_selector_t selector
 
     lv_memset_00(&obj->styles[i], sizeof(_lv_obj_style_t));
     obj->styles[i].style = lv_mem_alloc(sizeof(lv_style_t));
+    lv_mem_tag_set(tag_prev);
     lv_style_init(obj->styles[i].style);
     obj->styles[i].is_local = 1;
     obj->styles[i].selector = selector;
@@ -588,6 +725,7 @@ static _lv_obj_style_t * get_trans_style(lv_obj_t * obj,  lv_style_selector_t se
     if(i != obj->style_cnt) return &obj->styles[i];
 
     obj->style_cnt++;
+    lv_mem_tag_t tag_prev = lv_mem_tag_set(LV_MEM_TAG_STYLE);
     obj->styles = lv_mem_realloc(obj->styles, obj->style_cnt * sizeof(_lv_obj_style_t));
 
     for(i = obj->style_cnt - 1; i > 0 ; i--) {
@@ -596,6 +734,7 @@ static _lv_obj_style_t * get_trans_style(lv_obj_t * obj,  lv_style_selector_t se
 
     lv_memset_00(&obj->styles[0], sizeof(_lv_obj_style_t));
     obj->styles[0].style = lv_mem_alloc(sizeof(lv_style_t));
+    lv_mem_tag_set(tag_prev);
     lv_style_init(obj->styles[0].style);
     obj->styles[0].is_trans = 1;
     obj->styles[0].selector = selector;
@@ -836,6 +975,10 @@ static void trans_anim_start_cb(lv_anim_t * a)
     _lv_obj_style_t * style_trans = get_trans_style(tr->obj, tr->selector);
     lv_style_set_prop(style_trans->style, tr->prop, tr->start_value);   /*Be sure `trans_style` has a valid value*/
 
+#if LV_OBJ_STYLE_CACHE
+    _lv_obj_style_cache_invalidate(tr->obj, lv_style_prop_has_flag(tr->prop, LV_STYLE_PROP_INHERIT));
+#endif
+
 }
 
 static void trans_anim_ready_cb(lv_anim_t * a)
@@ -865,6 +1008,9 @@ static void trans_anim_ready_cb(lv_anim_t * a)
 
                 _lv_obj_style_t * obj_style = &obj->styles[i];
                 lv_style_remove_prop(obj_style->style, prop);
+#if LV_OBJ_STYLE_CACHE
+                _lv_obj_style_cache_invalidate(obj, lv_style_prop_has_flag(prop, LV_STYLE_PROP_INHERIT));
+#endif
 
                 if(lv_style_is_empty(obj->styles[i].style)) {
                     lv_obj_remove_style(obj, obj_style->style, obj_style->selector);
@@ -887,6 +1033,33 @@ static lv_layer_type_t calculate_layer_type(lv_obj_t * obj)
     return LV_LAYER_TYPE_NONE;
 }
 
+#if LV_OBJ_STYLE_CACHE
+/**
+ * Get the style cache of an object's part. Allocate it if the part has no cache yet.
+ * @param obj   pointer to an object
+ * @param part  a part of the object
+ * @return      pointer to the cache or NULL if it couldn't be allocated
+ */
+static _lv_obj_style_cache_t * style_cache_get(lv_obj_t * obj, lv_part_t part)
+{
+    _lv_obj_style_cache_t * cache;
+    for(cache = obj->style_cache; cache; cache = cache->next) {
+        if(cache->part == part) return cache;
+    }
+
+    lv_mem_tag_t tag_prev = lv_mem_tag_set(LV_MEM_TAG_STYLE);
+    cache = lv_mem_alloc(sizeof(_lv_obj_style_cache_t));
+    lv_mem_tag_set(tag_prev);
+    if(cache == NULL) return NULL;
+
+    lv_memset_00(cache->valid, sizeof(cache->valid));
+    cache->part = part;
+    cache->next = obj->style_cache;
+    obj->style_cache = cache;
+    return cache;
+}
+#endif
+
 static void fade_anim_cb(void * obj, int32_t v)
 {
     lv_obj_set_style_opa(obj, v, 0);
@@ -180,6 +180,21 @@ void _lv_obj_style_create_transition(struct _lv_obj_t * obj, lv_part_t part, lv_
  */
 _lv_style_state_cmp_t _lv_obj_style_state_compare(struct _lv_obj_t * obj, lv_state_t state1, lv_state_t state2);
 
+#if LV_OBJ_STYLE_CACHE
+/**
+ * Used internally to drop the cached style values of an object, e.g. because its state has changed
+ * @param obj       pointer to an object
+ * @param recursive true: drop the cached values of the children too as they can inherit from `obj`
+ */
+void _lv_obj_style_cache_invalidate(struct _lv_obj_t * obj, bool recursive);
+
+/**
+ * Used internally to free the style cache of an object when it's deleted
+ * @param obj       pointer to an object
+ */
+void _lv_obj_style_cache_free(struct _lv_obj_t * obj);
+#endif
+
 /**
  * Fade in an an object and all its children.
  * @param obj       the object to fade in
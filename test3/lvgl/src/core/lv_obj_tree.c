@@ -172,6 +172,11 @@ void lv_obj_set_parent(lv_obj_t * obj, lv_obj_t * parent)
 
     obj->parent = parent;
 
+#if LV_OBJ_STYLE_CACHE
+    /*The inherited values come from the new parent*/
+    _lv_obj_style_cache_invalidate(obj, true);
+#endif
+
     /*Notify the original parent because one of its children is lost*/
     lv_obj_readjust_scroll(old_parent, LV_ANIM_OFF);
     lv_obj_scrollbar_invalidate(old_parent);
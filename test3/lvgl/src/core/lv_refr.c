@@ -7,6 +7,7 @@
  *      INCLUDES
  *********************/
 #include <stddef.h>
+#include <string.h>
 #include "lv_refr.h"
 #include "lv_disp.h"
 #include "../hal/lv_hal_tick.h"
@@ -48,14 +49,26 @@ typedef struct {
 #endif
 } mem_monitor_t;
 
+#if LV_OBJ_RENDER_CACHE_SIZE
+typedef struct _lv_obj_render_cache_t {
+    lv_img_dsc_t img;           /*The object rendered with its children. `img.data` is NULL if not allocated*/
+    uint8_t valid : 1;          /*The image is up to date*/
+    uint8_t rendering : 1;      /*The object is being rendered into the image now*/
+} _lv_obj_render_cache_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static void lv_refr_join_area(void);
 static void refr_invalid_areas(void);
 static void refr_sync_areas(void);
+#if LV_USE_SCROLL_COPY
+    static void refr_scroll_copy(void);
+#endif
 static void refr_area(const lv_area_t * area_p);
 static void refr_area_part(lv_draw_ctx_t * draw_ctx);
+static void refr_area_content(lv_draw_ctx_t * draw_ctx);
 static lv_obj_t * lv_refr_get_top_obj(const lv_area_t * area_p, lv_obj_t * obj);
 static void refr_obj_and_children(lv_draw_ctx_t * draw_ctx, lv_obj_t * top_obj);
 static void refr_obj(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj);
@@ -63,6 +76,12 @@ static uint32_t get_max_row(lv_disp_t * disp, lv_coord_t area_w, lv_coord_t area
 static void draw_buf_flush(lv_disp_t * disp);
 static void call_flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p);
 
+#if LV_OBJ_RENDER_CACHE_SIZE
+    static bool render_cache_draw(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj);
+    static bool render_cache_build(lv_obj_t * obj, _lv_obj_render_cache_t * cache, const lv_area_t * area);
+    static void render_cache_free_buf(_lv_obj_render_cache_t * cache);
+#endif
+
 #if LV_USE_PERF_MONITOR
     static void perf_monitor_init(perf_monitor_t * perf_monitor);
 #endif
@@ -84,6 +103,14 @@ static lv_disp_t * disp_refr; /*Display being refreshed*/
     static mem_monitor_t    mem_monitor;
 #endif
 
+#if LV_OBJ_RENDER_CACHE_SIZE
+    static lv_refr_render_cache_stat_t render_cache_stat;
+#endif
+
+#if LV_DRAW_LIST_SIZE
+    static bool draw_list_replay; /*Replay the recorded draw list in the bands instead of drawing the objects*/
+#endif
+
 /**********************
  *      MACROS
  **********************/
@@ -129,6 +156,11 @@ void lv_refr_now(lv_disp_t * disp)
 
 void lv_obj_redraw(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj)
 {
+#if LV_OBJ_RENDER_CACHE_SIZE
+    /*Draw the object and its children from the cached image if possible*/
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_RENDER_CACHE) && render_cache_draw(draw_ctx, obj)) return;
+#endif
+
     const lv_area_t * clip_area_ori = draw_ctx->clip_area;
     lv_area_t clip_coords_for_obj;
 
@@ -217,6 +249,9 @@ void _lv_inv_area(lv_disp_t * disp, const lv_area_t * area_p)
     /*Clear the invalidate buffer if the parameter is NULL*/
     if(area_p == NULL) {
         disp->inv_p = 0;
+#if LV_USE_SCROLL_COPY
+        disp->scroll_copy_pending = 0;
+#endif
         return;
     }
 
@@ -260,6 +295,72 @@ void _lv_inv_area(lv_disp_t * disp, const lv_area_t * area_p)
     if(disp->refr_timer) lv_timer_resume(disp->refr_timer);
 }
 
+#if LV_USE_SCROLL_COPY
+bool _lv_inv_area_scroll(lv_disp_t * disp, const lv_area_t * area, lv_coord_t dx, lv_coord_t dy)
+{
+    if(!disp) disp = lv_disp_get_default();
+    if(!disp) return false;
+    if(!lv_disp_is_invalidation_enabled(disp)) return false;
+    if(disp->rendering_in_progress) return false;
+
+    /*Only in direct mode the frame buffer has the content of the previous frame on the same coordinates*/
+    lv_disp_drv_t * driver = disp->driver;
+    if(!driver->direct_mode || driver->full_refresh) return false;
+    if(driver->rotated != LV_DISP_ROT_NONE || driver->set_px_cb) return false;
+#if LV_COLOR_SCREEN_TRANSP
+    if(driver->screen_transp) return false;
+#endif
+
+    lv_area_t scr_area;
+    lv_area_set(&scr_area, 0, 0, lv_disp_get_hor_res(disp) - 1, lv_disp_get_ver_res(disp) - 1);
+    if(!_lv_area_is_in(area, &scr_area, 0)) return false;
+
+    /*Only one area can be moved. Moving the same area again just adds the distances*/
+    if(disp->scroll_copy_pending && !_lv_area_is_equal(area, &disp->scroll_copy_area)) return false;
+
+    /*Nothing remains from the original content*/
+    lv_area_t moved;
+    lv_area_t exposed[4];
+    lv_area_copy(&moved, area);
+    lv_area_move(&moved, dx, dy);
+    int8_t exposed_cnt = _lv_area_diff(exposed, area, &moved);
+    if(exposed_cnt < 0) return false;
+
+    /*Nothing to save if the whole area will be redrawn anyway*/
+    uint16_t inv_p = disp->inv_p;
+    uint16_t i;
+    for(i = 0; i < inv_p; i++) {
+        if(_lv_area_is_in(area, &disp->inv_areas[i], 0)) return false;
+    }
+
+    /*The not yet redrawn parts are moved too, so redraw them on their new position too*/
+    for(i = 0; i < inv_p; i++) {
+        lv_area_copy(&moved, &disp->inv_areas[i]);
+        lv_area_move(&moved, dx, dy);
+        if(_lv_area_intersect(&moved, &moved, area)) _lv_inv_area(disp, &moved);
+    }
+
+    int8_t j;
+    for(j = 0; j < exposed_cnt; j++) {
+        _lv_inv_area(disp, &exposed[j]);
+    }
+
+    if(disp->scroll_copy_pending) {
+        disp->scroll_copy_diff.x += dx;
+        disp->scroll_copy_diff.y += dy;
+    }
+    else {
+        lv_area_copy(&disp->scroll_copy_area, area);
+        disp->scroll_copy_diff.x = dx;
+        disp->scroll_copy_diff.y = dy;
+        disp->scroll_copy_pending = 1;
+    }
+
+    if(disp->refr_timer) lv_timer_resume(disp->refr_timer);
+    return true;
+}
+#endif
+
 /**
  * Get the display which is being refreshed
  * @return the display being refreshed
@@ -305,6 +406,11 @@ void _lv_disp_refr_timer(lv_timer_t * tmr)
         disp_refr = lv_disp_get_default();
     }
 
+#if LV_ANIM_REFR_SYNC
+    /*Step the animations to the time when this frame is expected to be shown*/
+    _lv_anim_refr_sync(start + disp_refr->refr_time_avg);
+#endif
+
     /*Refresh the screen's layout if required*/
     lv_obj_update_layout(disp_refr->act_scr);
     if(disp_refr->prev_scr) lv_obj_update_layout(disp_refr->prev_scr);
@@ -322,6 +428,9 @@ void _lv_disp_refr_timer(lv_timer_t * tmr)
 
     lv_refr_join_area();
     refr_sync_areas();
+#if LV_USE_SCROLL_COPY
+    refr_scroll_copy();
+#endif
     refr_invalid_areas();
 
     /*If refresh happened ...*/
@@ -346,6 +455,9 @@ void _lv_disp_refr_timer(lv_timer_t * tmr)
         disp_refr->inv_p = 0;
 
         elaps = lv_tick_elaps(start);
+#if LV_ANIM_REFR_SYNC
+        disp_refr->refr_time_avg = (disp_refr->refr_time_avg * 3 + elaps) / 4;
+#endif
 
         /*Call monitor cb if present*/
         if(disp_refr->driver->monitor_cb) {
@@ -467,6 +579,41 @@ uint32_t lv_refr_get_fps_avg(void)
 }
 #endif
 
+#if LV_OBJ_RENDER_CACHE_SIZE
+void lv_refr_get_render_cache_stat(lv_refr_render_cache_stat_t * stat)
+{
+    LV_ASSERT_NULL(stat);
+    *stat = render_cache_stat;
+}
+
+void lv_refr_reset_render_cache_stat(void)
+{
+    render_cache_stat.hit_cnt = 0;
+    render_cache_stat.build_cnt = 0;
+    render_cache_stat.skip_cnt = 0;
+}
+
+void _lv_refr_render_cache_invalidate(const lv_obj_t * obj)
+{
+    /*The change is visible in the cached images of all the parents too*/
+    while(obj) {
+        if(obj->spec_attr && obj->spec_attr->render_cache) {
+            obj->spec_attr->render_cache->valid = 0;
+        }
+        obj = obj->parent;
+    }
+}
+
+void _lv_refr_render_cache_free(lv_obj_t * obj)
+{
+    if(obj->spec_attr == NULL || obj->spec_attr->render_cache == NULL) return;
+
+    render_cache_free_buf(obj->spec_attr->render_cache);
+    lv_mem_free(obj->spec_attr->render_cache);
+    obj->spec_attr->render_cache = NULL;
+}
+#endif
+
 
 /**********************
  *   STATIC FUNCTIONS
@@ -581,6 +728,61 @@ static void refr_sync_areas(void)
     _lv_ll_clear(&disp_refr->sync_areas);
 }
 
+#if LV_USE_SCROLL_COPY
+/**
+ * Move the content of the frame buffer registered by `_lv_inv_area_scroll`
+ */
+static void refr_scroll_copy(void)
+{
+    if(!disp_refr->scroll_copy_pending) return;
+    disp_refr->scroll_copy_pending = 0;
+
+    lv_disp_drv_t * driver = disp_refr->driver;
+    if(!driver->direct_mode || driver->full_refresh) return;
+
+    /*The part of the area which still shows content from the area after moving*/
+    lv_coord_t dx = disp_refr->scroll_copy_diff.x;
+    lv_coord_t dy = disp_refr->scroll_copy_diff.y;
+    lv_area_t dest;
+    lv_area_copy(&dest, &disp_refr->scroll_copy_area);
+    lv_area_move(&dest, dx, dy);
+    if(!_lv_area_intersect(&dest, &dest, &disp_refr->scroll_copy_area)) return;
+
+    /*The buffer can be modified only when it's not used by the GPU or by the driver*/
+    if(driver->draw_ctx->wait_for_finish) driver->draw_ctx->wait_for_finish(driver->draw_ctx);
+    lv_disp_draw_buf_t * draw_buf = driver->draw_buf;
+    while(draw_buf->flushing) {
+        if(driver->wait_cb) driver->wait_cb(driver);
+    }
+
+    /*In double buffered mode the on screen buffer has the previous frame.
+     *The off screen buffer is not synced on the areas which will be redrawn, so don't use it as source.*/
+    lv_color_t * dest_buf = draw_buf->buf_act;
+    lv_color_t * src_buf = dest_buf;
+    if(draw_buf->buf2) src_buf = draw_buf->buf_act == draw_buf->buf1 ? draw_buf->buf2 : draw_buf->buf1;
+
+    /*Go against the direction of moving to read every line before it's overwritten*/
+    lv_coord_t stride = lv_disp_get_hor_res(disp_refr);
+    size_t line_size = lv_area_get_width(&dest) * sizeof(lv_color_t);
+    lv_coord_t y = dy > 0 ? dest.y2 : dest.y1;
+    lv_coord_t y_step = dy > 0 ? -1 : 1;
+    lv_coord_t line_cnt = lv_area_get_height(&dest);
+    lv_coord_t i;
+    for(i = 0; i < line_cnt; i++) {
+        lv_color_t * dest_p = dest_buf + (int32_t)stride * y + dest.x1;
+        lv_color_t * src_p = src_buf + (int32_t)stride * (y - dy) + (dest.x1 - dx);
+        memmove(dest_p, src_p, line_size);
+        y += y_step;
+    }
+
+    /*The other buffer needs the moved content too*/
+    if(draw_buf->buf2) {
+        lv_area_t * sync_area = _lv_ll_ins_tail(&disp_refr->sync_areas);
+        if(sync_area) lv_area_copy(sync_area, &dest);
+    }
+}
+#endif
+
 /**
  * Refresh the joined areas
  */
@@ -662,6 +864,19 @@ static void refr_area(const lv_area_t * area_p)
 
     int32_t max_row = get_max_row(disp_refr, w, h);
 
+#if LV_DRAW_LIST_SIZE
+    /*If the area is drawn in more bands record the draw operations once and replay them in each band*/
+    lv_area_t rec_area = *area_p;
+    rec_area.y2 = y2;
+    if(max_row > 0 && lv_area_get_height(&rec_area) > max_row) {
+        draw_ctx->buf_area = &rec_area;
+        draw_ctx->clip_area = &rec_area;
+        _lv_draw_list_start(draw_ctx, disp_refr);
+        refr_area_content(draw_ctx);
+        draw_list_replay = _lv_draw_list_finish();
+    }
+#endif
+
     lv_coord_t row;
     lv_coord_t row_last = 0;
     lv_area_t sub_area;
@@ -693,6 +908,10 @@ static void refr_area(const lv_area_t * area_p)
         disp_refr->driver->draw_buf->last_part = 1;
         refr_area_part(draw_ctx);
     }
+
+#if LV_DRAW_LIST_SIZE
+    draw_list_replay = false;
+#endif
 }
 
 static void refr_area_part(lv_draw_ctx_t * draw_ctx)
@@ -725,6 +944,22 @@ static void refr_area_part(lv_draw_ctx_t * draw_ctx)
 #endif
     }
 
+#if LV_DRAW_LIST_SIZE
+    if(draw_list_replay) _lv_draw_list_replay(draw_ctx);
+    else refr_area_content(draw_ctx);
+#else
+    refr_area_content(draw_ctx);
+#endif
+
+    draw_buf_flush(disp_refr);
+}
+
+/**
+ * Draw the screens and the layers of `disp_refr` on the current area of the draw context
+ * @param draw_ctx  pointer to the draw context
+ */
+static void refr_area_content(lv_draw_ctx_t * draw_ctx)
+{
     lv_obj_t * top_act_scr = NULL;
     lv_obj_t * top_prev_scr = NULL;
 
@@ -746,7 +981,12 @@ static void refr_area_part(lv_draw_ctx_t * draw_ctx)
             dsc.bg_img_opa = disp_refr->bg_opa;
             dsc.bg_color = disp_refr->bg_color;
             dsc.bg_opa = disp_refr->bg_opa;
+#if LV_DRAW_LIST_SIZE
+            if(_lv_draw_list_is_recording(draw_ctx)) _lv_draw_list_add_bg(draw_ctx, &dsc, &a);
+            else draw_ctx->draw_bg(draw_ctx, &dsc, &a);
+#else
             draw_ctx->draw_bg(draw_ctx, &dsc, &a);
+#endif
         }
         else if(disp_refr->bg_img) {
             lv_img_header_t header;
@@ -794,8 +1034,6 @@ static void refr_area_part(lv_draw_ctx_t * draw_ctx)
     /*Also refresh top and sys layer unconditionally*/
     refr_obj_and_children(draw_ctx, lv_disp_get_layer_top(disp_refr));
     refr_obj_and_children(draw_ctx, lv_disp_get_layer_sys(disp_refr));
-
-    draw_buf_flush(disp_refr);
 }
 
 /**
@@ -821,6 +1059,10 @@ static lv_obj_t * lv_refr_get_top_obj(const lv_area_t * area_p, lv_obj_t * obj)
 
     int32_t i;
     int32_t child_cnt = lv_obj_get_child_cnt(obj);
+#if LV_OBJ_RENDER_CACHE_SIZE
+    /*The children are drawn from the cached image of the object*/
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_RENDER_CACHE)) child_cnt = 0;
+#endif
     for(i = child_cnt - 1; i >= 0; i--) {
         lv_obj_t * child = obj->spec_attr->children[i];
         found_p = lv_refr_get_top_obj(area_p, child);
@@ -974,6 +1216,13 @@ void refr_obj(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj)
         lv_obj_redraw(draw_ctx, obj);
     }
     else {
+#if LV_DRAW_LIST_SIZE
+        /*Layers are rendered into their own buffers and can't be recorded. Draw the bands directly.*/
+        if(_lv_draw_list_is_recording(draw_ctx)) {
+            _lv_draw_list_abort();
+            return;
+        }
+#endif
         lv_opa_t opa = lv_obj_get_style_opa_layered(obj, 0);
         if(opa < LV_OPA_MIN) return;
 
@@ -1327,6 +1576,191 @@ static void call_flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_
     drv->flush_cb(drv, &offset_area, color_p);
 }
 
+#if LV_OBJ_RENDER_CACHE_SIZE
+/**
+ * Draw an object with its children from its cached image. Render the image first if it's outdated.
+ * @param draw_ctx  pointer to an initialized draw context
+ * @param obj       pointer to an object with `LV_OBJ_FLAG_RENDER_CACHE`
+ * @return          true: the object is drawn; false: the object needs to be drawn normally
+ */
+static bool render_cache_draw(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj)
+{
+    /*The children out of the object wouldn't be in the image*/
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_OVERFLOW_VISIBLE)) return false;
+
+    lv_obj_allocate_spec_attr(obj);
+    if(obj->spec_attr == NULL) return false;
+
+    _lv_obj_render_cache_t * cache = obj->spec_attr->render_cache;
+
+    /*Being rendered into its image right now*/
+    if(cache && cache->rendering) return false;
+
+    lv_area_t obj_coords_ext;
+    lv_obj_get_coords(obj, &obj_coords_ext);
+    lv_coord_t ext_draw_size = _lv_obj_get_ext_draw_size(obj);
+    lv_area_increase(&obj_coords_ext, ext_draw_size, ext_draw_size);
+
+    lv_area_t clip_coords_for_obj;
+    if(!_lv_area_intersect(&clip_coords_for_obj, draw_ctx->clip_area, &obj_coords_ext)) return true;
+
+    if(cache == NULL) {
+        cache = lv_mem_alloc(sizeof(_lv_obj_render_cache_t));
+        LV_ASSERT_MALLOC(cache);
+        if(cache == NULL) return false;
+        lv_memset_00(cache, sizeof(_lv_obj_render_cache_t));
+        obj->spec_attr->render_cache = cache;
+    }
+
+    if(!cache->valid ||
+       cache->img.header.w != lv_area_get_width(&obj_coords_ext) ||
+       cache->img.header.h != lv_area_get_height(&obj_coords_ext)) {
+        if(!render_cache_build(obj, cache, &obj_coords_ext)) {
+            render_cache_stat.skip_cnt++;
+            return false;
+        }
+        render_cache_stat.build_cnt++;
+    }
+    else {
+        render_cache_stat.hit_cnt++;
+    }
+
+    const lv_area_t * clip_area_ori = draw_ctx->clip_area;
+    draw_ctx->clip_area = &clip_coords_for_obj;
+
+    lv_draw_img_dsc_t draw_dsc;
+    lv_draw_img_dsc_init(&draw_dsc);
+    lv_draw_img(draw_ctx, &draw_dsc, &obj_coords_ext, &cache->img);
+
+    draw_ctx->clip_area = clip_area_ori;
+    return true;
+}
+
+/**
+ * Render an object with its children into its cached image.
+ * An own draw context is used (like in `lv_snapshot`) because it can render with alpha channel
+ * and the image can be kept after rendering.
+ * @param obj       pointer to an object
+ * @param cache     the cache of the object
+ * @param area      the area to render (the object's coordinates with the extra draw size)
+ * @return          true: the image is ready; false: the image can't be rendered
+ */
+static bool render_cache_build(lv_obj_t * obj, _lv_obj_render_cache_t * cache, const lv_area_t * area)
+{
+    cache->valid = 0;
+
+    /*Alpha channel is required only if the object doesn't cover the whole area*/
+    bool has_alpha = true;
+    if(_lv_area_is_in(area, &obj->coords, 0)) {
+        lv_cover_check_info_t info;
+        info.res = LV_COVER_RES_COVER;
+        info.area = area;
+        lv_event_send(obj, LV_EVENT_COVER_CHECK, &info);
+        if(info.res == LV_COVER_RES_COVER) has_alpha = false;
+    }
+
+    uint32_t px_size = has_alpha ? LV_IMG_PX_SIZE_ALPHA_BYTE : sizeof(lv_color_t);
+    uint32_t buf_size = lv_area_get_size(area) * px_size;
+
+    /*Keep the buffer if it has the right size already*/
+    if(cache->img.data_size != buf_size) {
+        render_cache_free_buf(cache);
+
+        if(render_cache_stat.used_size + buf_size > LV_OBJ_RENDER_CACHE_SIZE) {
+            LV_LOG_TRACE("%"LV_PRIu32" bytes doesn't fit into the render cache", buf_size);
+            return false;
+        }
+
+        cache->img.data = lv_mem_alloc(buf_size);
+        if(cache->img.data == NULL) {
+            LV_LOG_WARN("Couldn't allocate %"LV_PRIu32" bytes for the render cache", buf_size);
+            return false;
+        }
+        cache->img.data_size = buf_size;
+        render_cache_stat.used_size += buf_size;
+        render_cache_stat.cache_cnt++;
+    }
+    else {
+        lv_img_cache_invalidate_src(&cache->img);
+    }
+
+    lv_memset_00((uint8_t *)cache->img.data, buf_size);
+    cache->img.header.always_zero = 0;
+    cache->img.header.cf = has_alpha ? LV_IMG_CF_TRUE_COLOR_ALPHA : LV_IMG_CF_TRUE_COLOR;
+    cache->img.header.w = lv_area_get_width(area);
+    cache->img.header.h = lv_area_get_height(area);
+
+    lv_disp_t * obj_disp = lv_obj_get_disp(obj);
+    lv_disp_drv_t driver;
+    lv_disp_drv_init(&driver);
+    driver.hor_res = lv_disp_get_hor_res(obj_disp);
+    driver.ver_res = lv_disp_get_ver_res(obj_disp);
+    driver.antialiasing = obj_disp->driver->antialiasing;
+    if(has_alpha) {
+#if LV_COLOR_SCREEN_TRANSP
+        driver.screen_transp = 1;
+#else
+        lv_disp_drv_use_generic_set_px_cb(&driver, LV_IMG_CF_TRUE_COLOR_ALPHA);
+#endif
+    }
+
+    lv_disp_t fake_disp;
+    lv_memset_00(&fake_disp, sizeof(lv_disp_t));
+    fake_disp.driver = &driver;
+
+    lv_draw_ctx_t * draw_ctx = lv_mem_alloc(obj_disp->driver->draw_ctx_size);
+    LV_ASSERT_MALLOC(draw_ctx);
+    if(draw_ctx == NULL) {
+        render_cache_free_buf(cache);
+        return false;
+    }
+    obj_disp->driver->draw_ctx_init(&driver, draw_ctx);
+    lv_area_t buf_area = *area;
+    draw_ctx->buf = (void *)cache->img.data;
+    draw_ctx->buf_area = &buf_area;
+    draw_ctx->clip_area = &buf_area;
+    driver.draw_ctx = draw_ctx;
+
+    /*The masks of the parents (e.g. clip corner) are applied when the image is drawn*/
+    _lv_draw_mask_saved_arr_t masks_ori;
+    lv_memcpy(masks_ori, LV_GC_ROOT(_lv_draw_mask_list), sizeof(masks_ori));
+    lv_memset_00(LV_GC_ROOT(_lv_draw_mask_list), sizeof(masks_ori));
+    lv_disp_t * refr_ori = _lv_refr_get_disp_refreshing();
+    _lv_refr_set_disp_refreshing(&fake_disp);
+
+    cache->rendering = 1;
+    lv_obj_redraw(draw_ctx, obj);
+    lv_draw_wait_for_finish(draw_ctx);
+    cache->rendering = 0;
+
+    _lv_refr_set_disp_refreshing(refr_ori);
+    lv_memcpy(LV_GC_ROOT(_lv_draw_mask_list), masks_ori, sizeof(masks_ori));
+    obj_disp->driver->draw_ctx_deinit(&driver, draw_ctx);
+    lv_mem_free(draw_ctx);
+
+    cache->valid = 1;
+    return true;
+}
+
+/**
+ * Free the image of a render cache
+ * @param cache     pointer to a render cache
+ */
+static void render_cache_free_buf(_lv_obj_render_cache_t * cache)
+{
+    cache->valid = 0;
+    if(cache->img.data == NULL) return;
+
+    lv_img_cache_invalidate_src(&cache->img);
+    lv_mem_free((void *)cache->img.data);
+    render_cache_stat.used_size -= cache->img.data_size;
+    render_cache_stat.cache_cnt--;
+
+    cache->img.data = NULL;
+    cache->img.data_size = 0;
+}
+#endif
+
 #if LV_USE_PERF_MONITOR
 static void perf_monitor_init(perf_monitor_t * _perf_monitor)
 {
@@ -26,6 +26,19 @@ extern "C" {
  *      TYPEDEFS
  **********************/
 
+#if LV_OBJ_RENDER_CACHE_SIZE
+/**
+ * Statistics of the objects drawn with `LV_OBJ_FLAG_RENDER_CACHE`
+ */
+typedef struct {
+    uint32_t hit_cnt;       /**< Number of times an object was drawn from its cached image*/
+    uint32_t build_cnt;     /**< Number of times an image was (re)rendered*/
+    uint32_t skip_cnt;      /**< Number of times an object was drawn normally because its image didn't fit into the memory*/
+    uint32_t cache_cnt;     /**< Number of cached images*/
+    uint32_t used_size;     /**< Memory used by the cached images in bytes*/
+} lv_refr_render_cache_stat_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -71,6 +84,20 @@ void lv_obj_redraw(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj);
  */
 void _lv_inv_area(lv_disp_t * disp, const lv_area_t * area_p);
 
+#if LV_USE_SCROLL_COPY
+/**
+ * Move an already rendered area of a display instead of redrawing it.
+ * The content of the frame buffer is moved before the next refresh and only the newly exposed parts are invalidated.
+ * Works only in direct mode without rotation and only one area can be moved in a refresh period.
+ * @param disp  pointer to display (NULL can be used if there is only one display)
+ * @param area  the area whose content should be moved. The content is not moved out of this area.
+ * @param dx    the horizontal distance to move the content
+ * @param dy    the vertical distance to move the content
+ * @return      true: the move is registered; false: the area can't be moved, it should be invalidated instead
+ */
+bool _lv_inv_area_scroll(lv_disp_t * disp, const lv_area_t * area, lv_coord_t dx, lv_coord_t dy);
+#endif
+
 /**
  * Get the display which is being refreshed
  * @return the display being refreshed
@@ -98,6 +125,32 @@ void lv_refr_reset_fps_counter(void);
 uint32_t lv_refr_get_fps_avg(void);
 #endif
 
+#if LV_OBJ_RENDER_CACHE_SIZE
+/**
+ * Get the statistics of the render cache
+ * @param stat  store the statistics here
+ */
+void lv_refr_get_render_cache_stat(lv_refr_render_cache_stat_t * stat);
+
+/**
+ * Reset the hit, build and skip counters of the render cache
+ */
+void lv_refr_reset_render_cache_stat(void);
+
+/**
+ * Mark the cached image of the object and its parents as outdated.
+ * It's called automatically when an object is invalidated.
+ * @param obj   pointer to an object
+ */
+void _lv_refr_render_cache_invalidate(const lv_obj_t * obj);
+
+/**
+ * Free the cached image of an object
+ * @param obj   pointer to an object
+ */
+void _lv_refr_render_cache_free(lv_obj_t * obj);
+#endif
+
 /**
  * Called periodically to handle the refreshing
  * @param timer pointer to the timer itself
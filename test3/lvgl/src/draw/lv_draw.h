@@ -29,6 +29,7 @@ extern "C" {
 #include "lv_draw_mask.h"
 #include "lv_draw_transform.h"
 #include "lv_draw_layer.h"
+#include "lv_draw_list.h"
 
 /*********************
  *      DEFINES
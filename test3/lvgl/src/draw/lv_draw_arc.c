@@ -48,6 +48,13 @@ void lv_draw_arc(lv_draw_ctx_t * draw_ctx, const lv_draw_arc_dsc_t * dsc, const
     if(dsc->width == 0) return;
     if(start_angle == end_angle) return;
 
+#if LV_DRAW_LIST_SIZE
+    if(_lv_draw_list_is_recording(draw_ctx)) {
+        _lv_draw_list_add_arc(draw_ctx, dsc, center, radius, start_angle, end_angle);
+        return;
+    }
+#endif
+
     draw_ctx->draw_arc(draw_ctx, dsc, center, radius, start_angle, end_angle);
 
     //    const lv_draw_backend_t * backend = lv_draw_backend_get();
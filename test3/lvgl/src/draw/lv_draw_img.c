@@ -70,6 +70,13 @@ void lv_draw_img(lv_draw_ctx_t * draw_ctx, const lv_draw_img_dsc_t * dsc, const
 
     if(dsc->opa <= LV_OPA_MIN) return;
 
+#if LV_DRAW_LIST_SIZE
+    if(_lv_draw_list_is_recording(draw_ctx)) {
+        _lv_draw_list_add_img(draw_ctx, dsc, coords, src);
+        return;
+    }
+#endif
+
     lv_res_t res = LV_RES_INV;
 
     if(draw_ctx->draw_img) {
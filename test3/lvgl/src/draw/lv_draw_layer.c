@@ -39,7 +39,9 @@ lv_draw_layer_ctx_t * lv_draw_layer_create(lv_draw_ctx_t * draw_ctx, const lv_ar
 {
     if(draw_ctx->layer_init == NULL) return NULL;
 
+    lv_mem_tag_t tag_prev = lv_mem_tag_set(LV_MEM_TAG_DRAW);
     lv_draw_layer_ctx_t * layer_ctx = lv_mem_alloc(draw_ctx->layer_instance_size);
+    lv_mem_tag_set(tag_prev);
     LV_ASSERT_MALLOC(layer_ctx);
     if(layer_ctx == NULL) {
         LV_LOG_WARN("Couldn't allocate a new layer context");
@@ -0,0 +1,590 @@
+/**
+ * @file lv_draw_list.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw.h"
+#if LV_DRAW_LIST_SIZE
+
+#include <string.h>
+#include "../core/lv_refr.h"
+#include "../misc/lv_math.h"
+#include "../misc/lv_mem.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+/*Keep every operation aligned to 8 bytes because the descriptors contain pointers*/
+#define OP_ALIGN(size)  (((size) + 7) & ~((uint32_t)7))
+
+/*Initial size of the list buffer. It's doubled up to `LV_DRAW_LIST_SIZE` if required*/
+#define LIST_BUF_SIZE_MIN  1024
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef enum {
+    OP_RECT,
+    OP_BG,
+    OP_LABEL,
+    OP_LETTER,
+    OP_IMG,
+    OP_ARC,
+    OP_LINE,
+    OP_POLYGON,
+    OP_MASK_ADD,
+    OP_MASK_REMOVE,
+} op_type_t;
+
+typedef struct {
+    uint32_t type : 4;
+    uint32_t size : 28;     /*Size of the operation together with its header, aligned*/
+    lv_area_t clip;         /*The clip area when the operation was recorded*/
+    lv_area_t bound;        /*The area the operation can draw to, clipped to `clip`*/
+} op_header_t;
+
+typedef struct {
+    op_header_t header;
+    lv_draw_rect_dsc_t dsc;
+    lv_area_t coords;
+} op_rect_t;
+
+typedef struct {
+    op_header_t header;
+    lv_draw_label_dsc_t dsc;
+    lv_area_t coords;
+    lv_draw_label_hint_t * hint;
+    char txt[];
+} op_label_t;
+
+typedef struct {
+    op_header_t header;
+    lv_draw_label_dsc_t dsc;
+    lv_point_t pos;
+    uint32_t letter;
+} op_letter_t;
+
+typedef struct {
+    op_header_t header;
+    lv_draw_img_dsc_t dsc;
+    lv_area_t coords;
+    const void * src;       /*NULL if the source is a string stored in `src_str`*/
+    char src_str[];
+} op_img_t;
+
+typedef struct {
+    op_header_t header;
+    lv_draw_arc_dsc_t dsc;
+    lv_point_t center;
+    uint16_t radius;
+    uint16_t start_angle;
+    uint16_t end_angle;
+} op_arc_t;
+
+typedef struct {
+    op_header_t header;
+    lv_draw_line_dsc_t dsc;
+    lv_point_t point1;
+    lv_point_t point2;
+} op_line_t;
+
+typedef struct {
+    op_header_t header;
+    lv_draw_rect_dsc_t dsc;
+    uint16_t point_cnt;
+    lv_point_t points[];
+} op_polygon_t;
+
+#if LV_DRAW_COMPLEX
+typedef struct {
+    op_header_t header;
+    int16_t id;             /*The ID of the mask when it was recorded*/
+    union {
+        _lv_draw_mask_common_dsc_t dsc;
+        lv_draw_mask_line_param_t line;
+        lv_draw_mask_angle_param_t angle;
+        lv_draw_mask_radius_param_t radius;
+        lv_draw_mask_fade_param_t fade;
+    } param;
+} op_mask_add_t;
+
+typedef struct {
+    op_header_t header;
+    int16_t id;
+} op_mask_remove_t;
+#endif
+
+typedef struct {
+    uint8_t * buf;
+    uint32_t buf_size;
+    uint32_t used;
+    const lv_draw_ctx_t * draw_ctx;
+    const lv_disp_t * disp;
+    uint8_t recording : 1;
+    uint8_t aborted : 1;
+} draw_list_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void * op_add(const lv_draw_ctx_t * draw_ctx, op_type_t type, uint32_t size, const lv_area_t * bound);
+static void * op_alloc(op_type_t type, uint32_t size);
+static void op_replay(lv_draw_ctx_t * draw_ctx, op_header_t * header);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static draw_list_t list;
+static lv_draw_list_stat_t list_stat;
+
+#if LV_DRAW_COMPLEX
+    static int16_t mask_id_map[_LV_MASK_MAX_NUM];
+#endif
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void _lv_draw_list_start(lv_draw_ctx_t * draw_ctx, lv_disp_t * disp)
+{
+    list.used = 0;
+    list.draw_ctx = draw_ctx;
+    list.disp = disp;
+    list.recording = 1;
+    list.aborted = 0;
+}
+
+bool _lv_draw_list_finish(void)
+{
+    list.recording = 0;
+    list.draw_ctx = NULL;
+    list.disp = NULL;
+
+    if(list.aborted) {
+        list.used = 0;
+        list_stat.abort_cnt++;
+        return false;
+    }
+
+    list_stat.record_cnt++;
+    return true;
+}
+
+void _lv_draw_list_abort(void)
+{
+    if(list.recording) list.aborted = 1;
+}
+
+bool _lv_draw_list_is_recording(const lv_draw_ctx_t * draw_ctx)
+{
+    return list.recording && list.draw_ctx == draw_ctx;
+}
+
+void _lv_draw_list_replay(lv_draw_ctx_t * draw_ctx)
+{
+    const lv_area_t * band = draw_ctx->clip_area;
+
+#if LV_DRAW_COMPLEX
+    uint32_t i;
+    for(i = 0; i < _LV_MASK_MAX_NUM; i++) mask_id_map[i] = LV_MASK_ID_INV;
+#endif
+
+    uint32_t ofs = 0;
+    while(ofs < list.used) {
+        op_header_t * header = (op_header_t *)(list.buf + ofs);
+        ofs += header->size;
+
+        /*The masks are applied in every band to keep the mask list the same as during recording*/
+        if(header->type == OP_MASK_ADD || header->type == OP_MASK_REMOVE) {
+            op_replay(draw_ctx, header);
+            continue;
+        }
+
+        lv_area_t clip;
+        if(!_lv_area_is_on(&header->bound, band) || !_lv_area_intersect(&clip, &header->clip, band)) {
+            list_stat.skip_cnt++;
+            continue;
+        }
+
+        draw_ctx->clip_area = &clip;
+        op_replay(draw_ctx, header);
+        list_stat.replay_cnt++;
+    }
+
+    draw_ctx->clip_area = band;
+
+#if LV_DRAW_COMPLEX
+    /*Remove the masks which were not removed by the recorded operations*/
+    for(i = 0; i < _LV_MASK_MAX_NUM; i++) {
+        if(mask_id_map[i] != LV_MASK_ID_INV) {
+            void * p = lv_draw_mask_remove_id(mask_id_map[i]);
+            if(p) lv_draw_mask_free_param(p);
+        }
+    }
+#endif
+}
+
+void _lv_draw_list_add_rect(const lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc,
+                            const lv_area_t * coords)
+{
+    /*Add the shadow and the outline which are drawn out of the coordinates*/
+    lv_coord_t ext = 0;
+    if(dsc->shadow_width && dsc->shadow_opa > LV_OPA_MIN) {
+        ext = dsc->shadow_width + LV_ABS(dsc->shadow_spread) +
+              LV_MAX(LV_ABS(dsc->shadow_ofs_x), LV_ABS(dsc->shadow_ofs_y));
+    }
+    if(dsc->outline_width && dsc->outline_opa > LV_OPA_MIN) {
+        ext = LV_MAX(ext, dsc->outline_width + dsc->outline_pad);
+    }
+
+    lv_area_t bound = *coords;
+    lv_area_increase(&bound, ext, ext);
+
+    op_rect_t * op = op_add(draw_ctx, OP_RECT, sizeof(op_rect_t), &bound);
+    if(op == NULL) return;
+
+    op->dsc = *dsc;
+    op->coords = *coords;
+}
+
+void _lv_draw_list_add_bg(const lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc,
+                          const lv_area_t * coords)
+{
+    op_rect_t * op = op_add(draw_ctx, OP_BG, sizeof(op_rect_t), coords);
+    if(op == NULL) return;
+
+    op->dsc = *dsc;
+    op->coords = *coords;
+}
+
+void _lv_draw_list_add_label(const lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc,
+                             const lv_area_t * coords, const char * txt, lv_draw_label_hint_t * hint)
+{
+    /*The text can overflow the coordinates to the bottom and the letters might stick out a little at the top*/
+    lv_area_t bound = *draw_ctx->clip_area;
+    bound.y1 = coords->y1 + LV_MIN(dsc->ofs_y, 0) - lv_font_get_line_height(dsc->font);
+
+    uint32_t txt_size = strlen(txt) + 1;
+    op_label_t * op = op_add(draw_ctx, OP_LABEL, sizeof(op_label_t) + txt_size, &bound);
+    if(op == NULL) return;
+
+    op->dsc = *dsc;
+    op->coords = *coords;
+    op->hint = hint;
+    lv_memcpy(op->txt, txt, txt_size);
+}
+
+void _lv_draw_list_add_letter(const lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc,
+                              const lv_point_t * pos_p, uint32_t letter)
+{
+    lv_coord_t line_h = lv_font_get_line_height(dsc->font);
+    lv_area_t bound = *draw_ctx->clip_area;
+    bound.y1 = pos_p->y - line_h;
+    bound.y2 = pos_p->y + 2 * line_h;
+
+    op_letter_t * op = op_add(draw_ctx, OP_LETTER, sizeof(op_letter_t), &bound);
+    if(op == NULL) return;
+
+    op->dsc = *dsc;
+    op->pos = *pos_p;
+    op->letter = letter;
+}
+
+void _lv_draw_list_add_img(const lv_draw_ctx_t * draw_ctx, const lv_draw_img_dsc_t * dsc,
+                           const lv_area_t * coords, const void * src)
+{
+    /*Transformed images can be anywhere in the clip area*/
+    const lv_area_t * bound = coords;
+    if(dsc->angle || dsc->zoom != LV_IMG_ZOOM_NONE) bound = draw_ctx->clip_area;
+
+    /*File names and symbols might be in temporary buffers so save them*/
+    uint32_t str_size = 0;
+    if(lv_img_src_get_type(src) != LV_IMG_SRC_VARIABLE) str_size = strlen(src) + 1;
+
+    op_img_t * op = op_add(draw_ctx, OP_IMG, sizeof(op_img_t) + str_size, bound);
+    if(op == NULL) return;
+
+    op->dsc = *dsc;
+    op->coords = *coords;
+    if(str_size) {
+        op->src = NULL;
+        lv_memcpy(op->src_str, src, str_size);
+    }
+    else {
+        op->src = src;
+    }
+}
+
+void _lv_draw_list_add_arc(const lv_draw_ctx_t * draw_ctx, const lv_draw_arc_dsc_t * dsc,
+                           const lv_point_t * center, uint16_t radius, uint16_t start_angle, uint16_t end_angle)
+{
+    lv_area_t bound;
+    lv_area_set(&bound, center->x - radius, center->y - radius, center->x + radius, center->y + radius);
+
+    op_arc_t * op = op_add(draw_ctx, OP_ARC, sizeof(op_arc_t), &bound);
+    if(op == NULL) return;
+
+    op->dsc = *dsc;
+    op->center = *center;
+    op->radius = radius;
+    op->start_angle = start_angle;
+    op->end_angle = end_angle;
+}
+
+void _lv_draw_list_add_line(const lv_draw_ctx_t * draw_ctx, const lv_draw_line_dsc_t * dsc,
+                            const lv_point_t * point1, const lv_point_t * point2)
+{
+    lv_area_t bound;
+    bound.x1 = LV_MIN(point1->x, point2->x) - dsc->width;
+    bound.y1 = LV_MIN(point1->y, point2->y) - dsc->width;
+    bound.x2 = LV_MAX(point1->x, point2->x) + dsc->width;
+    bound.y2 = LV_MAX(point1->y, point2->y) + dsc->width;
+
+    op_line_t * op = op_add(draw_ctx, OP_LINE, sizeof(op_line_t), &bound);
+    if(op == NULL) return;
+
+    op->dsc = *dsc;
+    op->point1 = *point1;
+    op->point2 = *point2;
+}
+
+void _lv_draw_list_add_polygon(const lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc,
+                               const lv_point_t points[], uint16_t point_cnt)
+{
+    if(point_cnt < 3 || points == NULL) return;
+
+    lv_area_t bound;
+    lv_area_set(&bound, points[0].x, points[0].y, points[0].x, points[0].y);
+    uint16_t i;
+    for(i = 1; i < point_cnt; i++) {
+        bound.x1 = LV_MIN(bound.x1, points[i].x);
+        bound.y1 = LV_MIN(bound.y1, points[i].y);
+        bound.x2 = LV_MAX(bound.x2, points[i].x);
+        bound.y2 = LV_MAX(bound.y2, points[i].y);
+    }
+
+    uint32_t points_size = point_cnt * sizeof(lv_point_t);
+    op_polygon_t * op = op_add(draw_ctx, OP_POLYGON, sizeof(op_polygon_t) + points_size, &bound);
+    if(op == NULL) return;
+
+    op->dsc = *dsc;
+    op->point_cnt = point_cnt;
+    lv_memcpy(op->points, points, points_size);
+}
+
+#if LV_DRAW_COMPLEX
+void _lv_draw_list_add_mask(const void * param, int16_t id)
+{
+    if(!list.recording || list.aborted || id == LV_MASK_ID_INV) return;
+    if(_lv_refr_get_disp_refreshing() != list.disp) return;
+
+    uint32_t param_size;
+    const _lv_draw_mask_common_dsc_t * dsc = param;
+    switch(dsc->type) {
+        case LV_DRAW_MASK_TYPE_LINE:
+            param_size = sizeof(lv_draw_mask_line_param_t);
+            break;
+        case LV_DRAW_MASK_TYPE_ANGLE:
+            param_size = sizeof(lv_draw_mask_angle_param_t);
+            break;
+        case LV_DRAW_MASK_TYPE_RADIUS:
+            param_size = sizeof(lv_draw_mask_radius_param_t);
+            break;
+        case LV_DRAW_MASK_TYPE_FADE:
+            param_size = sizeof(lv_draw_mask_fade_param_t);
+            break;
+        default:
+            /*Map and polygon masks refer to external buffers which might be freed before replaying*/
+            _lv_draw_list_abort();
+            return;
+    }
+
+    op_mask_add_t * op = op_alloc(OP_MASK_ADD, sizeof(op_mask_add_t));
+    if(op == NULL) return;
+
+    op->id = id;
+    lv_memcpy(&op->param, param, param_size);
+}
+
+void _lv_draw_list_remove_mask(int16_t id)
+{
+    if(!list.recording || list.aborted || id == LV_MASK_ID_INV) return;
+    if(_lv_refr_get_disp_refreshing() != list.disp) return;
+
+    op_mask_remove_t * op = op_alloc(OP_MASK_REMOVE, sizeof(op_mask_remove_t));
+    if(op == NULL) return;
+
+    op->id = id;
+}
+#endif
+
+void lv_draw_list_get_stat(lv_draw_list_stat_t * stat)
+{
+    *stat = list_stat;
+    stat->used_size = list.buf_size;
+}
+
+void lv_draw_list_reset_stat(void)
+{
+    lv_memset_00(&list_stat, sizeof(list_stat));
+}
+
+void lv_draw_list_clean(void)
+{
+    if(list.recording) return;
+
+    lv_mem_free(list.buf);
+    list.buf = NULL;
+    list.buf_size = 0;
+    list.used = 0;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Add a draw operation to the list if it's visible
+ * @param draw_ctx  pointer to the draw context (its `clip_area` is saved)
+ * @param type      type of the operation
+ * @param size      size of the operation with its header and payload
+ * @param bound     the area the operation can draw to
+ * @return          pointer to the new operation or NULL if it's not visible or there is no more space
+ */
+static void * op_add(const lv_draw_ctx_t * draw_ctx, op_type_t type, uint32_t size, const lv_area_t * bound)
+{
+    if(list.aborted) return NULL;
+
+    lv_area_t bound_clipped;
+    if(!_lv_area_intersect(&bound_clipped, bound, draw_ctx->clip_area)) return NULL;
+
+    op_header_t * header = op_alloc(type, size);
+    if(header == NULL) return NULL;
+
+    header->clip = *draw_ctx->clip_area;
+    header->bound = bound_clipped;
+    return header;
+}
+
+/**
+ * Allocate a new operation at the end of the list. Abort the recording if it doesn't fit.
+ * @param type      type of the operation
+ * @param size      size of the operation with its header and payload
+ * @return          pointer to the new operation or NULL on error
+ */
+static void * op_alloc(op_type_t type, uint32_t size)
+{
+    size = OP_ALIGN(size);
+
+    if(list.used + size > list.buf_size) {
+        uint32_t new_size = list.buf_size ? list.buf_size : LIST_BUF_SIZE_MIN;
+        while(new_size < list.used + size) new_size *= 2;
+        if(new_size > LV_DRAW_LIST_SIZE) new_size = LV_DRAW_LIST_SIZE;
+
+        uint8_t * new_buf = NULL;
+        if(new_size >= list.used + size) {
+            lv_mem_tag_t tag_prev = lv_mem_tag_set(LV_MEM_TAG_DRAW);
+            new_buf = lv_mem_realloc(list.buf, new_size);
+            lv_mem_tag_set(tag_prev);
+        }
+
+        if(new_buf == NULL) {
+            LV_LOG_INFO("the draw list doesn't fit into %d bytes, draw the bands directly", (int)new_size);
+            _lv_draw_list_abort();
+            return NULL;
+        }
+
+        list.buf = new_buf;
+        list.buf_size = new_size;
+    }
+
+    op_header_t * header = (op_header_t *)(list.buf + list.used);
+    header->type = type;
+    header->size = size;
+    list.used += size;
+    list_stat.op_cnt++;
+
+    return header;
+}
+
+/**
+ * Execute a recorded operation on `draw_ctx`
+ * @param draw_ctx  pointer to a draw context
+ * @param header    pointer to the operation
+ */
+static void op_replay(lv_draw_ctx_t * draw_ctx, op_header_t * header)
+{
+    switch(header->type) {
+        case OP_RECT: {
+                op_rect_t * op = (op_rect_t *)header;
+                lv_draw_rect(draw_ctx, &op->dsc, &op->coords);
+                break;
+            }
+        case OP_BG: {
+                op_rect_t * op = (op_rect_t *)header;
+                draw_ctx->draw_bg(draw_ctx, &op->dsc, &op->coords);
+                break;
+            }
+        case OP_LABEL: {
+                op_label_t * op = (op_label_t *)header;
+                lv_draw_label(draw_ctx, &op->dsc, &op->coords, op->txt, op->hint);
+                break;
+            }
+        case OP_LETTER: {
+                op_letter_t * op = (op_letter_t *)header;
+                lv_draw_letter(draw_ctx, &op->dsc, &op->pos, op->letter);
+                break;
+            }
+        case OP_IMG: {
+                op_img_t * op = (op_img_t *)header;
+                lv_draw_img(draw_ctx, &op->dsc, &op->coords, op->src ? op->src : op->src_str);
+                break;
+            }
+        case OP_ARC: {
+                op_arc_t * op = (op_arc_t *)header;
+                lv_draw_arc(draw_ctx, &op->dsc, &op->center, op->radius, op->start_angle, op->end_angle);
+                break;
+            }
+        case OP_LINE: {
+                op_line_t * op = (op_line_t *)header;
+                lv_draw_line(draw_ctx, &op->dsc, &op->point1, &op->point2);
+                break;
+            }
+        case OP_POLYGON: {
+                op_polygon_t * op = (op_polygon_t *)header;
+                lv_draw_polygon(draw_ctx, &op->dsc, op->points, op->point_cnt);
+                break;
+            }
+#if LV_DRAW_COMPLEX
+        case OP_MASK_ADD: {
+                op_mask_add_t * op = (op_mask_add_t *)header;
+                /*The circle of a radius mask is taken from the cache again and released on remove*/
+                if(op->param.dsc.type == LV_DRAW_MASK_TYPE_RADIUS) {
+                    lv_area_t rect = op->param.radius.cfg.rect;
+                    lv_draw_mask_radius_init(&op->param.radius, &rect, op->param.radius.cfg.radius,
+                                             op->param.radius.cfg.outer);
+                }
+                mask_id_map[op->id] = lv_draw_mask_add(&op->param, NULL);
+                break;
+            }
+        case OP_MASK_REMOVE: {
+                op_mask_remove_t * op = (op_mask_remove_t *)header;
+                void * p = lv_draw_mask_remove_id(mask_id_map[op->id]);
+                if(p) lv_draw_mask_free_param(p);
+                mask_id_map[op->id] = LV_MASK_ID_INV;
+                break;
+            }
+#endif
+        default:
+            break;
+    }
+}
+
+#endif /*LV_DRAW_LIST_SIZE*/
@@ -0,0 +1,149 @@
+/**
+ * @file lv_draw_list.h
+ *
+ */
+
+#ifndef LV_DRAW_LIST_H
+#define LV_DRAW_LIST_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../lv_conf_internal.h"
+
+#if LV_DRAW_LIST_SIZE
+
+#include "../misc/lv_area.h"
+#include "lv_draw_rect.h"
+#include "lv_draw_label.h"
+#include "lv_draw_img.h"
+#include "lv_draw_line.h"
+#include "lv_draw_arc.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+struct _lv_draw_ctx_t;
+struct _lv_disp_t;
+
+typedef struct {
+    uint32_t record_cnt;    /**< Number of areas recorded into a draw list*/
+    uint32_t abort_cnt;     /**< Number of recordings given up (layers, unsupported masks or out of memory)*/
+    uint32_t op_cnt;        /**< Number of draw operations recorded*/
+    uint32_t replay_cnt;    /**< Number of draw operations replayed in the bands*/
+    uint32_t skip_cnt;      /**< Number of draw operations skipped in a band because they were out of it*/
+    uint32_t used_size;     /**< Size of the draw list buffer in bytes*/
+} lv_draw_list_stat_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Start recording the draw operations of `draw_ctx` instead of drawing them.
+ * @param draw_ctx  pointer to the draw context of the display being refreshed
+ * @param disp      pointer to the display being refreshed
+ */
+void _lv_draw_list_start(struct _lv_draw_ctx_t * draw_ctx, struct _lv_disp_t * disp);
+
+/**
+ * Stop the recording.
+ * @return          true: the recorded list can be replayed; false: the recording was aborted
+ */
+bool _lv_draw_list_finish(void);
+
+/**
+ * Give up the current recording. The draw operations are still swallowed until `_lv_draw_list_finish`.
+ */
+void _lv_draw_list_abort(void);
+
+/**
+ * Tell whether the draw operations of a draw context are being recorded
+ * @param draw_ctx  pointer to a draw context
+ * @return          true: the draw functions should only record the operation
+ */
+bool _lv_draw_list_is_recording(const struct _lv_draw_ctx_t * draw_ctx);
+
+/**
+ * Replay the recorded draw operations on the current band of `draw_ctx`.
+ * Operations which are out of `draw_ctx->clip_area` are skipped.
+ * @param draw_ctx  pointer to a draw context
+ */
+void _lv_draw_list_replay(struct _lv_draw_ctx_t * draw_ctx);
+
+void _lv_draw_list_add_rect(const struct _lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc,
+                            const lv_area_t * coords);
+
+void _lv_draw_list_add_bg(const struct _lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc,
+                          const lv_area_t * coords);
+
+void _lv_draw_list_add_label(const struct _lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc,
+                             const lv_area_t * coords, const char * txt, lv_draw_label_hint_t * hint);
+
+void _lv_draw_list_add_letter(const struct _lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc,
+                              const lv_point_t * pos_p, uint32_t letter);
+
+void _lv_draw_list_add_img(const struct _lv_draw_ctx_t * draw_ctx, const lv_draw_img_dsc_t * dsc,
+                           const lv_area_t * coords, const void * src);
+
+void _lv_draw_list_add_arc(const struct _lv_draw_ctx_t * draw_ctx, const lv_draw_arc_dsc_t * dsc,
+                           const lv_point_t * center, uint16_t radius, uint16_t start_angle, uint16_t end_angle);
+
+void _lv_draw_list_add_line(const struct _lv_draw_ctx_t * draw_ctx, const lv_draw_line_dsc_t * dsc,
+                            const lv_point_t * point1, const lv_point_t * point2);
+
+void _lv_draw_list_add_polygon(const struct _lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc,
+                               const lv_point_t points[], uint16_t point_cnt);
+
+#if LV_DRAW_COMPLEX
+/**
+ * Record adding a mask if a recording is in progress on the display being refreshed.
+ * Called by `lv_draw_mask_add` after the mask was added.
+ * @param param     the mask parameter
+ * @param id        the ID of the added mask
+ */
+void _lv_draw_list_add_mask(const void * param, int16_t id);
+
+/**
+ * Record removing a mask if a recording is in progress on the display being refreshed.
+ * Called by `lv_draw_mask_remove_id`.
+ * @param id        the ID of the removed mask
+ */
+void _lv_draw_list_remove_mask(int16_t id);
+#endif
+
+/**
+ * Get the statistics of the draw list
+ * @param stat  store the statistics here
+ */
+void lv_draw_list_get_stat(lv_draw_list_stat_t * stat);
+
+/**
+ * Reset the counters of the draw list statistics
+ */
+void lv_draw_list_reset_stat(void);
+
+/**
+ * Free the buffer of the draw list. It's allocated again on the next recording.
+ */
+void lv_draw_list_clean(void);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_DRAW_LIST_SIZE*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_DRAW_LIST_H*/
@@ -94,6 +94,10 @@ int16_t lv_draw_mask_add(void * param, void * custom_id)
     LV_GC_ROOT(_lv_draw_mask_list[i]).param = param;
     LV_GC_ROOT(_lv_draw_mask_list[i]).custom_id = custom_id;
 
+#if LV_DRAW_LIST_SIZE
+    _lv_draw_list_add_mask(param, i);
+#endif
+
     return i;
 }
 
@@ -174,6 +178,9 @@ void * lv_draw_mask_remove_id(int16_t id)
     _lv_draw_mask_common_dsc_t * p = NULL;
 
     if(id != LV_MASK_ID_INV) {
+#if LV_DRAW_LIST_SIZE
+        _lv_draw_list_remove_mask(id);
+#endif
         p = LV_GC_ROOT(_lv_draw_mask_list[id]).param;
         LV_GC_ROOT(_lv_draw_mask_list[id]).param = NULL;
         LV_GC_ROOT(_lv_draw_mask_list[id]).custom_id = NULL;
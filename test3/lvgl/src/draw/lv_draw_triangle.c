@@ -38,13 +38,19 @@
 void lv_draw_polygon(struct _lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * draw_dsc, const lv_point_t points[],
                      uint16_t point_cnt)
 {
+#if LV_DRAW_LIST_SIZE
+    if(_lv_draw_list_is_recording(draw_ctx)) {
+        _lv_draw_list_add_polygon(draw_ctx, draw_dsc, points, point_cnt);
+        return;
+    }
+#endif
+
     draw_ctx->draw_polygon(draw_ctx, draw_dsc, points, point_cnt);
 }
 
 void lv_draw_triangle(struct _lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * draw_dsc, const lv_point_t points[])
 {
-
-    draw_ctx->draw_polygon(draw_ctx, draw_dsc, points, 3);
+    lv_draw_polygon(draw_ctx, draw_dsc, points, 3);
 }
 
 /**********************
@@ -120,7 +120,9 @@ _lv_img_cache_entry_t * _lv_img_cache_open(const void * src, lv_color_t color, i
 #endif
     /*Open the image and measure the time to open*/
     uint32_t t_start  = lv_tick_get();
+    lv_mem_tag_t tag_prev = lv_mem_tag_set(LV_MEM_TAG_IMG_CACHE);
     lv_res_t open_res = lv_img_decoder_open(&cached_src->dec_dsc, src, color, frame_id);
+    lv_mem_tag_set(tag_prev);
     if(open_res == LV_RES_INV) {
         LV_LOG_WARN("Image draw cannot open the image resource");
         lv_memset_00(cached_src, sizeof(_lv_img_cache_entry_t));
@@ -159,7 +161,9 @@ void lv_img_cache_set_size(uint16_t new_entry_cnt)
     }
 
     /*Reallocate the cache*/
+    lv_mem_tag_t tag_prev = lv_mem_tag_set(LV_MEM_TAG_IMG_CACHE);
     LV_GC_ROOT(_lv_img_cache_array) = lv_mem_alloc(sizeof(_lv_img_cache_entry_t) * new_entry_cnt);
+    lv_mem_tag_set(tag_prev);
     LV_ASSERT_MALLOC(LV_GC_ROOT(_lv_img_cache_array));
     if(LV_GC_ROOT(_lv_img_cache_array) == NULL) {
         entry_cnt = 0;
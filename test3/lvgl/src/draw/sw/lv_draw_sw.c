@@ -68,6 +68,8 @@ void lv_draw_sw_deinit_ctx(lv_disp_drv_t * drv, lv_draw_ctx_t * draw_ctx)
 {
     LV_UNUSED(drv);
 
+    lv_draw_sw_layer_pool_flush(draw_ctx);
+
     lv_draw_sw_ctx_t * draw_sw_ctx = (lv_draw_sw_ctx_t *) draw_ctx;
     lv_memset_00(draw_sw_ctx, sizeof(lv_draw_sw_ctx_t));
 }
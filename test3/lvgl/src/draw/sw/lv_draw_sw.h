@@ -29,11 +29,28 @@ extern "C" {
 
 struct _lv_disp_drv_t;
 
+typedef struct {
+    uint32_t hit_cnt;           /**< Number of layer buffers reused from the pool*/
+    uint32_t alloc_cnt;         /**< Number of layer buffers allocated*/
+    uint32_t fallback_cnt;      /**< Number of layers rendered with `LV_LAYER_SIMPLE_FALLBACK_BUF_SIZE` buffer*/
+    uint32_t fail_cnt;          /**< Number of layers which couldn't get a buffer*/
+    uint32_t pool_size;         /**< Size of the buffers kept in the pool in bytes*/
+} lv_draw_sw_layer_pool_stat_t;
+
 typedef struct {
     lv_draw_ctx_t base_draw;
 
     /** Fill an area of the destination buffer with a color*/
     void (*blend)(lv_draw_ctx_t * draw_ctx, const lv_draw_sw_blend_dsc_t * dsc);
+
+#if LV_LAYER_BUF_POOL_CNT
+    /** Buffers of the destroyed layers kept for the next layers*/
+    struct {
+        void * buf;
+        uint32_t size;
+    } layer_pool[LV_LAYER_BUF_POOL_CNT];
+#endif
+    lv_draw_sw_layer_pool_stat_t layer_pool_stat;
 } lv_draw_sw_ctx_t;
 
 typedef struct {
@@ -41,6 +58,7 @@ typedef struct {
 
     uint32_t buf_size_bytes: 31;
     uint32_t has_alpha : 1;
+    uint32_t buf_alloc_size;    /*The real size of the buffer, can be larger than `buf_size_bytes`*/
 } lv_draw_sw_layer_ctx_t;
 
 /**********************
@@ -91,6 +109,19 @@ void lv_draw_sw_layer_blend(struct _lv_draw_ctx_t * draw_ctx, struct _lv_draw_la
 
 void lv_draw_sw_layer_destroy(lv_draw_ctx_t * draw_ctx, lv_draw_layer_ctx_t * layer_ctx);
 
+/**
+ * Get the statistics of the layer buffer pool of a draw context
+ * @param draw_ctx  pointer to a SW based draw context
+ * @param stat      store the statistics here
+ */
+void lv_draw_sw_layer_get_pool_stat(lv_draw_ctx_t * draw_ctx, lv_draw_sw_layer_pool_stat_t * stat);
+
+/**
+ * Free the layer buffers kept in the pool of a draw context
+ * @param draw_ctx  pointer to a SW based draw context
+ */
+void lv_draw_sw_layer_pool_flush(lv_draw_ctx_t * draw_ctx);
+
 /***********************
  * GLOBAL VARIABLES
  ***********************/
@@ -14,6 +14,7 @@
 /*********************
  *      DEFINES
  *********************/
+#define LAYER_BUF_MIN_SIZE  1024    /*Don't allocate smaller layer buffers to make them reusable*/
 
 /**********************
  *      TYPEDEFS
@@ -22,6 +23,11 @@
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+static void * layer_buf_alloc(lv_draw_ctx_t * draw_ctx, uint32_t size, uint32_t * alloc_size);
+static void layer_buf_free(lv_draw_ctx_t * draw_ctx, void * buf, uint32_t alloc_size);
+#if LV_LAYER_BUF_POOL_CNT
+static uint32_t layer_buf_get_class_size(uint32_t size);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -49,20 +55,23 @@ struct _lv_draw_layer_ctx_t * lv_draw_sw_layer_create(struct _lv_draw_ctx_t * dr
     }
 
     lv_draw_sw_layer_ctx_t * layer_sw_ctx = (lv_draw_sw_layer_ctx_t *) layer_ctx;
+    lv_draw_sw_ctx_t * draw_sw_ctx = (lv_draw_sw_ctx_t *) draw_ctx;
     uint32_t px_size = flags & LV_DRAW_LAYER_FLAG_HAS_ALPHA ? LV_IMG_PX_SIZE_ALPHA_BYTE : sizeof(lv_color_t);
     if(flags & LV_DRAW_LAYER_FLAG_CAN_SUBDIVIDE) {
         layer_sw_ctx->buf_size_bytes = LV_LAYER_SIMPLE_BUF_SIZE;
         uint32_t full_size = lv_area_get_size(&layer_sw_ctx->base_draw.area_full) * px_size;
         if(layer_sw_ctx->buf_size_bytes > full_size) layer_sw_ctx->buf_size_bytes = full_size;
-        layer_sw_ctx->base_draw.buf = lv_mem_alloc(layer_sw_ctx->buf_size_bytes);
+        layer_sw_ctx->base_draw.buf = layer_buf_alloc(draw_ctx, layer_sw_ctx->buf_size_bytes, &layer_sw_ctx->buf_alloc_size);
         if(layer_sw_ctx->base_draw.buf == NULL) {
             LV_LOG_WARN("Cannot allocate %"LV_PRIu32" bytes for layer buffer. Allocating %"LV_PRIu32" bytes instead. (Reduced performance)",
                         (uint32_t)layer_sw_ctx->buf_size_bytes, (uint32_t)LV_LAYER_SIMPLE_FALLBACK_BUF_SIZE * px_size);
             layer_sw_ctx->buf_size_bytes = LV_LAYER_SIMPLE_FALLBACK_BUF_SIZE;
-            layer_sw_ctx->base_draw.buf = lv_mem_alloc(layer_sw_ctx->buf_size_bytes);
+            layer_sw_ctx->base_draw.buf = layer_buf_alloc(draw_ctx, layer_sw_ctx->buf_size_bytes, &layer_sw_ctx->buf_alloc_size);
             if(layer_sw_ctx->base_draw.buf == NULL) {
+                draw_sw_ctx->layer_pool_stat.fail_cnt++;
                 return NULL;
             }
+            draw_sw_ctx->layer_pool_stat.fallback_cnt++;
         }
         layer_sw_ctx->base_draw.area_act = layer_sw_ctx->base_draw.area_full;
         layer_sw_ctx->base_draw.area_act.y2 = layer_sw_ctx->base_draw.area_full.y1;
@@ -73,12 +82,13 @@ struct _lv_draw_layer_ctx_t * lv_draw_sw_layer_create(struct _lv_draw_ctx_t * dr
     else {
         layer_sw_ctx->base_draw.area_act = layer_sw_ctx->base_draw.area_full;
         layer_sw_ctx->buf_size_bytes = lv_area_get_size(&layer_sw_ctx->base_draw.area_full) * px_size;
-        layer_sw_ctx->base_draw.buf = lv_mem_alloc(layer_sw_ctx->buf_size_bytes);
-        lv_memset_00(layer_sw_ctx->base_draw.buf, layer_sw_ctx->buf_size_bytes);
-        layer_sw_ctx->has_alpha = flags & LV_DRAW_LAYER_FLAG_HAS_ALPHA ? 1 : 0;
+        layer_sw_ctx->base_draw.buf = layer_buf_alloc(draw_ctx, layer_sw_ctx->buf_size_bytes, &layer_sw_ctx->buf_alloc_size);
         if(layer_sw_ctx->base_draw.buf == NULL) {
+            draw_sw_ctx->layer_pool_stat.fail_cnt++;
             return NULL;
         }
+        lv_memset_00(layer_sw_ctx->base_draw.buf, layer_sw_ctx->buf_size_bytes);
+        layer_sw_ctx->has_alpha = flags & LV_DRAW_LAYER_FLAG_HAS_ALPHA ? 1 : 0;
 
         draw_ctx->buf = layer_sw_ctx->base_draw.buf;
         draw_ctx->buf_area = &layer_sw_ctx->base_draw.area_act;
@@ -139,12 +149,142 @@ void lv_draw_sw_layer_blend(struct _lv_draw_ctx_t * draw_ctx, struct _lv_draw_la
 
 void lv_draw_sw_layer_destroy(lv_draw_ctx_t * draw_ctx, lv_draw_layer_ctx_t * layer_ctx)
 {
-    LV_UNUSED(draw_ctx);
+    lv_draw_sw_layer_ctx_t * layer_sw_ctx = (lv_draw_sw_layer_ctx_t *) layer_ctx;
+    layer_buf_free(draw_ctx, layer_ctx->buf, layer_sw_ctx->buf_alloc_size);
+}
+
+void lv_draw_sw_layer_get_pool_stat(lv_draw_ctx_t * draw_ctx, lv_draw_sw_layer_pool_stat_t * stat)
+{
+    LV_ASSERT_NULL(stat);
+    lv_draw_sw_ctx_t * draw_sw_ctx = (lv_draw_sw_ctx_t *) draw_ctx;
+    *stat = draw_sw_ctx->layer_pool_stat;
+}
+
+void lv_draw_sw_layer_pool_flush(lv_draw_ctx_t * draw_ctx)
+{
+#if LV_LAYER_BUF_POOL_CNT
+    lv_draw_sw_ctx_t * draw_sw_ctx = (lv_draw_sw_ctx_t *) draw_ctx;
+    uint32_t i;
+    for(i = 0; i < LV_LAYER_BUF_POOL_CNT; i++) {
+        if(draw_sw_ctx->layer_pool[i].buf == NULL) continue;
 
-    lv_mem_free(layer_ctx->buf);
+        lv_mem_free(draw_sw_ctx->layer_pool[i].buf);
+        draw_sw_ctx->layer_pool[i].buf = NULL;
+        draw_sw_ctx->layer_pool[i].size = 0;
+    }
+    draw_sw_ctx->layer_pool_stat.pool_size = 0;
+#else
+    LV_UNUSED(draw_ctx);
+#endif
 }
 
 
 /**********************
  *   STATIC FUNCTIONS
  **********************/
+
+/**
+ * Get a buffer for a layer. Use the smallest large enough buffer from the pool or allocate a new one.
+ * @param draw_ctx      pointer to a SW based draw context
+ * @param size          the required size in bytes
+ * @param alloc_size    store the real size of the buffer here
+ * @return              pointer to the buffer or NULL if there is not enough memory
+ */
+static void * layer_buf_alloc(lv_draw_ctx_t * draw_ctx, uint32_t size, uint32_t * alloc_size)
+{
+    lv_draw_sw_ctx_t * draw_sw_ctx = (lv_draw_sw_ctx_t *) draw_ctx;
+
+#if LV_LAYER_BUF_POOL_CNT
+    int32_t best = -1;
+    int32_t i;
+    for(i = 0; i < LV_LAYER_BUF_POOL_CNT; i++) {
+        if(draw_sw_ctx->layer_pool[i].buf == NULL || draw_sw_ctx->layer_pool[i].size < size) continue;
+        if(best < 0 || draw_sw_ctx->layer_pool[i].size < draw_sw_ctx->layer_pool[best].size) best = i;
+    }
+
+    if(best >= 0) {
+        void * buf = draw_sw_ctx->layer_pool[best].buf;
+        *alloc_size = draw_sw_ctx->layer_pool[best].size;
+        draw_sw_ctx->layer_pool[best].buf = NULL;
+        draw_sw_ctx->layer_pool[best].size = 0;
+        draw_sw_ctx->layer_pool_stat.pool_size -= *alloc_size;
+        draw_sw_ctx->layer_pool_stat.hit_cnt++;
+        return buf;
+    }
+
+    /*Round up the size to make the buffer usable for similar layers too*/
+    uint32_t class_size = layer_buf_get_class_size(size);
+#else
+    uint32_t class_size = size;
+#endif
+
+    lv_mem_tag_t tag_prev = lv_mem_tag_set(LV_MEM_TAG_DRAW);
+    void * buf = lv_mem_alloc(class_size);
+
+#if LV_LAYER_BUF_POOL_CNT
+    /*Maybe the unused buffers take the memory*/
+    if(buf == NULL && draw_sw_ctx->layer_pool_stat.pool_size > 0) {
+        lv_draw_sw_layer_pool_flush(draw_ctx);
+        buf = lv_mem_alloc(class_size);
+    }
+#endif
+
+    if(buf == NULL && class_size != size) {
+        class_size = size;
+        buf = lv_mem_alloc(class_size);
+    }
+    lv_mem_tag_set(tag_prev);
+
+    if(buf == NULL) return NULL;
+
+    *alloc_size = class_size;
+    draw_sw_ctx->layer_pool_stat.alloc_cnt++;
+    return buf;
+}
+
+/**
+ * Put a layer buffer into the pool or free it if the pool is full
+ * @param draw_ctx      pointer to a SW based draw context
+ * @param buf           the buffer of a layer
+ * @param alloc_size    the real size of the buffer
+ */
+static void layer_buf_free(lv_draw_ctx_t * draw_ctx, void * buf, uint32_t alloc_size)
+{
+    if(buf == NULL) return;
+
+#if LV_LAYER_BUF_POOL_CNT
+    lv_draw_sw_ctx_t * draw_sw_ctx = (lv_draw_sw_ctx_t *) draw_ctx;
+    uint32_t i;
+    for(i = 0; i < LV_LAYER_BUF_POOL_CNT; i++) {
+        if(draw_sw_ctx->layer_pool[i].buf) continue;
+
+        draw_sw_ctx->layer_pool[i].buf = buf;
+        draw_sw_ctx->layer_pool[i].size = alloc_size;
+        draw_sw_ctx->layer_pool_stat.pool_size += alloc_size;
+        return;
+    }
+#else
+    LV_UNUSED(draw_ctx);
+    LV_UNUSED(alloc_size);
+#endif
+
+    lv_mem_free(buf);
+}
+
+#if LV_LAYER_BUF_POOL_CNT
+/**
+ * Round up a buffer size to its size class.
+ * The classes have 4 steps between the powers of 2, so above 4 kB at most 25% is wasted.
+ * @param size      the required size in bytes
+ * @return          the size of the class
+ */
+static uint32_t layer_buf_get_class_size(uint32_t size)
+{
+    if(size <= LAYER_BUF_MIN_SIZE) return LAYER_BUF_MIN_SIZE;
+
+    uint32_t step = LAYER_BUF_MIN_SIZE;
+    while((step << 3) <= size) step <<= 1;
+
+    return (size + step - 1) & ~(step - 1);
+}
+#endif
@@ -15,6 +15,9 @@
 #include <libavutil/samplefmt.h>
 #include <libavutil/timestamp.h>
 #include <libswscale/swscale.h>
+#if LV_FFMPEG_PLAYER_USE_THREADS
+    #include <pthread.h>
+#endif
 
 /*********************
  *      DEFINES
@@ -37,23 +40,65 @@
 
 #define FRAME_DEF_REFR_PERIOD   33  /*[ms]*/
 
+#if LV_FFMPEG_PLAYER_USE_THREADS
+    #define FRAME_BUF_CNT           LV_MAX(LV_FFMPEG_PLAYER_FRAME_CNT, 2)
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
+#if LV_FFMPEG_PLAYER_USE_THREADS
+enum {
+    FFMPEG_FRAME_FREE,
+    FFMPEG_FRAME_DECODING,
+    FFMPEG_FRAME_QUEUED,
+    FFMPEG_FRAME_SHOWN,
+};
+
+/*A frame buffer in the format of the image descriptor*/
+typedef struct {
+    uint8_t * data[4];
+    int64_t pts;                    /*Presentation time [ms]*/
+    uint32_t seq;                   /*Decoding order*/
+    uint8_t state;
+} ffmpeg_frame_t;
+#endif
+
 struct ffmpeg_context_s {
     AVFormatContext * fmt_ctx;
     AVCodecContext * video_dec_ctx;
     AVStream * video_stream;
-    uint8_t * video_src_data[4];
     uint8_t * video_dst_data[4];
     struct SwsContext * sws_ctx;
     AVFrame * frame;
     AVPacket pkt;
     int video_stream_idx;
-    int video_src_linesize[4];
     int video_dst_linesize[4];
     enum AVPixelFormat video_dst_pix_fmt;
     bool has_alpha;
+    bool frame_decoded;             /*A frame was written to `video_dst_data`*/
+    int64_t frame_pts;              /*Presentation time of the last decoded frame [ms]*/
+#if LV_FFMPEG_PLAYER_USE_THREADS
+    /*Shared by the decoder thread and the UI thread. Protected by `mutex`.*/
+    pthread_t thread;
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;            /*Broadcasted when a frame or the requests change*/
+    ffmpeg_frame_t frames[FRAME_BUF_CNT];
+    uint32_t frame_act;             /*Index of the shown frame*/
+    uint32_t frame_seq;
+    uint32_t seek_gen;              /*Incremented on seek to discard the frames decoded before*/
+    int64_t clock_ms;               /*Playback position, -1 if unknown [ms]*/
+    int frame_period;               /*[ms]*/
+    uint32_t drop_cnt;
+    bool seek_req;
+    bool eof;
+    bool quit;
+    bool thread_started;
+
+    /*Used only by the UI thread*/
+    uint32_t clock_start;           /*Tick when the frame with 0 presentation time should have been shown*/
+    bool clock_sync;                /*Start the clock from the next shown frame*/
+#endif
 };
 
 #pragma pack(1)
@@ -85,6 +130,16 @@ static int ffmpeg_update_next_frame(struct ffmpeg_context_s * ffmpeg_ctx);
 static int ffmpeg_output_video_frame(struct ffmpeg_context_s * ffmpeg_ctx);
 static bool ffmpeg_pix_fmt_has_alpha(enum AVPixelFormat pix_fmt);
 static bool ffmpeg_pix_fmt_is_yuv(enum AVPixelFormat pix_fmt);
+static int64_t ffmpeg_get_frame_pts(struct ffmpeg_context_s * ffmpeg_ctx, AVFrame * frame);
+#if LV_FFMPEG_PLAYER_USE_THREADS
+static bool ffmpeg_thread_start(struct ffmpeg_context_s * ffmpeg_ctx);
+static void ffmpeg_thread_stop(struct ffmpeg_context_s * ffmpeg_ctx);
+static void * ffmpeg_decode_thread(void * arg);
+static void ffmpeg_thread_seek_start(struct ffmpeg_context_s * ffmpeg_ctx);
+static bool ffmpeg_frame_is_late(struct ffmpeg_context_s * ffmpeg_ctx);
+static ffmpeg_frame_t * ffmpeg_get_queued_frame(struct ffmpeg_context_s * ffmpeg_ctx, ffmpeg_frame_t * skip);
+static void lv_ffmpeg_player_show_next_frame(lv_obj_t * obj);
+#endif
 
 static void lv_ffmpeg_player_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
 static void lv_ffmpeg_player_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
@@ -202,6 +257,17 @@ lv_res_t lv_ffmpeg_player_set_src(lv_obj_t * obj, const char * path)
         LV_LOG_WARN("unable to get frame refresh period");
     }
 
+#if LV_FFMPEG_PLAYER_USE_THREADS
+    player->ffmpeg_ctx->frame_period = period > 0 ? period : FRAME_DEF_REFR_PERIOD;
+    if(ffmpeg_thread_start(player->ffmpeg_ctx)) {
+        /*The frames are shown when they are due so check them more often*/
+        lv_timer_set_period(player->timer, LV_MAX(player->ffmpeg_ctx->frame_period / 2, 1));
+    }
+    else {
+        LV_LOG_WARN("couldn't start the decoder thread, decode in the timer");
+    }
+#endif
+
     res = LV_RES_OK;
 
 failed:
@@ -220,16 +286,33 @@ void lv_ffmpeg_player_set_cmd(lv_obj_t * obj, lv_ffmpeg_player_cmd_t cmd)
 
     lv_timer_t * timer = player->timer;
 
+#if LV_FFMPEG_PLAYER_USE_THREADS
+    /*The decoder thread owns the demuxer so it has to seek*/
+    if(player->ffmpeg_ctx->thread_started) {
+        if(cmd == LV_FFMPEG_PLAYER_CMD_START || cmd == LV_FFMPEG_PLAYER_CMD_STOP) {
+            ffmpeg_thread_seek_start(player->ffmpeg_ctx);
+        }
+        /*Continue the clock from the next shown frame*/
+        player->ffmpeg_ctx->clock_sync = true;
+    }
+#endif
+
     switch(cmd) {
         case LV_FFMPEG_PLAYER_CMD_START:
-            av_seek_frame(player->ffmpeg_ctx->fmt_ctx,
-                          0, 0, AVSEEK_FLAG_BACKWARD);
+#if LV_FFMPEG_PLAYER_USE_THREADS
+            if(!player->ffmpeg_ctx->thread_started)
+#endif
+                av_seek_frame(player->ffmpeg_ctx->fmt_ctx,
+                              0, 0, AVSEEK_FLAG_BACKWARD);
             lv_timer_resume(timer);
             LV_LOG_INFO("ffmpeg player start");
             break;
         case LV_FFMPEG_PLAYER_CMD_STOP:
-            av_seek_frame(player->ffmpeg_ctx->fmt_ctx,
-                          0, 0, AVSEEK_FLAG_BACKWARD);
+#if LV_FFMPEG_PLAYER_USE_THREADS
+            if(!player->ffmpeg_ctx->thread_started)
+#endif
+                av_seek_frame(player->ffmpeg_ctx->fmt_ctx,
+                              0, 0, AVSEEK_FLAG_BACKWARD);
             lv_timer_pause(timer);
             LV_LOG_INFO("ffmpeg player stop");
             break;
@@ -413,12 +496,20 @@ static int ffmpeg_output_video_frame(struct ffmpeg_context_s * ffmpeg_ctx)
 
     LV_LOG_TRACE("video_frame coded_n:%d", frame->coded_picture_number);
 
-    /* copy decoded frame to destination buffer:
-     * this is required since rawvideo expects non aligned data
-     */
-    av_image_copy(ffmpeg_ctx->video_src_data, ffmpeg_ctx->video_src_linesize,
-                  (const uint8_t **)(frame->data), frame->linesize,
-                  ffmpeg_ctx->video_dec_ctx->pix_fmt, width, height);
+    /*Continue from the previous frame's time if the frame has no timestamp*/
+    int64_t pts = ffmpeg_get_frame_pts(ffmpeg_ctx, frame);
+    if(pts < 0) {
+        int period = ffmpeg_get_frame_refr_period(ffmpeg_ctx);
+        pts = ffmpeg_ctx->frame_pts + (period > 0 ? period : FRAME_DEF_REFR_PERIOD);
+    }
+    ffmpeg_ctx->frame_pts = pts;
+
+#if LV_FFMPEG_PLAYER_USE_THREADS
+    /*Don't convert the frame if it would be dropped anyway*/
+    if(ffmpeg_ctx->thread_started && ffmpeg_frame_is_late(ffmpeg_ctx)) {
+        return 0;
+    }
+#endif
 
     if(ffmpeg_ctx->sws_ctx == NULL) {
         int swsFlags = SWS_BILINEAR;
@@ -459,15 +550,18 @@ static int ffmpeg_output_video_frame(struct ffmpeg_context_s * ffmpeg_ctx)
         }
     }
 
+    /*Convert directly from the decoder's planes to the image buffer*/
     ret = sws_scale(
               ffmpeg_ctx->sws_ctx,
-              (const uint8_t * const *)(ffmpeg_ctx->video_src_data),
-              ffmpeg_ctx->video_src_linesize,
+              (const uint8_t * const *)(frame->data),
+              frame->linesize,
               0,
               height,
               ffmpeg_ctx->video_dst_data,
               ffmpeg_ctx->video_dst_linesize);
 
+    if(ret >= 0) ffmpeg_ctx->frame_decoded = true;
+
 failed:
     return ret;
 }
@@ -628,6 +722,27 @@ static int ffmpeg_get_frame_refr_period(struct ffmpeg_context_s * ffmpeg_ctx)
     return -1;
 }
 
+/**
+ * Get the presentation time of a decoded frame relative to the start of the stream
+ * @param ffmpeg_ctx    pointer to an ffmpeg context
+ * @param frame         pointer to a decoded frame
+ * @return              the presentation time [ms] or -1 if unknown
+ */
+static int64_t ffmpeg_get_frame_pts(struct ffmpeg_context_s * ffmpeg_ctx, AVFrame * frame)
+{
+    int64_t ts = frame->best_effort_timestamp;
+    if(ts == AV_NOPTS_VALUE) ts = frame->pts;
+    if(ts == AV_NOPTS_VALUE) return -1;
+
+    if(ffmpeg_ctx->video_stream->start_time != AV_NOPTS_VALUE) {
+        ts -= ffmpeg_ctx->video_stream->start_time;
+    }
+
+    AVRational ms_base = {1, 1000};
+    ts = av_rescale_q(ts, ffmpeg_ctx->video_stream->time_base, ms_base);
+    return ts >= 0 ? ts : 0;
+}
+
 static int ffmpeg_update_next_frame(struct ffmpeg_context_s * ffmpeg_ctx)
 {
     int ret = 0;
@@ -729,22 +844,8 @@ static int ffmpeg_image_allocate(struct ffmpeg_context_s * ffmpeg_ctx)
 {
     int ret;
 
-    /* allocate image where the decoded image will be put */
-    ret = av_image_alloc(
-              ffmpeg_ctx->video_src_data,
-              ffmpeg_ctx->video_src_linesize,
-              ffmpeg_ctx->video_dec_ctx->width,
-              ffmpeg_ctx->video_dec_ctx->height,
-              ffmpeg_ctx->video_dec_ctx->pix_fmt,
-              4);
-
-    if(ret < 0) {
-        LV_LOG_ERROR("Could not allocate src raw video buffer");
-        return ret;
-    }
-
-    LV_LOG_INFO("alloc video_src_bufsize = %d", ret);
-
+    /* The decoded frames are converted directly from the decoder's planes
+     * so only the destination image has to be allocated */
     ret = av_image_alloc(
               ffmpeg_ctx->video_dst_data,
               ffmpeg_ctx->video_dst_linesize,
@@ -780,10 +881,6 @@ static void ffmpeg_close_src_ctx(struct ffmpeg_context_s * ffmpeg_ctx)
     avcodec_free_context(&(ffmpeg_ctx->video_dec_ctx));
     avformat_close_input(&(ffmpeg_ctx->fmt_ctx));
     av_frame_free(&(ffmpeg_ctx->frame));
-    if(ffmpeg_ctx->video_src_data[0] != NULL) {
-        av_free(ffmpeg_ctx->video_src_data[0]);
-        ffmpeg_ctx->video_src_data[0] = NULL;
-    }
 }
 
 static void ffmpeg_close_dst_ctx(struct ffmpeg_context_s * ffmpeg_ctx)
@@ -801,6 +898,10 @@ static void ffmpeg_close(struct ffmpeg_context_s * ffmpeg_ctx)
         return;
     }
 
+#if LV_FFMPEG_PLAYER_USE_THREADS
+    ffmpeg_thread_stop(ffmpeg_ctx);
+#endif
+
     sws_freeContext(ffmpeg_ctx->sws_ctx);
     ffmpeg_close_src_ctx(ffmpeg_ctx);
     ffmpeg_close_dst_ctx(ffmpeg_ctx);
@@ -818,6 +919,13 @@ static void lv_ffmpeg_player_frame_update_cb(lv_timer_t * timer)
         return;
     }
 
+#if LV_FFMPEG_PLAYER_USE_THREADS
+    if(player->ffmpeg_ctx->thread_started) {
+        lv_ffmpeg_player_show_next_frame(obj);
+        return;
+    }
+#endif
+
     int has_next = ffmpeg_update_next_frame(player->ffmpeg_ctx);
 
     if(has_next < 0) {
@@ -872,4 +980,280 @@ static void lv_ffmpeg_player_destructor(const lv_obj_class_t * class_p,
     LV_TRACE_OBJ_CREATE("finished");
 }
 
+#if LV_FFMPEG_PLAYER_USE_THREADS
+
+/**
+ * Allocate the frame buffers and start the decoder thread.
+ * The first frame buffer is the image allocated by `ffmpeg_image_allocate()`.
+ * @param ffmpeg_ctx    pointer to an ffmpeg context
+ * @return              true: the thread is running
+ */
+static bool ffmpeg_thread_start(struct ffmpeg_context_s * ffmpeg_ctx)
+{
+    int width = ffmpeg_ctx->video_dec_ctx->width;
+    int height = ffmpeg_ctx->video_dec_ctx->height;
+    int linesize[4];
+    uint32_t i;
+
+    lv_memcpy(ffmpeg_ctx->frames[0].data, ffmpeg_ctx->video_dst_data, sizeof(ffmpeg_ctx->frames[0].data));
+    ffmpeg_ctx->frames[0].state = FFMPEG_FRAME_SHOWN;
+    for(i = 1; i < FRAME_BUF_CNT; i++) {
+        if(av_image_alloc(ffmpeg_ctx->frames[i].data, linesize, width, height,
+                          ffmpeg_ctx->video_dst_pix_fmt, 4) < 0) {
+            LV_LOG_ERROR("Could not allocate frame buffer %d", (int)i);
+            while(i > 1) {
+                i--;
+                av_free(ffmpeg_ctx->frames[i].data[0]);
+                ffmpeg_ctx->frames[i].data[0] = NULL;
+            }
+            return false;
+        }
+        ffmpeg_ctx->frames[i].state = FFMPEG_FRAME_FREE;
+    }
+
+    ffmpeg_ctx->frame_act = 0;
+    ffmpeg_ctx->frame_seq = 0;
+    ffmpeg_ctx->seek_gen = 0;
+    ffmpeg_ctx->clock_ms = -1;
+    ffmpeg_ctx->drop_cnt = 0;
+    ffmpeg_ctx->seek_req = false;
+    ffmpeg_ctx->eof = false;
+    ffmpeg_ctx->quit = false;
+    ffmpeg_ctx->clock_sync = true;
+
+    pthread_mutex_init(&ffmpeg_ctx->mutex, NULL);
+    pthread_cond_init(&ffmpeg_ctx->cond, NULL);
+    if(pthread_create(&ffmpeg_ctx->thread, NULL, ffmpeg_decode_thread, ffmpeg_ctx) != 0) {
+        pthread_cond_destroy(&ffmpeg_ctx->cond);
+        pthread_mutex_destroy(&ffmpeg_ctx->mutex);
+        for(i = 1; i < FRAME_BUF_CNT; i++) {
+            av_free(ffmpeg_ctx->frames[i].data[0]);
+            ffmpeg_ctx->frames[i].data[0] = NULL;
+        }
+        return false;
+    }
+
+    ffmpeg_ctx->thread_started = true;
+    return true;
+}
+
+/**
+ * Stop the decoder thread and free the frame buffers except the first one
+ * @param ffmpeg_ctx    pointer to an ffmpeg context
+ */
+static void ffmpeg_thread_stop(struct ffmpeg_context_s * ffmpeg_ctx)
+{
+    if(!ffmpeg_ctx->thread_started) return;
+
+    pthread_mutex_lock(&ffmpeg_ctx->mutex);
+    ffmpeg_ctx->quit = true;
+    pthread_cond_broadcast(&ffmpeg_ctx->cond);
+    pthread_mutex_unlock(&ffmpeg_ctx->mutex);
+    pthread_join(ffmpeg_ctx->thread, NULL);
+
+    pthread_cond_destroy(&ffmpeg_ctx->cond);
+    pthread_mutex_destroy(&ffmpeg_ctx->mutex);
+    ffmpeg_ctx->thread_started = false;
+
+    LV_LOG_INFO("%d late frames were dropped", (int)ffmpeg_ctx->drop_cnt);
+
+    /*The first buffer is freed with the destination image*/
+    lv_memcpy(ffmpeg_ctx->video_dst_data, ffmpeg_ctx->frames[0].data, sizeof(ffmpeg_ctx->video_dst_data));
+    uint32_t i;
+    for(i = 1; i < FRAME_BUF_CNT; i++) {
+        av_free(ffmpeg_ctx->frames[i].data[0]);
+        ffmpeg_ctx->frames[i].data[0] = NULL;
+    }
+}
+
+/**
+ * Decode the frames into the free frame buffers until the queue is full.
+ * The thread owns the demuxer and the decoder while it's running.
+ */
+static void * ffmpeg_decode_thread(void * arg)
+{
+    struct ffmpeg_context_s * ffmpeg_ctx = arg;
+    uint32_t i;
+
+    pthread_mutex_lock(&ffmpeg_ctx->mutex);
+    while(!ffmpeg_ctx->quit) {
+        if(ffmpeg_ctx->seek_req) {
+            ffmpeg_ctx->seek_req = false;
+            ffmpeg_ctx->eof = false;
+            pthread_mutex_unlock(&ffmpeg_ctx->mutex);
+            av_seek_frame(ffmpeg_ctx->fmt_ctx, 0, 0, AVSEEK_FLAG_BACKWARD);
+            avcodec_flush_buffers(ffmpeg_ctx->video_dec_ctx);
+            pthread_mutex_lock(&ffmpeg_ctx->mutex);
+            continue;
+        }
+
+        ffmpeg_frame_t * frame = NULL;
+        if(!ffmpeg_ctx->eof) {
+            for(i = 0; i < FRAME_BUF_CNT; i++) {
+                if(ffmpeg_ctx->frames[i].state == FFMPEG_FRAME_FREE) {
+                    frame = &ffmpeg_ctx->frames[i];
+                    break;
+                }
+            }
+        }
+
+        /*Wait until a frame is shown or a seek is requested*/
+        if(frame == NULL) {
+            pthread_cond_wait(&ffmpeg_ctx->cond, &ffmpeg_ctx->mutex);
+            continue;
+        }
+
+        frame->state = FFMPEG_FRAME_DECODING;
+        uint32_t seek_gen = ffmpeg_ctx->seek_gen;
+        pthread_mutex_unlock(&ffmpeg_ctx->mutex);
+
+        /*Convert directly into the frame buffer*/
+        lv_memcpy(ffmpeg_ctx->video_dst_data, frame->data, sizeof(ffmpeg_ctx->video_dst_data));
+        ffmpeg_ctx->frame_decoded = false;
+        int ret = ffmpeg_update_next_frame(ffmpeg_ctx);
+
+#if LV_COLOR_DEPTH != 32
+        if(ret >= 0 && ffmpeg_ctx->frame_decoded && ffmpeg_ctx->has_alpha) {
+            convert_color_depth(frame->data[0], ffmpeg_ctx->video_dec_ctx->width * ffmpeg_ctx->video_dec_ctx->height);
+        }
+#endif
+
+        pthread_mutex_lock(&ffmpeg_ctx->mutex);
+        if(seek_gen != ffmpeg_ctx->seek_gen) {
+            /*Decoded before the seek*/
+            frame->state = FFMPEG_FRAME_FREE;
+        }
+        else if(ret < 0) {
+            frame->state = FFMPEG_FRAME_FREE;
+            ffmpeg_ctx->eof = true;
+        }
+        else if(ffmpeg_ctx->frame_decoded) {
+            frame->pts = ffmpeg_ctx->frame_pts;
+            frame->seq = ffmpeg_ctx->frame_seq++;
+            frame->state = FFMPEG_FRAME_QUEUED;
+        }
+        else {
+            /*No new frame or it was late*/
+            frame->state = FFMPEG_FRAME_FREE;
+        }
+        pthread_cond_broadcast(&ffmpeg_ctx->cond);
+    }
+    pthread_mutex_unlock(&ffmpeg_ctx->mutex);
+
+    return NULL;
+}
+
+/**
+ * Drop the decoded frames and ask the decoder thread to seek to the beginning
+ * @param ffmpeg_ctx    pointer to an ffmpeg context
+ */
+static void ffmpeg_thread_seek_start(struct ffmpeg_context_s * ffmpeg_ctx)
+{
+    pthread_mutex_lock(&ffmpeg_ctx->mutex);
+    ffmpeg_ctx->seek_req = true;
+    ffmpeg_ctx->seek_gen++;
+    ffmpeg_ctx->eof = false;
+    ffmpeg_ctx->clock_ms = -1;
+
+    uint32_t i;
+    for(i = 0; i < FRAME_BUF_CNT; i++) {
+        if(ffmpeg_ctx->frames[i].state == FFMPEG_FRAME_QUEUED) {
+            ffmpeg_ctx->frames[i].state = FFMPEG_FRAME_FREE;
+        }
+    }
+    pthread_cond_broadcast(&ffmpeg_ctx->cond);
+    pthread_mutex_unlock(&ffmpeg_ctx->mutex);
+}
+
+/**
+ * Check in the decoder thread whether the last decoded frame is already too late to show
+ * @param ffmpeg_ctx    pointer to an ffmpeg context
+ * @return              true: the frame should be dropped
+ */
+static bool ffmpeg_frame_is_late(struct ffmpeg_context_s * ffmpeg_ctx)
+{
+    pthread_mutex_lock(&ffmpeg_ctx->mutex);
+    bool late = ffmpeg_ctx->clock_ms >= 0 &&
+                ffmpeg_ctx->frame_pts + ffmpeg_ctx->frame_period < ffmpeg_ctx->clock_ms;
+    if(late) ffmpeg_ctx->drop_cnt++;
+    pthread_mutex_unlock(&ffmpeg_ctx->mutex);
+
+    return late;
+}
+
+/**
+ * Get the oldest decoded frame
+ * @param ffmpeg_ctx    pointer to an ffmpeg context
+ * @param skip          don't return this frame
+ * @return              pointer to a frame or NULL if there is no decoded frame
+ */
+static ffmpeg_frame_t * ffmpeg_get_queued_frame(struct ffmpeg_context_s * ffmpeg_ctx, ffmpeg_frame_t * skip)
+{
+    ffmpeg_frame_t * oldest = NULL;
+    uint32_t i;
+    for(i = 0; i < FRAME_BUF_CNT; i++) {
+        ffmpeg_frame_t * frame = &ffmpeg_ctx->frames[i];
+        if(frame == skip || frame->state != FFMPEG_FRAME_QUEUED) continue;
+        if(oldest == NULL || (int32_t)(frame->seq - oldest->seq) < 0) oldest = frame;
+    }
+
+    return oldest;
+}
+
+/**
+ * Show the decoded frame which is due according to its presentation time.
+ * Frames which are already late are dropped.
+ * @param obj   pointer to a ffmpeg_player object
+ */
+static void lv_ffmpeg_player_show_next_frame(lv_obj_t * obj)
+{
+    lv_ffmpeg_player_t * player = (lv_ffmpeg_player_t *)obj;
+    struct ffmpeg_context_s * ffmpeg_ctx = player->ffmpeg_ctx;
+
+    pthread_mutex_lock(&ffmpeg_ctx->mutex);
+
+    ffmpeg_frame_t * next = ffmpeg_get_queued_frame(ffmpeg_ctx, NULL);
+    if(next == NULL) {
+        bool eof = ffmpeg_ctx->eof;
+        pthread_mutex_unlock(&ffmpeg_ctx->mutex);
+        if(eof) {
+            lv_ffmpeg_player_set_cmd(obj, player->auto_restart ? LV_FFMPEG_PLAYER_CMD_START : LV_FFMPEG_PLAYER_CMD_STOP);
+        }
+        return;
+    }
+
+    if(ffmpeg_ctx->clock_sync) {
+        ffmpeg_ctx->clock_start = lv_tick_get() - (uint32_t)next->pts;
+        ffmpeg_ctx->clock_sync = false;
+    }
+    ffmpeg_ctx->clock_ms = lv_tick_elaps(ffmpeg_ctx->clock_start);
+
+    if(next->pts > ffmpeg_ctx->clock_ms) {
+        pthread_mutex_unlock(&ffmpeg_ctx->mutex);
+        return;
+    }
+
+    /*Skip the frames which are due but a newer frame is due too*/
+    while(1) {
+        ffmpeg_frame_t * newer = ffmpeg_get_queued_frame(ffmpeg_ctx, next);
+        if(newer == NULL || newer->pts > ffmpeg_ctx->clock_ms) break;
+        next->state = FFMPEG_FRAME_FREE;
+        ffmpeg_ctx->drop_cnt++;
+        next = newer;
+    }
+
+    ffmpeg_ctx->frames[ffmpeg_ctx->frame_act].state = FFMPEG_FRAME_FREE;
+    next->state = FFMPEG_FRAME_SHOWN;
+    ffmpeg_ctx->frame_act = next - ffmpeg_ctx->frames;
+    pthread_cond_broadcast(&ffmpeg_ctx->cond);
+    pthread_mutex_unlock(&ffmpeg_ctx->mutex);
+
+    /*The shown buffer is not written by the decoder thread*/
+    player->imgdsc.data = next->data[0];
+    lv_img_cache_invalidate_src(lv_img_get_src(obj));
+    lv_obj_invalidate(obj);
+}
+
+#endif /*LV_FFMPEG_PLAYER_USE_THREADS*/
+
 #endif /*LV_USE_FFMPEG*/
@@ -161,6 +161,7 @@ static gd_GIF * gif_open(gd_GIF * gif_base)
     }
     gif->anim_start = f_gif_seek(gif, 0, LV_FS_SEEK_CUR);
     gif->loop_count = -1;
+    gif->frame_index = -1;
     goto ok;
 fail:
     f_gif_close(gif_base);
@@ -580,6 +581,7 @@ gd_get_frame(gd_GIF *gif)
     while (sep != ',') {
         if (sep == ';') {
             f_gif_seek(gif, gif->anim_start, LV_FS_SEEK_SET);
+            gif->frame_index = -1;
             if(gif->loop_count == 1 || gif->loop_count < 0) {
                 return 0;
             }
@@ -594,6 +596,7 @@ gd_get_frame(gd_GIF *gif)
     }
     if (read_image(gif) == -1)
         return -1;
+    gif->frame_index++;
     return 1;
 }
 
@@ -616,6 +619,7 @@ void
 gd_rewind(gd_GIF *gif)
 {
     gif->loop_count = -1;
+    gif->frame_index = -1;
     f_gif_seek(gif, gif->anim_start, LV_FS_SEEK_SET);
 }
 
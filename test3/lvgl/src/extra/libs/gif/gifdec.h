@@ -30,6 +30,7 @@ typedef struct gd_GIF {
     uint16_t width, height;
     uint16_t depth;
     int32_t loop_count;
+    int32_t frame_index; /* Index of the last read frame in the current loop, -1 if none */
     gd_GCE gce;
     gd_Palette *palette;
     gd_Palette lct, gct;
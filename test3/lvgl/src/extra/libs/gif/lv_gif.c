@@ -10,6 +10,7 @@
 #if LV_USE_GIF
 
 #include "gifdec.h"
+#include <string.h>
 
 /*********************
  *      DEFINES
@@ -27,6 +28,13 @@
 static void lv_gif_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
 static void lv_gif_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
 static void next_frame_task_cb(lv_timer_t * t);
+static void get_frame_area(gd_GIF * gif, lv_area_t * area);
+static void invalidate_frame_area(lv_obj_t * obj, const lv_area_t * area);
+#if LV_GIF_CACHE_SIZE
+static bool cache_next_frame(lv_obj_t * obj);
+static void cache_add_frame(lv_gif_t * gifobj, const lv_area_t * area);
+static void cache_free(lv_gif_t * gifobj);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -62,6 +70,9 @@ void lv_gif_set_src(lv_obj_t * obj, const void * src)
     /*Close previous gif if any*/
     if(gifobj->gif) {
         lv_img_cache_invalidate_src(&gifobj->imgdsc);
+#if LV_GIF_CACHE_SIZE
+        cache_free(gifobj);
+#endif
         gd_close_gif(gifobj->gif);
         gifobj->gif = NULL;
         gifobj->imgdsc.data = NULL;
@@ -98,6 +109,14 @@ void lv_gif_set_src(lv_obj_t * obj, const void * src)
 void lv_gif_restart(lv_obj_t * obj)
 {
     lv_gif_t * gifobj = (lv_gif_t *) obj;
+#if LV_GIF_CACHE_SIZE
+    /*Decode again as the state of the loops is kept by the decoder*/
+    if(gifobj->cache_state == LV_GIF_CACHE_READY) {
+        lv_img_cache_invalidate_src(&gifobj->imgdsc);
+        lv_obj_invalidate(obj);
+    }
+    cache_free(gifobj);
+#endif
     gd_rewind(gifobj->gif);
     lv_timer_resume(gifobj->timer);
     lv_timer_reset(gifobj->timer);
@@ -114,6 +133,13 @@ static void lv_gif_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     lv_gif_t * gifobj = (lv_gif_t *) obj;
 
     gifobj->gif = NULL;
+#if LV_GIF_CACHE_SIZE
+    gifobj->frames = NULL;
+    gifobj->frame_cnt = 0;
+    gifobj->frame_act = 0;
+    gifobj->cache_size = 0;
+    gifobj->cache_state = LV_GIF_CACHE_IDLE;
+#endif
     gifobj->timer = lv_timer_create(next_frame_task_cb, 10, obj);
     lv_timer_pause(gifobj->timer);
 }
@@ -123,6 +149,9 @@ static void lv_gif_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     LV_UNUSED(class_p);
     lv_gif_t * gifobj = (lv_gif_t *) obj;
     lv_img_cache_invalidate_src(&gifobj->imgdsc);
+#if LV_GIF_CACHE_SIZE
+    cache_free(gifobj);
+#endif
     if(gifobj->gif)
         gd_close_gif(gifobj->gif);
     lv_timer_del(gifobj->timer);
@@ -133,10 +162,25 @@ static void next_frame_task_cb(lv_timer_t * t)
     lv_obj_t * obj = t->user_data;
     lv_gif_t * gifobj = (lv_gif_t *) obj;
     uint32_t elaps = lv_tick_elaps(gifobj->last_call);
+
+#if LV_GIF_CACHE_SIZE
+    if(gifobj->cache_state == LV_GIF_CACHE_READY) {
+        if(elaps < gifobj->frames[gifobj->frame_act].delay * 10) return;
+        gifobj->last_call = lv_tick_get();
+        cache_next_frame(obj);
+        return;
+    }
+#endif
+
     if(elaps < gifobj->gif->gce.delay * 10) return;
 
     gifobj->last_call = lv_tick_get();
 
+    /*The disposal of the previous frame and the new frame change the canvas only in their rectangles*/
+    lv_area_t prev_area;
+    get_frame_area(gifobj->gif, &prev_area);
+    int32_t prev_index = gifobj->gif->frame_index;
+
     int has_next = gd_get_frame(gifobj->gif);
     if(has_next == 0) {
         /*It was the last repeat*/
@@ -147,8 +191,175 @@ static void next_frame_task_cb(lv_timer_t * t)
 
     gd_render_frame(gifobj->gif, (uint8_t *)gifobj->imgdsc.data);
 
+    lv_area_t area;
+    get_frame_area(gifobj->gif, &area);
+    if(lv_area_get_width(&prev_area) > 0) _lv_area_join(&area, &area, &prev_area);
+
+#if LV_GIF_CACHE_SIZE
+    bool wrapped = has_next > 0 && prev_index >= 0 && gifobj->gif->frame_index <= prev_index;
+    if(wrapped && gifobj->cache_state == LV_GIF_CACHE_IDLE) {
+        /*The first loop starts from an empty canvas. Record the second one which is repeated later.*/
+        gifobj->cache_state = LV_GIF_CACHE_RECORDING;
+    }
+    else if(wrapped && gifobj->cache_state == LV_GIF_CACHE_RECORDING) {
+        /*Replay only if the canvas is really the same as at the beginning of the recorded loop*/
+        uint32_t frame_size = gifobj->imgdsc.header.w * gifobj->imgdsc.header.h * LV_IMG_PX_SIZE_ALPHA_BYTE;
+        if(gifobj->frame_cnt > 0 && memcmp(gifobj->frames[0].data, gifobj->gif->canvas, frame_size) == 0) {
+            gifobj->cache_state = LV_GIF_CACHE_READY;
+            gifobj->frame_act = 0;
+            gifobj->loop_count = gifobj->gif->loop_count;
+            gifobj->imgdsc.data = gifobj->frames[0].data;
+            LV_LOG_INFO("%d frames cached (%d bytes)", (int)gifobj->frame_cnt, (int)gifobj->cache_size);
+        }
+        else {
+            cache_free(gifobj);
+            gifobj->cache_state = LV_GIF_CACHE_FAILED;
+        }
+    }
+
+    if(gifobj->cache_state == LV_GIF_CACHE_RECORDING) cache_add_frame(gifobj, &area);
+#else
+    LV_UNUSED(prev_index);
+#endif
+
+    lv_img_cache_invalidate_src(lv_img_get_src(obj));
+    invalidate_frame_area(obj, &area);
+}
+
+/**
+ * Get the rectangle of the current frame on the canvas
+ * @param gif       pointer to a GIF decoder
+ * @param area      store the area here. Its width is 0 if there is no frame yet.
+ */
+static void get_frame_area(gd_GIF * gif, lv_area_t * area)
+{
+    area->x1 = gif->fx;
+    area->y1 = gif->fy;
+    area->x2 = gif->fx + gif->fw - 1;
+    area->y2 = gif->fy + gif->fh - 1;
+}
+
+/**
+ * Invalidate the part of the object where the changed area of the canvas is drawn
+ * @param obj       pointer to a GIF object
+ * @param area      the changed area relative to the canvas
+ */
+static void invalidate_frame_area(lv_obj_t * obj, const lv_area_t * area)
+{
+    lv_gif_t * gifobj = (lv_gif_t *) obj;
+
+    /*If the image is transformed or tiled it's not trivial to find where the area is drawn*/
+    if(lv_img_get_zoom(obj) != LV_IMG_ZOOM_NONE || lv_img_get_angle(obj) != 0 ||
+       lv_img_get_offset_x(obj) != 0 || lv_img_get_offset_y(obj) != 0 ||
+       lv_obj_get_content_width(obj) != gifobj->imgdsc.header.w ||
+       lv_obj_get_content_height(obj) != gifobj->imgdsc.header.h ||
+       lv_area_get_width(area) <= 0 || lv_area_get_height(area) <= 0) {
+        lv_obj_invalidate(obj);
+        return;
+    }
+
+    lv_coord_t x_ofs = obj->coords.x1 + lv_obj_get_style_pad_left(obj, LV_PART_MAIN) +
+                       lv_obj_get_style_border_width(obj, LV_PART_MAIN);
+    lv_coord_t y_ofs = obj->coords.y1 + lv_obj_get_style_pad_top(obj, LV_PART_MAIN) +
+                       lv_obj_get_style_border_width(obj, LV_PART_MAIN);
+
+    lv_area_t inv_area;
+    lv_area_copy(&inv_area, area);
+    lv_area_move(&inv_area, x_ofs, y_ofs);
+    lv_obj_invalidate_area(obj, &inv_area);
+}
+
+#if LV_GIF_CACHE_SIZE
+
+/**
+ * Show the next frame from the frame cache
+ * @param obj       pointer to a GIF object
+ * @return          true: a new frame is shown; false: the animation has ended
+ */
+static bool cache_next_frame(lv_obj_t * obj)
+{
+    lv_gif_t * gifobj = (lv_gif_t *) obj;
+
+    uint32_t next = gifobj->frame_act + 1;
+    if(next >= gifobj->frame_cnt) {
+        /*Apply the same loop rules as the decoder*/
+        if(gifobj->loop_count == 1 || gifobj->loop_count < 0) {
+            lv_timer_pause(gifobj->timer);
+            lv_event_send(obj, LV_EVENT_READY, NULL);
+            return false;
+        }
+        else if(gifobj->loop_count > 1) {
+            gifobj->loop_count--;
+        }
+        next = 0;
+    }
+
+    gifobj->frame_act = next;
+    gifobj->imgdsc.data = gifobj->frames[next].data;
+
     lv_img_cache_invalidate_src(lv_img_get_src(obj));
-    lv_obj_invalidate(obj);
+    invalidate_frame_area(obj, &gifobj->frames[next].area);
+    return true;
+}
+
+/**
+ * Save the current canvas as the next frame of the cache.
+ * Drop the whole cache if it doesn't fit into `LV_GIF_CACHE_SIZE`.
+ * @param gifobj    pointer to a GIF object
+ * @param area      the area changed compared to the previous frame
+ */
+static void cache_add_frame(lv_gif_t * gifobj, const lv_area_t * area)
+{
+    uint32_t frame_size = gifobj->imgdsc.header.w * gifobj->imgdsc.header.h * LV_IMG_PX_SIZE_ALPHA_BYTE;
+    if(gifobj->cache_size + frame_size > LV_GIF_CACHE_SIZE) {
+        LV_LOG_INFO("the frames don't fit into LV_GIF_CACHE_SIZE");
+        cache_free(gifobj);
+        gifobj->cache_state = LV_GIF_CACHE_FAILED;
+        return;
+    }
+
+    lv_gif_frame_t * frames = lv_mem_realloc(gifobj->frames, (gifobj->frame_cnt + 1) * sizeof(lv_gif_frame_t));
+    uint8_t * data = frames ? lv_mem_alloc(frame_size) : NULL;
+    if(data == NULL) {
+        LV_LOG_WARN("couldn't allocate memory for the frame cache");
+        if(frames) gifobj->frames = frames;
+        cache_free(gifobj);
+        gifobj->cache_state = LV_GIF_CACHE_FAILED;
+        return;
+    }
+
+    gifobj->frames = frames;
+    lv_gif_frame_t * f = &frames[gifobj->frame_cnt];
+    lv_memcpy(data, gifobj->gif->canvas, frame_size);
+    f->data = data;
+    lv_area_copy(&f->area, area);
+    f->delay = gifobj->gif->gce.delay;
+    gifobj->frame_cnt++;
+    gifobj->cache_size += frame_size;
 }
 
+/**
+ * Free the cached frames and go back to decoding
+ * @param gifobj    pointer to a GIF object
+ */
+static void cache_free(lv_gif_t * gifobj)
+{
+    if(gifobj->cache_state == LV_GIF_CACHE_READY && gifobj->gif) {
+        gifobj->imgdsc.data = gifobj->gif->canvas;
+    }
+
+    uint32_t i;
+    for(i = 0; i < gifobj->frame_cnt; i++) {
+        lv_mem_free(gifobj->frames[i].data);
+    }
+    lv_mem_free(gifobj->frames);
+    gifobj->frames = NULL;
+    gifobj->frame_cnt = 0;
+    gifobj->frame_act = 0;
+    gifobj->cache_size = 0;
+    gifobj->cache_state = LV_GIF_CACHE_IDLE;
+}
+
+#endif /*LV_GIF_CACHE_SIZE*/
+
 #endif /*LV_USE_GIF*/
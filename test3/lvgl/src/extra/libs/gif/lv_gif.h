@@ -27,12 +27,37 @@ extern "C" {
  *      TYPEDEFS
  **********************/
 
+#if LV_GIF_CACHE_SIZE
+/*A fully composed frame kept to replay looping animations without decoding*/
+typedef struct {
+    uint8_t * data;         /*Pixels in `LV_IMG_CF_TRUE_COLOR_ALPHA` format*/
+    lv_area_t area;         /*Area changed compared to the previous frame*/
+    uint16_t delay;         /*Time to show the frame [10 ms]*/
+} lv_gif_frame_t;
+
+enum {
+    LV_GIF_CACHE_IDLE,      /*Waiting for the first loop to finish*/
+    LV_GIF_CACHE_RECORDING, /*Saving the frames of the second loop*/
+    LV_GIF_CACHE_READY,     /*Playing from the cache*/
+    LV_GIF_CACHE_FAILED,    /*The frames don't fit into `LV_GIF_CACHE_SIZE`*/
+};
+typedef uint8_t lv_gif_cache_state_t;
+#endif
+
 typedef struct {
     lv_img_t img;
     gd_GIF * gif;
     lv_timer_t * timer;
     lv_img_dsc_t imgdsc;
     uint32_t last_call;
+#if LV_GIF_CACHE_SIZE
+    lv_gif_frame_t * frames;
+    uint32_t frame_cnt;
+    uint32_t frame_act;
+    uint32_t cache_size;
+    int32_t loop_count;
+    lv_gif_cache_state_t cache_state;
+#endif
 } lv_gif_t;
 
 extern const lv_obj_class_t lv_gif_class;
@@ -13,13 +13,46 @@
 #include "lodepng.h"
 #include <stdlib.h>
 
+#if defined(__ARM_NEON)
+    #include <arm_neon.h>
+#elif defined(__SSE2__)
+    #include <emmintrin.h>
+#endif
+
 /*********************
  *      DEFINES
  *********************/
+#define PNG_SIGNATURE_SIZE  8
+#define PNG_IHDR_SIZE       13
 
 /**********************
  *      TYPEDEFS
  **********************/
+#if LV_PNG_STREAM_DECODE
+/*Data of a PNG opened in streaming mode. The rows are unfiltered in place on demand.*/
+typedef struct {
+    uint8_t * scanlines;        /*Inflated rows, each prefixed by its filter type byte*/
+    uint8_t * rgba_line;        /*Row converted to RGBA8888 if the PNG is not RGBA8888 already*/
+    uint32_t w;
+    uint32_t h;
+    uint32_t row_size;          /*Bytes in a row without the filter type byte*/
+    uint32_t rows_ready;        /*Number of rows already unfiltered from the top*/
+    uint32_t stream_time;       /*Time spent with unfiltering the rows [ms]*/
+    uint8_t color_type;
+    uint8_t bit_depth;
+    uint8_t px_bytes;           /*Bytes per pixel (rounded up to 1) used by the filters*/
+    uint16_t palette_size;
+    uint8_t palette[256 * 4];   /*RGBA8888 palette entries*/
+} png_stream_t;
+
+/*Reads a PNG either from a file or from a C array*/
+typedef struct {
+    lv_fs_file_t * f;
+    const uint8_t * data;
+    uint32_t data_size;
+    uint32_t pos;
+} png_reader_t;
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
@@ -27,7 +60,17 @@
 static lv_res_t decoder_info(struct _lv_img_decoder_t * decoder, const void * src, lv_img_header_t * header);
 static lv_res_t decoder_open(lv_img_decoder_t * dec, lv_img_decoder_dsc_t * dsc);
 static void decoder_close(lv_img_decoder_t * dec, lv_img_decoder_dsc_t * dsc);
-static void convert_color_depth(uint8_t * img, uint32_t px_cnt);
+static void convert_color_depth(uint8_t * dst, const uint8_t * src, uint32_t px_cnt);
+#if LV_PNG_STREAM_DECODE
+static lv_res_t decoder_read_line(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc,
+                                  lv_coord_t x, lv_coord_t y, lv_coord_t len, uint8_t * buf);
+static lv_res_t stream_open(lv_img_decoder_dsc_t * dsc);
+static void stream_close(png_stream_t * stream);
+static bool reader_read(png_reader_t * reader, void * buf, uint32_t len);
+static bool reader_skip(png_reader_t * reader, uint32_t len);
+static bool stream_unfilter_rows(png_stream_t * stream, uint32_t y);
+static void stream_row_to_rgba(png_stream_t * stream, const uint8_t * row, uint32_t x, uint32_t len, uint8_t * rgba);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -49,6 +92,9 @@ void lv_png_init(void)
     lv_img_decoder_t * dec = lv_img_decoder_create();
     lv_img_decoder_set_info_cb(dec, decoder_info);
     lv_img_decoder_set_open_cb(dec, decoder_open);
+#if LV_PNG_STREAM_DECODE
+    lv_img_decoder_set_read_line_cb(dec, decoder_read_line);
+#endif
     lv_img_decoder_set_close_cb(dec, decoder_close);
 }
 
@@ -150,6 +196,14 @@ static lv_res_t decoder_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t *
     uint32_t error;                 /*For the return values of PNG decoder functions*/
 
     uint8_t * img_data = NULL;
+    uint32_t t_start = lv_tick_get();
+
+#if LV_PNG_STREAM_DECODE
+    /*Large images are decoded row by row in `decoder_read_line`*/
+    if((uint32_t)dsc->header.w * dsc->header.h >= LV_PNG_STREAM_MIN_PX) {
+        if(stream_open(dsc) == LV_RES_OK) return LV_RES_OK;
+    }
+#endif
 
     /*If it's a PNG file...*/
     if(dsc->src_type == LV_IMG_SRC_FILE) {
@@ -182,8 +236,9 @@ static lv_res_t decoder_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t *
             }
 
             /*Convert the image to the system's color depth*/
-            convert_color_depth(img_data,  png_width * png_height);
+            convert_color_depth(img_data, img_data, png_width * png_height);
             dsc->img_data = img_data;
+            dsc->time_to_open = lv_tick_elaps(t_start);
             return LV_RES_OK;     /*The image is fully decoded. Return with its pointer*/
         }
     }
@@ -204,9 +259,10 @@ static lv_res_t decoder_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t *
         }
 
         /*Convert the image to the system's color depth*/
-        convert_color_depth(img_data,  png_width * png_height);
+        convert_color_depth(img_data, img_data, png_width * png_height);
 
         dsc->img_data = img_data;
+        dsc->time_to_open = lv_tick_elaps(t_start);
         return LV_RES_OK;     /*Return with its pointer*/
     }
 
@@ -223,56 +279,536 @@ static void decoder_close(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc
         lv_mem_free((uint8_t *)dsc->img_data);
         dsc->img_data = NULL;
     }
+#if LV_PNG_STREAM_DECODE
+    if(dsc->user_data) {
+        stream_close(dsc->user_data);
+        dsc->user_data = NULL;
+    }
+#endif
 }
 
 /**
- * If the display is not in 32 bit format (ARGB888) then covert the image to the current color depth
- * @param img the ARGB888 image
- * @param px_cnt number of pixels in `img`
+ * Convert RGBA8888 pixels (the byte order of lodepng) to the current color depth with alpha byte
+ * (`LV_IMG_CF_TRUE_COLOR_ALPHA`). Blocks of pixels are converted with NEON or SSE2 if available.
+ * @param dst store the converted pixels here. Can be the same as `src` as the result is never larger.
+ * @param src the RGBA8888 pixels
+ * @param px_cnt number of pixels to convert
  */
-static void convert_color_depth(uint8_t * img, uint32_t px_cnt)
+static void convert_color_depth(uint8_t * dst, const uint8_t * src, uint32_t px_cnt)
 {
+    uint32_t i = 0;
 #if LV_COLOR_DEPTH == 32
-    lv_color32_t * img_argb = (lv_color32_t *)img;
-    lv_color_t c;
-    lv_color_t * img_c = (lv_color_t *) img;
-    uint32_t i;
-    for(i = 0; i < px_cnt; i++) {
-        c = lv_color_make(img_argb[i].ch.red, img_argb[i].ch.green, img_argb[i].ch.blue);
-        img_c[i].ch.red = c.ch.blue;
-        img_c[i].ch.blue = c.ch.red;
+#if defined(__ARM_NEON)
+    for(; i + 16 <= px_cnt; i += 16) {
+        uint8x16x4_t px = vld4q_u8(src + i * 4);
+        uint8x16_t tmp = px.val[0];
+        px.val[0] = px.val[2];
+        px.val[2] = tmp;
+        vst4q_u8(dst + i * 4, px);
+    }
+#elif defined(__SSE2__)
+    const __m128i mask_ag = _mm_set1_epi32((int)0xFF00FF00);
+    const __m128i mask_ch = _mm_set1_epi32(0xFF);
+    for(; i + 4 <= px_cnt; i += 4) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(src + i * 4));
+        __m128i r = _mm_slli_epi32(_mm_and_si128(v, mask_ch), 16);
+        __m128i b = _mm_and_si128(_mm_srli_epi32(v, 16), mask_ch);
+        v = _mm_or_si128(_mm_and_si128(v, mask_ag), _mm_or_si128(r, b));
+        _mm_storeu_si128((__m128i *)(dst + i * 4), v);
+    }
+#endif
+    for(; i < px_cnt; i++) {
+        uint8_t r = src[i * 4 + 0];
+        uint8_t g = src[i * 4 + 1];
+        uint8_t b = src[i * 4 + 2];
+        uint8_t a = src[i * 4 + 3];
+        dst[i * 4 + 0] = b;
+        dst[i * 4 + 1] = g;
+        dst[i * 4 + 2] = r;
+        dst[i * 4 + 3] = a;
     }
 #elif LV_COLOR_DEPTH == 16
-    lv_color32_t * img_argb = (lv_color32_t *)img;
+#if defined(__ARM_NEON)
+    /*The low and high bytes of RGB565 can be computed directly from the 8 bit channels*/
+    const uint8x16_t mask_g = vdupq_n_u8(0x1C);
+    const uint8x16_t mask_r = vdupq_n_u8(0xF8);
+    for(; i + 16 <= px_cnt; i += 16) {
+        uint8x16x4_t px = vld4q_u8(src + i * 4);
+        uint8x16_t lo = vorrq_u8(vshlq_n_u8(vandq_u8(px.val[1], mask_g), 3), vshrq_n_u8(px.val[2], 3));
+        uint8x16_t hi = vorrq_u8(vandq_u8(px.val[0], mask_r), vshrq_n_u8(px.val[1], 5));
+        uint8x16x3_t out;
+#if LV_COLOR_16_SWAP
+        out.val[0] = hi;
+        out.val[1] = lo;
+#else
+        out.val[0] = lo;
+        out.val[1] = hi;
+#endif
+        out.val[2] = px.val[3];
+        vst3q_u8(dst + i * 3, out);
+    }
+#elif defined(__SSE2__)
+    const __m128i mask_g = _mm_set1_epi32(0x1C);
+    const __m128i mask_b = _mm_set1_epi32(0x1F);
+    const __m128i mask_r = _mm_set1_epi32(0xF8);
+    const __m128i mask_gh = _mm_set1_epi32(0x07);
+    for(; i + 4 <= px_cnt; i += 4) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(src + i * 4));
+        __m128i lo = _mm_or_si128(_mm_slli_epi32(_mm_and_si128(_mm_srli_epi32(v, 8), mask_g), 3),
+                                  _mm_and_si128(_mm_srli_epi32(v, 19), mask_b));
+        __m128i hi = _mm_or_si128(_mm_and_si128(v, mask_r), _mm_and_si128(_mm_srli_epi32(v, 13), mask_gh));
+#if LV_COLOR_16_SWAP
+        __m128i c = _mm_or_si128(hi, _mm_slli_epi32(lo, 8));
+#else
+        __m128i c = _mm_or_si128(lo, _mm_slli_epi32(hi, 8));
+#endif
+        c = _mm_or_si128(c, _mm_slli_epi32(_mm_srli_epi32(v, 24), 16));
+
+        uint32_t px[4];
+        _mm_storeu_si128((__m128i *)px, c);
+        uint32_t k;
+        for(k = 0; k < 4; k++) {
+            uint8_t * d = &dst[(i + k) * 3];
+            d[0] = px[k] & 0xFF;
+            d[1] = (px[k] >> 8) & 0xFF;
+            d[2] = (px[k] >> 16) & 0xFF;
+        }
+    }
+#endif
     lv_color_t c;
-    uint32_t i;
-    for(i = 0; i < px_cnt; i++) {
-        c = lv_color_make(img_argb[i].ch.blue, img_argb[i].ch.green, img_argb[i].ch.red);
-        img[i * 3 + 2] = img_argb[i].ch.alpha;
-        img[i * 3 + 1] = c.full >> 8;
-        img[i * 3 + 0] = c.full & 0xFF;
+    for(; i < px_cnt; i++) {
+        uint8_t a = src[i * 4 + 3];
+        c = lv_color_make(src[i * 4 + 0], src[i * 4 + 1], src[i * 4 + 2]);
+        dst[i * 3 + 2] = a;
+        dst[i * 3 + 1] = c.full >> 8;
+        dst[i * 3 + 0] = c.full & 0xFF;
     }
 #elif LV_COLOR_DEPTH == 8
-    lv_color32_t * img_argb = (lv_color32_t *)img;
     lv_color_t c;
-    uint32_t i;
-    for(i = 0; i < px_cnt; i++) {
-        c = lv_color_make(img_argb[i].ch.red, img_argb[i].ch.green, img_argb[i].ch.blue);
-        img[i * 2 + 1] = img_argb[i].ch.alpha;
-        img[i * 2 + 0] = c.full;
+    for(; i < px_cnt; i++) {
+        uint8_t a = src[i * 4 + 3];
+        c = lv_color_make(src[i * 4 + 0], src[i * 4 + 1], src[i * 4 + 2]);
+        dst[i * 2 + 1] = a;
+        dst[i * 2 + 0] = c.full;
     }
 #elif LV_COLOR_DEPTH == 1
-    lv_color32_t * img_argb = (lv_color32_t *)img;
     uint8_t b;
-    uint32_t i;
-    for(i = 0; i < px_cnt; i++) {
-        b = img_argb[i].ch.red | img_argb[i].ch.green | img_argb[i].ch.blue;
-        img[i * 2 + 1] = img_argb[i].ch.alpha;
-        img[i * 2 + 0] = b > 128 ? 1 : 0;
+    for(; i < px_cnt; i++) {
+        uint8_t a = src[i * 4 + 3];
+        b = src[i * 4 + 0] | src[i * 4 + 1] | src[i * 4 + 2];
+        dst[i * 2 + 1] = a;
+        dst[i * 2 + 0] = b > 128 ? 1 : 0;
     }
 #endif
 }
 
+#if LV_PNG_STREAM_DECODE
+
+/**
+ * Decode a line of a PNG opened in streaming mode.
+ * The rows are unfiltered on demand up to `y` and only the requested pixels are converted.
+ */
+static lv_res_t decoder_read_line(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc,
+                                  lv_coord_t x, lv_coord_t y, lv_coord_t len, uint8_t * buf)
+{
+    LV_UNUSED(decoder);
+    png_stream_t * stream = dsc->user_data;
+    if(stream == NULL) return LV_RES_INV;
+    if(x < 0 || y < 0 || len <= 0 || (uint32_t)y >= stream->h || (uint32_t)x + len > stream->w) return LV_RES_INV;
+
+    if(stream->rows_ready <= (uint32_t)y) {
+        if(!stream_unfilter_rows(stream, y)) {
+            LV_LOG_WARN("corrupted PNG row %d", y);
+            return LV_RES_INV;
+        }
+        /*Once every row is decoded let the image cache know how much the decoding really cost*/
+        if(stream->rows_ready == stream->h) dsc->time_to_open += stream->stream_time;
+    }
+
+    const uint8_t * row = &stream->scanlines[(uint32_t)y * (stream->row_size + 1) + 1];
+    if(stream->rgba_line == NULL) {
+        convert_color_depth(buf, row + x * 4, len);
+    }
+    else {
+        stream_row_to_rgba(stream, row, x, len, stream->rgba_line);
+        convert_color_depth(buf, stream->rgba_line, len);
+    }
+
+    return LV_RES_OK;
+}
+
+/**
+ * Prepare a PNG for streaming: read the header and the palette, and inflate the image data.
+ * The rows remain filtered until they are requested.
+ * @param dsc the decoder descriptor. `user_data` will point to the stream on success.
+ * @return LV_RES_OK: ready to stream; LV_RES_INV: the image can't be streamed (e.g. interlaced)
+ */
+static lv_res_t stream_open(lv_img_decoder_dsc_t * dsc)
+{
+    uint32_t t_start = lv_tick_get();
+
+    png_reader_t reader;
+    lv_memset_00(&reader, sizeof(reader));
+    lv_fs_file_t f;
+    if(dsc->src_type == LV_IMG_SRC_FILE) {
+        if(lv_fs_open(&f, dsc->src, LV_FS_MODE_RD) != LV_FS_RES_OK) return LV_RES_INV;
+        reader.f = &f;
+    }
+    else if(dsc->src_type == LV_IMG_SRC_VARIABLE) {
+        const lv_img_dsc_t * img_dsc = dsc->src;
+        reader.data = img_dsc->data;
+        reader.data_size = img_dsc->data_size;
+    }
+    else {
+        return LV_RES_INV;
+    }
+
+    png_stream_t * stream = lv_mem_alloc(sizeof(png_stream_t));
+    LV_ASSERT_MALLOC(stream);
+    if(stream == NULL) {
+        if(reader.f) lv_fs_close(reader.f);
+        return LV_RES_INV;
+    }
+    lv_memset_00(stream, sizeof(png_stream_t));
+
+    uint8_t * idat = NULL;
+    uint32_t idat_size = 0;
+    uint32_t idat_cap = 0;
+    bool header_ok = false;
+    bool end = false;
+
+    static const uint8_t magic[PNG_SIGNATURE_SIZE] = {0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a};
+    uint8_t sig[PNG_SIGNATURE_SIZE];
+    bool ok = reader_read(&reader, sig, sizeof(sig)) && memcmp(sig, magic, sizeof(magic)) == 0;
+
+    /*Collect the chunks required for decoding, skip the others*/
+    while(ok && !end) {
+        uint8_t chunk_head[8];
+        if(!reader_read(&reader, chunk_head, sizeof(chunk_head))) {
+            ok = false;
+            break;
+        }
+        uint32_t chunk_len = ((uint32_t)chunk_head[0] << 24) | ((uint32_t)chunk_head[1] << 16) |
+                             ((uint32_t)chunk_head[2] << 8) | chunk_head[3];
+        const char * type = (const char *)&chunk_head[4];
+
+        if(memcmp(type, "IHDR", 4) == 0) {
+            uint8_t ihdr[PNG_IHDR_SIZE];
+            if(chunk_len != PNG_IHDR_SIZE || !reader_read(&reader, ihdr, sizeof(ihdr))) {
+                ok = false;
+                break;
+            }
+            stream->w = ((uint32_t)ihdr[0] << 24) | ((uint32_t)ihdr[1] << 16) | ((uint32_t)ihdr[2] << 8) | ihdr[3];
+            stream->h = ((uint32_t)ihdr[4] << 24) | ((uint32_t)ihdr[5] << 16) | ((uint32_t)ihdr[6] << 8) | ihdr[7];
+            stream->bit_depth = ihdr[8];
+            stream->color_type = ihdr[9];
+
+            uint32_t channels;
+            switch(stream->color_type) {
+                case 0:
+                    channels = 1;
+                    ok = stream->bit_depth == 8 || stream->bit_depth == 16;
+                    break;
+                case 2:
+                    channels = 3;
+                    ok = stream->bit_depth == 8 || stream->bit_depth == 16;
+                    break;
+                case 3:
+                    channels = 1;
+                    ok = stream->bit_depth == 1 || stream->bit_depth == 2 || stream->bit_depth == 4 || stream->bit_depth == 8;
+                    break;
+                case 4:
+                    channels = 2;
+                    ok = stream->bit_depth == 8 || stream->bit_depth == 16;
+                    break;
+                case 6:
+                    channels = 4;
+                    ok = stream->bit_depth == 8 || stream->bit_depth == 16;
+                    break;
+                default:
+                    channels = 0;
+                    ok = false;
+                    break;
+            }
+
+            /*Interlaced images and images of unexpected size are decoded the normal way*/
+            if(ihdr[12] != 0) ok = false;
+            if(stream->w != (uint32_t)dsc->header.w || stream->h != (uint32_t)dsc->header.h) ok = false;
+            if(!ok) break;
+
+            uint32_t px_bits = channels * stream->bit_depth;
+            stream->row_size = (stream->w * px_bits + 7) >> 3;
+            stream->px_bytes = px_bits < 8 ? 1 : px_bits >> 3;
+            header_ok = true;
+        }
+        else if(memcmp(type, "PLTE", 4) == 0) {
+            uint8_t rgb[3];
+            uint32_t n = chunk_len / 3;
+            if(n > 256 || chunk_len % 3) {
+                ok = false;
+                break;
+            }
+            uint32_t i;
+            for(i = 0; i < n && ok; i++) {
+                ok = reader_read(&reader, rgb, 3);
+                stream->palette[i * 4 + 0] = rgb[0];
+                stream->palette[i * 4 + 1] = rgb[1];
+                stream->palette[i * 4 + 2] = rgb[2];
+                stream->palette[i * 4 + 3] = 0xFF;
+            }
+            stream->palette_size = n;
+        }
+        else if(memcmp(type, "tRNS", 4) == 0) {
+            /*Color keys of non-palette images are not supported in streaming mode*/
+            if(stream->color_type != 3 || chunk_len > stream->palette_size) {
+                ok = false;
+                break;
+            }
+            uint32_t i;
+            for(i = 0; i < chunk_len && ok; i++) {
+                ok = reader_read(&reader, &stream->palette[i * 4 + 3], 1);
+            }
+        }
+        else if(memcmp(type, "IDAT", 4) == 0) {
+            if(!header_ok) {
+                ok = false;
+                break;
+            }
+            if(idat_size + chunk_len > idat_cap) {
+                uint32_t new_cap = LV_MAX(idat_cap * 2, idat_size + chunk_len);
+                uint8_t * new_idat = lv_mem_realloc(idat, new_cap);
+                if(new_idat == NULL) {
+                    ok = false;
+                    break;
+                }
+                idat = new_idat;
+                idat_cap = new_cap;
+            }
+            ok = reader_read(&reader, &idat[idat_size], chunk_len);
+            idat_size += chunk_len;
+        }
+        else if(memcmp(type, "IEND", 4) == 0) {
+            end = true;
+        }
+        else {
+            ok = reader_skip(&reader, chunk_len);
+        }
+
+        /*Skip the CRC*/
+        if(ok && !end) ok = reader_skip(&reader, 4);
+    }
+
+    if(reader.f) lv_fs_close(reader.f);
+
+    if(!ok || !header_ok || idat == NULL || (stream->color_type == 3 && stream->palette_size == 0)) {
+        if(idat) lv_mem_free(idat);
+        lv_mem_free(stream);
+        return LV_RES_INV;
+    }
+
+    /*Inflate the image data. The source file is not kept in memory meanwhile*/
+    size_t expected_size = (size_t)(stream->row_size + 1) * stream->h;
+    LodePNGDecompressSettings settings;
+    lodepng_decompress_settings_init(&settings);
+    settings.max_output_size = expected_size;
+
+    unsigned char * scanlines = NULL;
+    size_t scanlines_size = 0;
+    uint32_t error = lodepng_zlib_decompress(&scanlines, &scanlines_size, idat, idat_size, &settings);
+    lv_mem_free(idat);
+    if(error || scanlines_size < expected_size) {
+        if(error) LV_LOG_WARN("error %" LV_PRIu32 ": %s\n", error, lodepng_error_text(error));
+        if(scanlines) lv_mem_free(scanlines);
+        lv_mem_free(stream);
+        return LV_RES_INV;
+    }
+
+    /*The inflater over-allocates so give back the unused tail*/
+    uint8_t * shrunk = lv_mem_realloc(scanlines, expected_size);
+    stream->scanlines = shrunk ? shrunk : scanlines;
+
+    if(stream->color_type != 6 || stream->bit_depth != 8) {
+        stream->rgba_line = lv_mem_alloc(stream->w * 4);
+        LV_ASSERT_MALLOC(stream->rgba_line);
+        if(stream->rgba_line == NULL) {
+            stream_close(stream);
+            return LV_RES_INV;
+        }
+    }
+
+    dsc->user_data = stream;
+    dsc->img_data = NULL;
+    dsc->time_to_open = lv_tick_elaps(t_start);
+    return LV_RES_OK;
+}
+
+static void stream_close(png_stream_t * stream)
+{
+    if(stream->scanlines) lv_mem_free(stream->scanlines);
+    if(stream->rgba_line) lv_mem_free(stream->rgba_line);
+    lv_mem_free(stream);
+}
+
+static bool reader_read(png_reader_t * reader, void * buf, uint32_t len)
+{
+    if(reader->f) {
+        uint32_t rn = 0;
+        lv_fs_res_t res = lv_fs_read(reader->f, buf, len, &rn);
+        return res == LV_FS_RES_OK && rn == len;
+    }
+
+    if(reader->data_size - reader->pos < len) return false;
+    lv_memcpy(buf, &reader->data[reader->pos], len);
+    reader->pos += len;
+    return true;
+}
+
+static bool reader_skip(png_reader_t * reader, uint32_t len)
+{
+    if(reader->f) {
+        return lv_fs_seek(reader->f, len, LV_FS_SEEK_CUR) == LV_FS_RES_OK;
+    }
+
+    if(reader->data_size - reader->pos < len) return false;
+    reader->pos += len;
+    return true;
+}
+
+static inline uint8_t paeth_predictor(int16_t a, int16_t b, int16_t c)
+{
+    int16_t pa = LV_ABS(b - c);
+    int16_t pb = LV_ABS(a - c);
+    int16_t pc = LV_ABS(a + b - c - c);
+    if(pc < pa && pc < pb) return (uint8_t)c;
+    else if(pb < pa) return (uint8_t)b;
+    else return (uint8_t)a;
+}
+
+/**
+ * Unfilter the rows in place until `y` (inclusive). Rows above `stream->rows_ready` are already unfiltered
+ * so every row is processed only once.
+ * @return true: success; false: invalid filter type
+ */
+static bool stream_unfilter_rows(png_stream_t * stream, uint32_t y)
+{
+    uint32_t t_start = lv_tick_get();
+    uint32_t stride = stream->row_size + 1;
+    uint32_t bpp = stream->px_bytes;
+    uint32_t len = stream->row_size;
+
+    while(stream->rows_ready <= y) {
+        uint8_t * row = &stream->scanlines[stream->rows_ready * stride + 1];
+        const uint8_t * prev = stream->rows_ready > 0 ? row - stride : NULL;
+        uint8_t filter = row[-1];
+        uint32_t i;
+
+        switch(filter) {
+            case 0:
+                break;
+            case 1:
+                for(i = bpp; i < len; i++) row[i] += row[i - bpp];
+                break;
+            case 2:
+                if(prev) for(i = 0; i < len; i++) row[i] += prev[i];
+                break;
+            case 3:
+                if(prev) {
+                    for(i = 0; i < bpp; i++) row[i] += prev[i] >> 1;
+                    for(i = bpp; i < len; i++) row[i] += (row[i - bpp] + prev[i]) >> 1;
+                }
+                else {
+                    for(i = bpp; i < len; i++) row[i] += row[i - bpp] >> 1;
+                }
+                break;
+            case 4:
+                if(prev) {
+                    for(i = 0; i < bpp; i++) row[i] += prev[i];
+                    for(i = bpp; i < len; i++) row[i] += paeth_predictor(row[i - bpp], prev[i], prev[i - bpp]);
+                }
+                else {
+                    for(i = bpp; i < len; i++) row[i] += row[i - bpp];
+                }
+                break;
+            default:
+                return false;
+        }
+
+        row[-1] = 0;
+        stream->rows_ready++;
+    }
+
+    stream->stream_time += lv_tick_elaps(t_start);
+    return true;
+}
+
+/**
+ * Convert `len` pixels of an unfiltered row starting from `x` to RGBA8888.
+ * 16 bit channels are truncated to their high byte.
+ */
+static void stream_row_to_rgba(png_stream_t * stream, const uint8_t * row, uint32_t x, uint32_t len, uint8_t * rgba)
+{
+    uint32_t i;
+    uint32_t step = stream->bit_depth == 16 ? 2 : 1;
+
+    switch(stream->color_type) {
+        case 0:
+            for(i = 0; i < len; i++) {
+                uint8_t v = row[(x + i) * step];
+                rgba[i * 4 + 0] = v;
+                rgba[i * 4 + 1] = v;
+                rgba[i * 4 + 2] = v;
+                rgba[i * 4 + 3] = 0xFF;
+            }
+            break;
+        case 2:
+            for(i = 0; i < len; i++) {
+                const uint8_t * p = &row[(x + i) * 3 * step];
+                rgba[i * 4 + 0] = p[0];
+                rgba[i * 4 + 1] = p[step];
+                rgba[i * 4 + 2] = p[2 * step];
+                rgba[i * 4 + 3] = 0xFF;
+            }
+            break;
+        case 3: {
+                uint32_t depth = stream->bit_depth;
+                uint32_t mask = (1 << depth) - 1;
+                for(i = 0; i < len; i++) {
+                    uint32_t bit = (x + i) * depth;
+                    uint32_t idx = (row[bit >> 3] >> (8 - depth - (bit & 0x7))) & mask;
+                    if(idx < stream->palette_size) {
+                        lv_memcpy_small(&rgba[i * 4], &stream->palette[idx * 4], 4);
+                    }
+                    else {
+                        lv_memset_00(&rgba[i * 4], 4);
+                    }
+                }
+                break;
+            }
+        case 4:
+            for(i = 0; i < len; i++) {
+                const uint8_t * p = &row[(x + i) * 2 * step];
+                rgba[i * 4 + 0] = p[0];
+                rgba[i * 4 + 1] = p[0];
+                rgba[i * 4 + 2] = p[0];
+                rgba[i * 4 + 3] = p[step];
+            }
+            break;
+        case 6:
+            for(i = 0; i < len; i++) {
+                const uint8_t * p = &row[(x + i) * 4 * step];
+                rgba[i * 4 + 0] = p[0];
+                rgba[i * 4 + 1] = p[step];
+                rgba[i * 4 + 2] = p[2 * step];
+                rgba[i * 4 + 3] = p[3 * step];
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+#endif /*LV_PNG_STREAM_DECODE*/
+
 #endif /*LV_USE_PNG*/
 
 
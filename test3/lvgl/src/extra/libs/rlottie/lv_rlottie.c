@@ -10,6 +10,14 @@
 #if LV_USE_RLOTTIE
 
 #include <rlottie_capi.h>
+#if LV_RLOTTIE_USE_THREADS
+    #include <pthread.h>
+#endif
+#if defined(__ARM_NEON)
+    #include <arm_neon.h>
+#elif defined(__SSE2__)
+    #include <emmintrin.h>
+#endif
 
 /*********************
 *      DEFINES
@@ -17,17 +25,58 @@
 #define MY_CLASS &lv_rlottie_class
 #define LV_ARGB32   32
 
+#if LV_RLOTTIE_USE_THREADS
+    #define RLOTTIE_RING_SIZE   LV_MAX(LV_RLOTTIE_RING_SIZE, 2)
+#endif
+
 /**********************
 *      TYPEDEFS
 **********************/
 #define LV_ARGB32   32
 
+#if LV_RLOTTIE_USE_THREADS || LV_RLOTTIE_CACHE_SIZE
+enum {
+    RLOTTIE_FRAME_EMPTY,
+    RLOTTIE_FRAME_RENDERING,
+    RLOTTIE_FRAME_READY,
+};
+#endif
+
+#if LV_RLOTTIE_USE_THREADS
+typedef struct _lv_rlottie_worker_t {
+    pthread_t thread;
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;        /*Broadcasted when a frame is rendered or the shown frame has changed*/
+    size_t frame;               /*The shown frame. The next ones are predicted from it.*/
+    lv_rlottie_ctrl_t ctrl;     /*Play mode when `frame` was shown*/
+    bool rendering;             /*The worker is using the animation*/
+    bool ui_rendering;          /*The UI thread is using the animation*/
+    bool quit;
+} lv_rlottie_worker_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static void lv_rlottie_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
 static void lv_rlottie_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
 static void next_frame_task_cb(lv_timer_t * t);
+static bool get_next_frame(size_t * frame, size_t total_frames, lv_rlottie_ctrl_t ctrl);
+static void render_frame(lv_rlottie_t * rlottie, size_t frame, uint32_t * buf);
+#if LV_COLOR_DEPTH == 16
+static void convert_to_rgba5658(uint32_t * pix, const size_t width, const size_t height);
+#endif
+#if LV_RLOTTIE_USE_THREADS || LV_RLOTTIE_CACHE_SIZE
+static void frames_init(lv_rlottie_t * rlottie);
+static void show_frame(lv_rlottie_t * rlottie, size_t frame);
+static int32_t find_frame(lv_rlottie_t * rlottie, size_t frame);
+static int32_t get_free_slot(lv_rlottie_t * rlottie, size_t frame, size_t shown_frame, lv_rlottie_ctrl_t ctrl);
+#endif
+#if LV_RLOTTIE_USE_THREADS
+static void worker_start(lv_rlottie_t * rlottie);
+static void worker_stop(lv_rlottie_t * rlottie);
+static void * worker_thread(void * arg);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -127,7 +176,31 @@ static void lv_rlottie_constructor(const lv_obj_class_t * class_p, lv_obj_t * ob
     rlottie->scanline_width = create_width * LV_ARGB32 / 8;
 
     size_t allocaled_buf_size = (create_width * create_height * LV_ARGB32 / 8);
+#if LV_RLOTTIE_USE_THREADS || LV_RLOTTIE_CACHE_SIZE
+    /*Frames from 0 to `total_frames` can be shown*/
+    size_t frame_buf_size = allocaled_buf_size;
+    rlottie->frame_cnt = 1;
+    rlottie->cache_all = false;
+#if LV_RLOTTIE_CACHE_SIZE
+    if(frame_buf_size * (rlottie->total_frames + 1) <= LV_RLOTTIE_CACHE_SIZE) {
+        rlottie->frame_cnt = rlottie->total_frames + 1;
+        rlottie->cache_all = true;
+    }
+#endif
+#if LV_RLOTTIE_USE_THREADS
+    if(!rlottie->cache_all) rlottie->frame_cnt = RLOTTIE_RING_SIZE;
+#endif
+    rlottie->allocated_buf = lv_mem_alloc(frame_buf_size * rlottie->frame_cnt);
+    if(rlottie->allocated_buf == NULL && rlottie->frame_cnt > 1) {
+        LV_LOG_WARN("Not enough memory for %d frames, render only the shown frame", (int)rlottie->frame_cnt);
+        rlottie->frame_cnt = 1;
+        rlottie->cache_all = false;
+        rlottie->allocated_buf = lv_mem_alloc(frame_buf_size);
+    }
+    allocaled_buf_size = frame_buf_size * rlottie->frame_cnt;
+#else
     rlottie->allocated_buf = lv_mem_alloc(allocaled_buf_size);
+#endif
     if(rlottie->allocated_buf != NULL) {
         rlottie->allocated_buffer_size = allocaled_buf_size;
         memset(rlottie->allocated_buf, 0, allocaled_buf_size);
@@ -138,13 +211,20 @@ static void lv_rlottie_constructor(const lv_obj_class_t * class_p, lv_obj_t * ob
     rlottie->imgdsc.header.h = create_height;
     rlottie->imgdsc.header.w = create_width;
     rlottie->imgdsc.data = (void *)rlottie->allocated_buf;
-    rlottie->imgdsc.data_size = allocaled_buf_size;
+    rlottie->imgdsc.data_size = create_width * create_height * LV_ARGB32 / 8;
 
     lv_img_set_src(obj, &rlottie->imgdsc);
 
     rlottie->play_ctrl = LV_RLOTTIE_CTRL_FORWARD | LV_RLOTTIE_CTRL_PLAY | LV_RLOTTIE_CTRL_LOOP;
     rlottie->dest_frame = rlottie->total_frames; /* invalid destination frame so it's possible to pause on frame 0 */
 
+#if LV_RLOTTIE_USE_THREADS || LV_RLOTTIE_CACHE_SIZE
+    frames_init(rlottie);
+#endif
+#if LV_RLOTTIE_USE_THREADS
+    worker_start(rlottie);
+#endif
+
     rlottie->task = lv_timer_create(next_frame_task_cb, 1000 / rlottie->framerate, obj);
 
     lv_obj_update_layout(obj);
@@ -156,6 +236,11 @@ static void lv_rlottie_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj
     LV_UNUSED(class_p);
     lv_rlottie_t * rlottie = (lv_rlottie_t *) obj;
 
+#if LV_RLOTTIE_USE_THREADS
+    /*Stop the worker first as it uses the animation and the buffers*/
+    worker_stop(rlottie);
+#endif
+
     if(rlottie->animation) {
         lottie_animation_destroy(rlottie->animation);
         rlottie->animation = 0;
@@ -179,46 +264,160 @@ static void lv_rlottie_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj
         rlottie->allocated_buffer_size = 0;
     }
 
+#if LV_RLOTTIE_USE_THREADS || LV_RLOTTIE_CACHE_SIZE
+    if(rlottie->frames) {
+        lv_mem_free(rlottie->frames);
+        rlottie->frames = NULL;
+        rlottie->frame_cnt = 0;
+    }
+#endif
+
+}
+
+/**
+ * Step to the next frame according to the play mode
+ * @param frame         pointer to the current frame, will be updated
+ * @param total_frames  number of frames of the animation
+ * @param ctrl          the play mode
+ * @return              true: `frame` is updated; false: the end of a not looping animation is reached
+ */
+static bool get_next_frame(size_t * frame, size_t total_frames, lv_rlottie_ctrl_t ctrl)
+{
+    if((ctrl & LV_RLOTTIE_CTRL_BACKWARD) == LV_RLOTTIE_CTRL_BACKWARD) {
+        if(*frame > 0)
+            --(*frame);
+        else { /* Looping ? */
+            if((ctrl & LV_RLOTTIE_CTRL_LOOP) == LV_RLOTTIE_CTRL_LOOP)
+                *frame = total_frames - 1;
+            else
+                return false;
+        }
+    }
+    else {
+        if(*frame < total_frames)
+            ++(*frame);
+        else { /* Looping ? */
+            if((ctrl & LV_RLOTTIE_CTRL_LOOP) == LV_RLOTTIE_CTRL_LOOP)
+                *frame = 0;
+            else
+                return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Render a frame and convert it to LVGL's color format.
+ * Called from the worker thread too so it must not use `lv_mem` or any other LVGL function.
+ * @param rlottie   pointer to an rlottie object
+ * @param frame     the frame to render
+ * @param buf       render the frame here
+ */
+static void render_frame(lv_rlottie_t * rlottie, size_t frame, uint32_t * buf)
+{
+    lottie_animation_render(
+        rlottie->animation,
+        frame,
+        buf,
+        rlottie->imgdsc.header.w,
+        rlottie->imgdsc.header.h,
+        rlottie->scanline_width
+    );
+
+#if LV_COLOR_DEPTH == 16
+    convert_to_rgba5658(buf, rlottie->imgdsc.header.w, rlottie->imgdsc.header.h);
+#endif
 }
 
 #if LV_COLOR_DEPTH == 16
 static void convert_to_rgba5658(uint32_t * pix, const size_t width, const size_t height)
 {
     /* rlottie draws in ARGB32 format, but LVGL only deal with RGB565 format with (optional 8 bit alpha channel)
-       so convert in place here the received buffer to LVGL format. */
+       so convert in place here the received buffer to LVGL format.
+       Blocks of pixels are read before writing them so the vectorized loops can work in place too. */
     uint8_t * dest = (uint8_t *)pix;
-    uint32_t * src = pix;
-    for(size_t y = 0; y < height; y++) {
-        /* Convert a 4 bytes per pixel in format ARGB to R5G6B5A8 format
-            naive way:
-                        r = ((c & 0xFF0000) >> 19)
-                        g = ((c & 0xFF00) >> 10)
-                        b = ((c & 0xFF) >> 3)
-                        rgb565 = (r << 11) | (g << 5) | b
-                        a = c >> 24;
-            That's 3 mask, 6 bitshift and 2 or operations
-
-            A bit better:
-                        r = ((c & 0xF80000) >> 8)
-                        g = ((c & 0xFC00) >> 5)
-                        b = ((c & 0xFF) >> 3)
-                        rgb565 = r | g | b
-                        a = c >> 24;
-            That's 3 mask, 3 bitshifts and 2 or operations */
-        for(size_t x = 0; x < width; x++) {
-            uint32_t in = src[x];
+    const uint8_t * src = (const uint8_t *)pix;
+    size_t px_cnt = width * height;
+    size_t i = 0;
+
+#if defined(__ARM_NEON)
+    /*The low and high bytes of RGB565 can be computed directly from the 8 bit channels*/
+    const uint8x16_t mask_g = vdupq_n_u8(0x1C);
+    const uint8x16_t mask_r = vdupq_n_u8(0xF8);
+    for(; i + 16 <= px_cnt; i += 16) {
+        uint8x16x4_t px = vld4q_u8(src + i * 4);     /*B, G, R, A*/
+        uint8x16_t lo = vorrq_u8(vshlq_n_u8(vandq_u8(px.val[1], mask_g), 3), vshrq_n_u8(px.val[0], 3));
+        uint8x16_t hi = vorrq_u8(vandq_u8(px.val[2], mask_r), vshrq_n_u8(px.val[1], 5));
+        uint8x16x3_t out;
+#if LV_COLOR_16_SWAP
+        out.val[0] = hi;
+        out.val[1] = lo;
+#else
+        out.val[0] = lo;
+        out.val[1] = hi;
+#endif
+        out.val[2] = px.val[3];
+        vst3q_u8(dest + i * 3, out);
+    }
+#elif defined(__SSE2__)
+    const __m128i mask_lo_g = _mm_set1_epi32(0xE0);
+    const __m128i mask_lo_b = _mm_set1_epi32(0x1F);
+    const __m128i mask_hi_r = _mm_set1_epi32(0xF8);
+    const __m128i mask_hi_g = _mm_set1_epi32(0x07);
+    for(; i + 4 <= px_cnt; i += 4) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(src + i * 4));
+        __m128i lo = _mm_or_si128(_mm_and_si128(_mm_srli_epi32(v, 5), mask_lo_g),
+                                  _mm_and_si128(_mm_srli_epi32(v, 3), mask_lo_b));
+        __m128i hi = _mm_or_si128(_mm_and_si128(_mm_srli_epi32(v, 16), mask_hi_r),
+                                  _mm_and_si128(_mm_srli_epi32(v, 13), mask_hi_g));
+#if LV_COLOR_16_SWAP
+        __m128i c = _mm_or_si128(hi, _mm_slli_epi32(lo, 8));
+#else
+        __m128i c = _mm_or_si128(lo, _mm_slli_epi32(hi, 8));
+#endif
+        c = _mm_or_si128(c, _mm_slli_epi32(_mm_srli_epi32(v, 24), 16));
+
+        uint32_t px[4];
+        _mm_storeu_si128((__m128i *)px, c);
+        uint32_t k;
+        for(k = 0; k < 4; k++) {
+            uint8_t * d = &dest[(i + k) * 3];
+            d[0] = px[k] & 0xFF;
+            d[1] = (px[k] >> 8) & 0xFF;
+            d[2] = (px[k] >> 16) & 0xFF;
+        }
+    }
+#endif
+
+    /* Convert a 4 bytes per pixel in format ARGB to R5G6B5A8 format
+        naive way:
+                    r = ((c & 0xFF0000) >> 19)
+                    g = ((c & 0xFF00) >> 10)
+                    b = ((c & 0xFF) >> 3)
+                    rgb565 = (r << 11) | (g << 5) | b
+                    a = c >> 24;
+        That's 3 mask, 6 bitshift and 2 or operations
+
+        A bit better:
+                    r = ((c & 0xF80000) >> 8)
+                    g = ((c & 0xFC00) >> 5)
+                    b = ((c & 0xFF) >> 3)
+                    rgb565 = r | g | b
+                    a = c >> 24;
+        That's 3 mask, 3 bitshifts and 2 or operations */
+    for(; i < px_cnt; i++) {
+        uint32_t in = pix[i];
 #if LV_COLOR_16_SWAP == 0
-            uint16_t r = (uint16_t)(((in & 0xF80000) >> 8) | ((in & 0xFC00) >> 5) | ((in & 0xFF) >> 3));
+        uint16_t r = (uint16_t)(((in & 0xF80000) >> 8) | ((in & 0xFC00) >> 5) | ((in & 0xFF) >> 3));
 #else
-            /* We want: rrrr rrrr GGGg gggg bbbb bbbb => gggb bbbb rrrr rGGG */
-            uint16_t r = (uint16_t)(((in & 0xF80000) >> 16) | ((in & 0xFC00) >> 13) | ((in & 0x1C00) << 3) | ((in & 0xF8) << 5));
+        /* We want: rrrr rrrr GGGg gggg bbbb bbbb => gggb bbbb rrrr rGGG */
+        uint16_t r = (uint16_t)(((in & 0xF80000) >> 16) | ((in & 0xFC00) >> 13) | ((in & 0x1C00) << 3) | ((in & 0xF8) << 5));
 #endif
 
-            lv_memcpy(dest, &r, sizeof(r));
-            dest[sizeof(r)] = (uint8_t)(in >> 24);
-            dest += LV_IMG_PX_SIZE_ALPHA_BYTE;
-        }
-        src += width;
+        uint8_t * d = &dest[i * LV_IMG_PX_SIZE_ALPHA_BYTE];
+        lv_memcpy(d, &r, sizeof(r));
+        d[sizeof(r)] = (uint8_t)(in >> 24);
     }
 }
 #endif
@@ -237,48 +436,268 @@ static void next_frame_task_cb(lv_timer_t * t)
         rlottie->dest_frame = rlottie->current_frame;
     }
     else {
-        if((rlottie->play_ctrl & LV_RLOTTIE_CTRL_BACKWARD) == LV_RLOTTIE_CTRL_BACKWARD) {
-            if(rlottie->current_frame > 0)
-                --rlottie->current_frame;
-            else { /* Looping ? */
-                if((rlottie->play_ctrl & LV_RLOTTIE_CTRL_LOOP) == LV_RLOTTIE_CTRL_LOOP)
-                    rlottie->current_frame = rlottie->total_frames - 1;
-                else {
-                    lv_event_send(obj, LV_EVENT_READY, NULL);
-                    lv_timer_pause(t);
-                    return;
-                }
-            }
+        if(!get_next_frame(&rlottie->current_frame, rlottie->total_frames, rlottie->play_ctrl)) {
+            lv_event_send(obj, LV_EVENT_READY, NULL);
+            lv_timer_pause(t);
+            return;
+        }
+    }
+
+#if LV_RLOTTIE_USE_THREADS || LV_RLOTTIE_CACHE_SIZE
+    if(rlottie->frames) {
+        /*Just swap the buffers if the frame is rendered already*/
+        show_frame(rlottie, rlottie->current_frame);
+        lv_img_cache_invalidate_src(&rlottie->imgdsc);
+        lv_obj_invalidate(obj);
+        return;
+    }
+#endif
+
+    render_frame(rlottie, rlottie->current_frame, rlottie->allocated_buf);
+
+    lv_obj_invalidate(obj);
+}
+
+#if LV_RLOTTIE_USE_THREADS || LV_RLOTTIE_CACHE_SIZE
+
+/**
+ * Slice `allocated_buf` to `frame_cnt` frame buffers. The first is shown initially.
+ * @param rlottie   pointer to an rlottie object
+ */
+static void frames_init(lv_rlottie_t * rlottie)
+{
+    /*With a single buffer the frames are simply rendered into `allocated_buf`*/
+    if(rlottie->allocated_buf == NULL || rlottie->frame_cnt < 2) return;
+
+    rlottie->frames = lv_mem_alloc(rlottie->frame_cnt * sizeof(lv_rlottie_frame_t));
+    LV_ASSERT_MALLOC(rlottie->frames);
+    if(rlottie->frames == NULL) return;
+
+    size_t px_cnt = (size_t)rlottie->imgdsc.header.w * rlottie->imgdsc.header.h;
+    uint32_t i;
+    for(i = 0; i < rlottie->frame_cnt; i++) {
+        rlottie->frames[i].buf = rlottie->allocated_buf + i * px_cnt;
+        rlottie->frames[i].frame = 0;
+        rlottie->frames[i].state = RLOTTIE_FRAME_EMPTY;
+    }
+    rlottie->frame_act = 0;
+}
+
+/**
+ * Show a frame. Use the buffer of the frame if it's rendered already
+ * (or being rendered by the worker), else render it now.
+ * @param rlottie   pointer to an rlottie object
+ * @param frame     the frame to show
+ */
+static void show_frame(lv_rlottie_t * rlottie, size_t frame)
+{
+    int32_t slot;
+#if LV_RLOTTIE_USE_THREADS
+    lv_rlottie_worker_t * w = rlottie->worker;
+    if(w) pthread_mutex_lock(&w->mutex);
+    while(1) {
+        slot = find_frame(rlottie, frame);
+        if(slot >= 0 && rlottie->frames[slot].state == RLOTTIE_FRAME_READY) break;
+
+        /*Wait for the worker if it's rendering this frame or uses the animation*/
+        if(w && (slot >= 0 || w->rendering)) {
+            pthread_cond_wait(&w->cond, &w->mutex);
+            continue;
+        }
+
+        slot = get_free_slot(rlottie, frame, rlottie->current_frame, rlottie->play_ctrl);
+        rlottie->frames[slot].state = RLOTTIE_FRAME_RENDERING;
+        rlottie->frames[slot].frame = frame;
+        if(w) {
+            w->ui_rendering = true;
+            pthread_mutex_unlock(&w->mutex);
+        }
+        render_frame(rlottie, frame, rlottie->frames[slot].buf);
+        if(w) {
+            pthread_mutex_lock(&w->mutex);
+            w->ui_rendering = false;
         }
-        else {
-            if(rlottie->current_frame < rlottie->total_frames)
-                ++rlottie->current_frame;
-            else { /* Looping ? */
-                if((rlottie->play_ctrl & LV_RLOTTIE_CTRL_LOOP) == LV_RLOTTIE_CTRL_LOOP)
-                    rlottie->current_frame = 0;
-                else {
-                    lv_event_send(obj, LV_EVENT_READY, NULL);
-                    lv_timer_pause(t);
-                    return;
-                }
+        rlottie->frames[slot].state = RLOTTIE_FRAME_READY;
+        break;
+    }
+
+    rlottie->frame_act = slot;
+    if(w) {
+        /*The worker can render the next frames from here*/
+        w->frame = frame;
+        w->ctrl = rlottie->play_ctrl;
+        pthread_cond_broadcast(&w->cond);
+        pthread_mutex_unlock(&w->mutex);
+    }
+#else
+    slot = find_frame(rlottie, frame);
+    if(slot < 0) {
+        slot = get_free_slot(rlottie, frame, rlottie->current_frame, rlottie->play_ctrl);
+        rlottie->frames[slot].frame = frame;
+        render_frame(rlottie, frame, rlottie->frames[slot].buf);
+        rlottie->frames[slot].state = RLOTTIE_FRAME_READY;
+    }
+    rlottie->frame_act = slot;
+#endif
+
+    rlottie->imgdsc.data = (void *)rlottie->frames[slot].buf;
+}
+
+/**
+ * Find the buffer of a frame
+ * @param rlottie   pointer to an rlottie object
+ * @param frame     the frame to find
+ * @return          index of the buffer which is ready or being rendered, -1 if not found
+ */
+static int32_t find_frame(lv_rlottie_t * rlottie, size_t frame)
+{
+    if(rlottie->cache_all) {
+        if(frame >= rlottie->frame_cnt) return -1;
+        return rlottie->frames[frame].state != RLOTTIE_FRAME_EMPTY ? (int32_t)frame : -1;
+    }
+
+    uint32_t i;
+    for(i = 0; i < rlottie->frame_cnt; i++) {
+        if(rlottie->frames[i].state != RLOTTIE_FRAME_EMPTY && rlottie->frames[i].frame == frame) return i;
+    }
+    return -1;
+}
+
+/**
+ * Get a buffer to render a frame into.
+ * A buffer is free if it's not shown, not being rendered and its frame won't be shown soon.
+ * @param rlottie       pointer to an rlottie object
+ * @param frame         the frame to render
+ * @param shown_frame   the next frames are predicted from this frame
+ * @param ctrl          the play mode to predict the next frames
+ * @return              index of a buffer or -1 if there is no free buffer
+ */
+static int32_t get_free_slot(lv_rlottie_t * rlottie, size_t frame, size_t shown_frame, lv_rlottie_ctrl_t ctrl)
+{
+    if(rlottie->cache_all) return frame < rlottie->frame_cnt ? (int32_t)frame : -1;
+
+    int32_t slot = -1;
+    uint32_t i;
+    for(i = 0; i < rlottie->frame_cnt; i++) {
+        lv_rlottie_frame_t * f = &rlottie->frames[i];
+        if(i == rlottie->frame_act || f->state == RLOTTIE_FRAME_RENDERING) continue;
+        if(f->state == RLOTTIE_FRAME_EMPTY) return i;
+
+        /*Keep the frames which will be shown in the next few steps*/
+        size_t next = shown_frame;
+        uint32_t k;
+        bool needed = false;
+        for(k = 0; k + 1 < rlottie->frame_cnt; k++) {
+            if(!get_next_frame(&next, rlottie->total_frames, ctrl)) break;
+            if(next == f->frame) {
+                needed = true;
+                break;
             }
         }
+        if(!needed) return i;
+        if(slot < 0) slot = i;
     }
 
-    lottie_animation_render(
-        rlottie->animation,
-        rlottie->current_frame,
-        rlottie->allocated_buf,
-        rlottie->imgdsc.header.w,
-        rlottie->imgdsc.header.h,
-        rlottie->scanline_width
-    );
+    /*The UI thread always needs a buffer, use any if all are needed*/
+    if(frame == shown_frame) return slot;
+    return -1;
+}
 
-#if LV_COLOR_DEPTH == 16
-    convert_to_rgba5658(rlottie->allocated_buf, rlottie->imgdsc.header.w, rlottie->imgdsc.header.h);
-#endif
+#endif /*LV_RLOTTIE_USE_THREADS || LV_RLOTTIE_CACHE_SIZE*/
 
-    lv_obj_invalidate(obj);
+#if LV_RLOTTIE_USE_THREADS
+
+/**
+ * Start a worker thread which renders the frames following the shown frame
+ * @param rlottie   pointer to an rlottie object
+ */
+static void worker_start(lv_rlottie_t * rlottie)
+{
+    if(rlottie->frames == NULL || rlottie->frame_cnt < 2) return;
+
+    lv_rlottie_worker_t * w = lv_mem_alloc(sizeof(lv_rlottie_worker_t));
+    LV_ASSERT_MALLOC(w);
+    if(w == NULL) return;
+
+    lv_memset_00(w, sizeof(lv_rlottie_worker_t));
+    w->ctrl = rlottie->play_ctrl;
+    pthread_mutex_init(&w->mutex, NULL);
+    pthread_cond_init(&w->cond, NULL);
+
+    rlottie->worker = w;
+    if(pthread_create(&w->thread, NULL, worker_thread, rlottie) != 0) {
+        LV_LOG_WARN("couldn't start the rlottie worker, render on the UI thread");
+        rlottie->worker = NULL;
+        pthread_cond_destroy(&w->cond);
+        pthread_mutex_destroy(&w->mutex);
+        lv_mem_free(w);
+    }
 }
 
+/**
+ * Stop the worker thread and wait until it exits
+ * @param rlottie   pointer to an rlottie object
+ */
+static void worker_stop(lv_rlottie_t * rlottie)
+{
+    lv_rlottie_worker_t * w = rlottie->worker;
+    if(w == NULL) return;
+
+    pthread_mutex_lock(&w->mutex);
+    w->quit = true;
+    pthread_cond_broadcast(&w->cond);
+    pthread_mutex_unlock(&w->mutex);
+    pthread_join(w->thread, NULL);
+
+    pthread_cond_destroy(&w->cond);
+    pthread_mutex_destroy(&w->mutex);
+    lv_mem_free(w);
+    rlottie->worker = NULL;
+}
+
+static void * worker_thread(void * arg)
+{
+    lv_rlottie_t * rlottie = arg;
+    lv_rlottie_worker_t * w = rlottie->worker;
+
+    pthread_mutex_lock(&w->mutex);
+    while(!w->quit) {
+        /*Find the first of the next frames which is not rendered yet*/
+        int32_t slot = -1;
+        size_t frame = w->frame;
+        if(!w->ui_rendering && (w->ctrl & LV_RLOTTIE_CTRL_PAUSE) != LV_RLOTTIE_CTRL_PAUSE) {
+            uint32_t k;
+            for(k = 0; k + 1 < rlottie->frame_cnt; k++) {
+                if(!get_next_frame(&frame, rlottie->total_frames, w->ctrl)) break;
+                if(find_frame(rlottie, frame) >= 0) continue;
+                slot = get_free_slot(rlottie, frame, w->frame, w->ctrl);
+                if(slot == (int32_t)rlottie->frame_act) slot = -1;
+                break;
+            }
+        }
+
+        if(slot < 0) {
+            pthread_cond_wait(&w->cond, &w->mutex);
+            continue;
+        }
+
+        rlottie->frames[slot].state = RLOTTIE_FRAME_RENDERING;
+        rlottie->frames[slot].frame = frame;
+        w->rendering = true;
+        pthread_mutex_unlock(&w->mutex);
+
+        render_frame(rlottie, frame, rlottie->frames[slot].buf);
+
+        pthread_mutex_lock(&w->mutex);
+        w->rendering = false;
+        rlottie->frames[slot].state = RLOTTIE_FRAME_READY;
+        pthread_cond_broadcast(&w->cond);
+    }
+    pthread_mutex_unlock(&w->mutex);
+
+    return NULL;
+}
+
+#endif /*LV_RLOTTIE_USE_THREADS*/
+
 #endif /*LV_USE_RLOTTIE*/
@@ -33,6 +33,18 @@ typedef enum {
 
 /** definition in lottieanimation_capi.c */
 struct Lottie_Animation_S;
+
+#if LV_RLOTTIE_USE_THREADS || LV_RLOTTIE_CACHE_SIZE
+/*A frame buffer of the look-ahead ring or of the cache of all frames*/
+typedef struct {
+    uint32_t * buf;
+    size_t frame;           /*The frame rendered into `buf`*/
+    uint8_t state;
+} lv_rlottie_frame_t;
+
+struct _lv_rlottie_worker_t;
+#endif
+
 typedef struct {
     lv_img_t img_ext;
     struct Lottie_Animation_S * animation;
@@ -46,6 +58,15 @@ typedef struct {
     size_t scanline_width;
     lv_rlottie_ctrl_t play_ctrl;
     size_t dest_frame;
+#if LV_RLOTTIE_USE_THREADS || LV_RLOTTIE_CACHE_SIZE
+    lv_rlottie_frame_t * frames;    /*Slices of `allocated_buf`*/
+    uint32_t frame_cnt;
+    uint32_t frame_act;             /*Index of the shown frame buffer*/
+    bool cache_all;                 /*Every frame has its own buffer*/
+#endif
+#if LV_RLOTTIE_USE_THREADS
+    struct _lv_rlottie_worker_t * worker;
+#endif
 } lv_rlottie_t;
 
 extern const lv_obj_class_t lv_rlottie_class;
@@ -51,6 +51,9 @@
 #include "tjpgd.h"
 #include "lv_sjpg.h"
 #include "../../../misc/lv_fs.h"
+#if LV_SJPG_USE_THREADS
+    #include <pthread.h>
+#endif
 
 /*********************
  *      DEFINES
@@ -65,6 +68,16 @@
 #define SJPEG_BLOCK_WIDTH_OFFSET        20
 #define SJPEG_FRAME_INFO_ARRAY_OFFSET   22
 
+#define SJPEG_JOB_QUEUE_SIZE            16
+
+#if LV_SJPG_USE_THREADS
+    #define SJPEG_POOL_LOCK()           pthread_mutex_lock(&pool.mutex)
+    #define SJPEG_POOL_UNLOCK()         pthread_mutex_unlock(&pool.mutex)
+#else
+    #define SJPEG_POOL_LOCK()
+    #define SJPEG_POOL_UNLOCK()
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -86,6 +99,22 @@ typedef struct {
 } io_source_t;
 
 
+enum frag_state {
+    SJPEG_FRAG_EMPTY,
+    SJPEG_FRAG_PENDING,   /*Queued or being decoded by a worker*/
+    SJPEG_FRAG_READY,
+};
+
+/*A decoded fragment in the fragment LRU*/
+typedef struct {
+    int frame_index;                    //-1 if not used
+    uint8_t * data;                     //RGB888 pixels of the fragment
+    uint8_t * src_buf;                  //Compressed fragment read from file for the workers
+    uint32_t src_buf_size;
+    uint32_t last_use;                  //Value of `frag_use_cnt` when last used
+    enum frag_state state;
+} sjpeg_frag_t;
+
 typedef struct {
     uint8_t * sjpeg_data;
     uint32_t sjpeg_data_size;
@@ -96,12 +125,36 @@ typedef struct {
     int sjpeg_cache_frame_index;
     uint8_t ** frame_base_array;        //to save base address of each split frames upto sjpeg_total_frames.
     int * frame_base_offset;            //to save base offset for fseek
-    uint8_t * frame_cache;
+    sjpeg_frag_t * frags;               //LRU of decoded fragments
+    int frag_cnt;
+    uint32_t frag_size;                 //Size of a decoded fragment in bytes
+    uint32_t frag_use_cnt;
+    uint32_t jobs_pending;              //Jobs queued or running in the worker pool
     uint8_t * workb;                    //JPG work buffer for jpeg library
     JDEC * tjpeg_jd;
     io_source_t io;
 } SJPEG;
 
+#if LV_SJPG_USE_THREADS
+/*Decode a fragment from memory into a fragment of the LRU in a worker thread*/
+typedef struct {
+    SJPEG * sjpeg;
+    sjpeg_frag_t * frag;
+    const uint8_t * src;
+    uint32_t src_size;
+} sjpeg_job_t;
+
+typedef struct {
+    pthread_mutex_t mutex;
+    pthread_cond_t job_cond;            //Signaled when a job is queued
+    pthread_cond_t done_cond;           //Broadcasted when a job is finished
+    sjpeg_job_t queue[SJPEG_JOB_QUEUE_SIZE];
+    uint32_t queue_head;
+    uint32_t queue_cnt;
+    bool started;
+} sjpeg_pool_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -114,10 +167,27 @@ static size_t input_func(JDEC * jd, uint8_t * buff, size_t ndata);
 static int is_jpg(const uint8_t * raw_data, size_t len);
 static void lv_sjpg_cleanup(SJPEG * sjpeg);
 static void lv_sjpg_free(SJPEG * sjpeg);
+static bool frag_cache_init(SJPEG * sjpeg);
+static const uint8_t * frag_get(SJPEG * sjpeg, int frame_index);
+static lv_res_t frag_decode(SJPEG * sjpeg, int frame_index, uint8_t * dst);
+static sjpeg_frag_t * frag_evict(SJPEG * sjpeg, int keep_index);
+#if LV_SJPG_USE_THREADS
+static void frag_prefetch(SJPEG * sjpeg, int frame_index, int dir);
+static void frag_jobs_cancel(SJPEG * sjpeg);
+static bool pool_start(void);
+static void * pool_worker(void * arg);
+#endif
 
 /**********************
  *  STATIC VARIABLES
  **********************/
+#if LV_SJPG_USE_THREADS
+static sjpeg_pool_t pool = {
+    .mutex = PTHREAD_MUTEX_INITIALIZER,
+    .job_cond = PTHREAD_COND_INITIALIZER,
+    .done_cond = PTHREAD_COND_INITIALIZER,
+};
+#endif
 
 /**********************
  *      MACROS
@@ -396,13 +466,11 @@ static lv_res_t decoder_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t *
                 sjpeg->frame_base_array[i] = sjpeg->frame_base_array[i - 1] + offset;
             }
             sjpeg->sjpeg_cache_frame_index = -1;
-            sjpeg->frame_cache = (void *)lv_mem_alloc(sjpeg->sjpeg_x_res * sjpeg->sjpeg_single_frame_height * 3/*2*/);
-            if(! sjpeg->frame_cache) {
+            if(!frag_cache_init(sjpeg)) {
                 lv_sjpg_cleanup(sjpeg);
                 sjpeg = NULL;
                 return LV_RES_INV;
             }
-            sjpeg->io.img_cache_buff = sjpeg->frame_cache;
             sjpeg->io.img_cache_x_res = sjpeg->sjpeg_x_res;
             sjpeg->workb =   lv_mem_alloc(TJPGD_WORKBUFF_SIZE);
             if(! sjpeg->workb) {
@@ -459,14 +527,12 @@ static lv_res_t decoder_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t *
                 sjpeg->frame_base_array[0] = img_frame_base;
 
                 sjpeg->sjpeg_cache_frame_index = -1;
-                sjpeg->frame_cache = (void *)lv_mem_alloc(sjpeg->sjpeg_x_res * sjpeg->sjpeg_single_frame_height * 3);
-                if(! sjpeg->frame_cache) {
+                if(!frag_cache_init(sjpeg)) {
                     lv_sjpg_cleanup(sjpeg);
                     sjpeg = NULL;
                     return LV_RES_INV;
                 }
 
-                sjpeg->io.img_cache_buff = sjpeg->frame_cache;
                 sjpeg->io.img_cache_x_res = sjpeg->sjpeg_x_res;
                 sjpeg->workb =   lv_mem_alloc(TJPGD_WORKBUFF_SIZE);
                 if(! sjpeg->workb) {
@@ -536,8 +602,6 @@ end:
                     memset(sjpeg, 0, sizeof(SJPEG));
 
                     dsc->user_data = sjpeg;
-                    sjpeg->sjpeg_data = (uint8_t *)((lv_img_dsc_t *)(dsc->src))->data;
-                    sjpeg->sjpeg_data_size = ((lv_img_dsc_t *)(dsc->src))->data_size;
                 }
                 data = buff;
                 data += 14;
@@ -577,14 +641,16 @@ end:
                     sjpeg->frame_base_offset[i] = sjpeg->frame_base_offset[i - 1] + offset;
                 }
 
+                /*The file size is required to know the size of the last fragment*/
+                lv_fs_seek(&lv_file, 0, LV_FS_SEEK_END);
+                lv_fs_tell(&lv_file, &sjpeg->sjpeg_data_size);
+
                 sjpeg->sjpeg_cache_frame_index = -1; //INVALID AT BEGINNING for a forced compare mismatch at first time.
-                sjpeg->frame_cache = (void *)lv_mem_alloc(sjpeg->sjpeg_x_res * sjpeg->sjpeg_single_frame_height * 3);
-                if(! sjpeg->frame_cache) {
+                if(!frag_cache_init(sjpeg)) {
                     lv_fs_close(&lv_file);
                     lv_sjpg_cleanup(sjpeg);
                     return LV_RES_INV;
                 }
-                sjpeg->io.img_cache_buff = sjpeg->frame_cache;
                 sjpeg->io.img_cache_x_res = sjpeg->sjpeg_x_res;
                 sjpeg->workb =   lv_mem_alloc(TJPGD_WORKBUFF_SIZE);
                 if(! sjpeg->workb) {
@@ -624,8 +690,6 @@ end:
 
                 memset(sjpeg, 0, sizeof(SJPEG));
                 dsc->user_data = sjpeg;
-                sjpeg->sjpeg_data = (uint8_t *)((lv_img_dsc_t *)(dsc->src))->data;
-                sjpeg->sjpeg_data_size = ((lv_img_dsc_t *)(dsc->src))->data_size;
             }
 
             uint8_t * workb_temp = lv_mem_alloc(TJPGD_WORKBUFF_SIZE);
@@ -666,14 +730,12 @@ end:
                 sjpeg->frame_base_offset[0] = img_frame_start_offset;
 
                 sjpeg->sjpeg_cache_frame_index = -1;
-                sjpeg->frame_cache = (void *)lv_mem_alloc(sjpeg->sjpeg_x_res * sjpeg->sjpeg_single_frame_height * 3);
-                if(! sjpeg->frame_cache) {
+                if(!frag_cache_init(sjpeg)) {
                     lv_fs_close(&lv_file);
                     lv_sjpg_cleanup(sjpeg);
                     return LV_RES_INV;
                 }
 
-                sjpeg->io.img_cache_buff = sjpeg->frame_cache;
                 sjpeg->io.img_cache_x_res = sjpeg->sjpeg_x_res;
                 sjpeg->workb =   lv_mem_alloc(TJPGD_WORKBUFF_SIZE);
                 if(! sjpeg->workb) {
@@ -722,143 +784,57 @@ static lv_res_t decoder_read_line(lv_img_decoder_t * decoder, lv_img_decoder_dsc
                                   lv_coord_t len, uint8_t * buf)
 {
     LV_UNUSED(decoder);
-    if(dsc->src_type == LV_IMG_SRC_VARIABLE) {
-        SJPEG * sjpeg = (SJPEG *) dsc->user_data;
-        JRESULT rc;
-
-        int sjpeg_req_frame_index = y / sjpeg->sjpeg_single_frame_height;
-
-        /*If line not from cache, refresh cache */
-        if(sjpeg_req_frame_index != sjpeg->sjpeg_cache_frame_index) {
-            sjpeg->io.raw_sjpg_data = sjpeg->frame_base_array[ sjpeg_req_frame_index ];
-            if(sjpeg_req_frame_index == (sjpeg->sjpeg_total_frames - 1)) {
-                /*This is the last frame. */
-                const uint32_t frame_offset = (uint32_t)(sjpeg->io.raw_sjpg_data - sjpeg->sjpeg_data);
-                sjpeg->io.raw_sjpg_data_size = sjpeg->sjpeg_data_size - frame_offset;
-            }
-            else {
-                sjpeg->io.raw_sjpg_data_size =
-                    (uint32_t)(sjpeg->frame_base_array[sjpeg_req_frame_index + 1] - sjpeg->io.raw_sjpg_data);
-            }
-            sjpeg->io.raw_sjpg_data_next_read_pos = 0;
-            rc = jd_prepare(sjpeg->tjpeg_jd, input_func, sjpeg->workb, (size_t)TJPGD_WORKBUFF_SIZE, &(sjpeg->io));
-            if(rc != JDR_OK) return LV_RES_INV;
-            rc = jd_decomp(sjpeg->tjpeg_jd, img_data_cb, 0);
-            if(rc != JDR_OK) return LV_RES_INV;
-            sjpeg->sjpeg_cache_frame_index = sjpeg_req_frame_index;
-        }
-
-        int offset = 0;
-        uint8_t * cache = (uint8_t *)sjpeg->frame_cache + x * 3 + (y % sjpeg->sjpeg_single_frame_height) * sjpeg->sjpeg_x_res *
-                          3;
-
-#if  LV_COLOR_DEPTH == 32
-        for(int i = 0; i < len; i++) {
-            buf[offset + 3] = 0xff;
-            buf[offset + 2] = *cache++;
-            buf[offset + 1] = *cache++;
-            buf[offset + 0] = *cache++;
-            offset += 4;
-        }
-
-#elif  LV_COLOR_DEPTH == 16
-
-        for(int i = 0; i < len; i++) {
-            uint16_t col_16bit = (*cache++ & 0xf8) << 8;
-            col_16bit |= (*cache++ & 0xFC) << 3;
-            col_16bit |= (*cache++ >> 3);
-#if  LV_BIG_ENDIAN_SYSTEM == 1 || LV_COLOR_16_SWAP == 1
-            buf[offset++] = col_16bit >> 8;
-            buf[offset++] = col_16bit & 0xff;
-#else
-            buf[offset++] = col_16bit & 0xff;
-            buf[offset++] = col_16bit >> 8;
-#endif // LV_BIG_ENDIAN_SYSTEM
-        }
-
-#elif  LV_COLOR_DEPTH == 8
-
-        for(int i = 0; i < len; i++) {
-            uint8_t col_8bit = (*cache++ & 0xC0);
-            col_8bit |= (*cache++ & 0xe0) >> 2;
-            col_8bit |= (*cache++ & 0xe0) >> 5;
-            buf[offset++] = col_8bit;
-        }
-#else
-#error Unsupported LV_COLOR_DEPTH
-
-
-#endif // LV_COLOR_DEPTH
-        return LV_RES_OK;
-    }
-    else if(dsc->src_type == LV_IMG_SRC_FILE) {
-        SJPEG * sjpeg = (SJPEG *) dsc->user_data;
-        JRESULT rc;
-        int sjpeg_req_frame_index = y / sjpeg->sjpeg_single_frame_height;
-
-        lv_fs_file_t * lv_file_p = &(sjpeg->io.lv_file);
-        if(!lv_file_p) goto end;
+    if(dsc->src_type != LV_IMG_SRC_VARIABLE && dsc->src_type != LV_IMG_SRC_FILE) return LV_RES_INV;
 
-        /*If line not from cache, refresh cache */
-        if(sjpeg_req_frame_index != sjpeg->sjpeg_cache_frame_index) {
-            sjpeg->io.raw_sjpg_data_next_read_pos = (int)(sjpeg->frame_base_offset [ sjpeg_req_frame_index ]);
-            lv_fs_seek(&(sjpeg->io.lv_file), sjpeg->io.raw_sjpg_data_next_read_pos, LV_FS_SEEK_SET);
-
-            rc = jd_prepare(sjpeg->tjpeg_jd, input_func, sjpeg->workb, (size_t)TJPGD_WORKBUFF_SIZE, &(sjpeg->io));
-            if(rc != JDR_OK) return LV_RES_INV;
+    SJPEG * sjpeg = (SJPEG *) dsc->user_data;
+    if(!sjpeg) return LV_RES_INV;
 
-            rc = jd_decomp(sjpeg->tjpeg_jd, img_data_cb, 0);
-            if(rc != JDR_OK) return LV_RES_INV;
+    int sjpeg_req_frame_index = y / sjpeg->sjpeg_single_frame_height;
 
-            sjpeg->sjpeg_cache_frame_index = sjpeg_req_frame_index;
-        }
+    /*Get the fragment from the LRU or decode it now*/
+    const uint8_t * cache = frag_get(sjpeg, sjpeg_req_frame_index);
+    if(!cache) return LV_RES_INV;
 
-        int offset = 0;
-        uint8_t * cache = (uint8_t *)sjpeg->frame_cache + x * 3 + (y % sjpeg->sjpeg_single_frame_height) * sjpeg->sjpeg_x_res *
-                          3;
+    int offset = 0;
+    cache += x * 3 + (y % sjpeg->sjpeg_single_frame_height) * sjpeg->sjpeg_x_res * 3;
 
 #if LV_COLOR_DEPTH == 32
-        for(int i = 0; i < len; i++) {
-            buf[offset + 3] = 0xff;
-            buf[offset + 2] = *cache++;
-            buf[offset + 1] = *cache++;
-            buf[offset + 0] = *cache++;
-            offset += 4;
-        }
+    for(int i = 0; i < len; i++) {
+        buf[offset + 3] = 0xff;
+        buf[offset + 2] = *cache++;
+        buf[offset + 1] = *cache++;
+        buf[offset + 0] = *cache++;
+        offset += 4;
+    }
 #elif  LV_COLOR_DEPTH == 16
 
-        for(int i = 0; i < len; i++) {
-            uint16_t col_8bit = (*cache++ & 0xf8) << 8;
-            col_8bit |= (*cache++ & 0xFC) << 3;
-            col_8bit |= (*cache++ >> 3);
+    for(int i = 0; i < len; i++) {
+        uint16_t col_16bit = (*cache++ & 0xf8) << 8;
+        col_16bit |= (*cache++ & 0xFC) << 3;
+        col_16bit |= (*cache++ >> 3);
 #if  LV_BIG_ENDIAN_SYSTEM == 1 || LV_COLOR_16_SWAP == 1
-            buf[offset++] = col_8bit >> 8;
-            buf[offset++] = col_8bit & 0xff;
+        buf[offset++] = col_16bit >> 8;
+        buf[offset++] = col_16bit & 0xff;
 #else
-            buf[offset++] = col_8bit & 0xff;
-            buf[offset++] = col_8bit >> 8;
+        buf[offset++] = col_16bit & 0xff;
+        buf[offset++] = col_16bit >> 8;
 #endif // LV_BIG_ENDIAN_SYSTEM
-        }
+    }
 
 #elif  LV_COLOR_DEPTH == 8
 
-        for(int i = 0; i < len; i++) {
-            uint8_t col_8bit = (*cache++ & 0xC0);
-            col_8bit |= (*cache++ & 0xe0) >> 2;
-            col_8bit |= (*cache++ & 0xe0) >> 5;
-            buf[offset++] = col_8bit;
-        }
-
+    for(int i = 0; i < len; i++) {
+        uint8_t col_8bit = (*cache++ & 0xC0);
+        col_8bit |= (*cache++ & 0xe0) >> 2;
+        col_8bit |= (*cache++ & 0xe0) >> 5;
+        buf[offset++] = col_8bit;
+    }
 #else
 #error Unsupported LV_COLOR_DEPTH
 
 
 #endif // LV_COLOR_DEPTH
-
-        return LV_RES_OK;
-    }
-end:
-    return LV_RES_INV;
+    return LV_RES_OK;
 }
 
 /**
@@ -873,6 +849,11 @@ static void decoder_close(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc
     SJPEG * sjpeg = (SJPEG *) dsc->user_data;
     if(!sjpeg) return;
 
+#if LV_SJPG_USE_THREADS
+    /*The workers might still write into the fragments*/
+    frag_jobs_cancel(sjpeg);
+#endif
+
     switch(dsc->src_type) {
         case LV_IMG_SRC_FILE:
             if(sjpeg->io.lv_file.file_d) {
@@ -899,7 +880,13 @@ static int is_jpg(const uint8_t * raw_data, size_t len)
 
 static void lv_sjpg_free(SJPEG * sjpeg)
 {
-    if(sjpeg->frame_cache) lv_mem_free(sjpeg->frame_cache);
+    if(sjpeg->frags) {
+        for(int i = 0; i < sjpeg->frag_cnt; i++) {
+            if(sjpeg->frags[i].data) lv_mem_free(sjpeg->frags[i].data);
+            if(sjpeg->frags[i].src_buf) lv_mem_free(sjpeg->frags[i].src_buf);
+        }
+        lv_mem_free(sjpeg->frags);
+    }
     if(sjpeg->frame_base_array) lv_mem_free(sjpeg->frame_base_array);
     if(sjpeg->frame_base_offset) lv_mem_free(sjpeg->frame_base_offset);
     if(sjpeg->tjpeg_jd) lv_mem_free(sjpeg->tjpeg_jd);
@@ -914,4 +901,351 @@ static void lv_sjpg_cleanup(SJPEG * sjpeg)
     lv_mem_free(sjpeg);
 }
 
+/**
+ * Create the LRU of decoded fragments.
+ * As many fragments are cached as fit into `LV_SJPG_FRAG_CACHE_SIZE` but at least one.
+ * The fragment buffers are allocated only when they are used first.
+ * @param sjpeg the image whose resolution and fragment height are already set
+ * @return true: success; false: out of memory
+ */
+static bool frag_cache_init(SJPEG * sjpeg)
+{
+    sjpeg->frag_size = (uint32_t)sjpeg->sjpeg_x_res * sjpeg->sjpeg_single_frame_height * 3;
+
+    int cnt = sjpeg->frag_size ? (int)(LV_SJPG_FRAG_CACHE_SIZE / sjpeg->frag_size) : 1;
+    if(cnt < 1) cnt = 1;
+    if(cnt > sjpeg->sjpeg_total_frames) cnt = sjpeg->sjpeg_total_frames;
+
+    sjpeg->frags = lv_mem_alloc(sizeof(sjpeg_frag_t) * cnt);
+    if(!sjpeg->frags) return false;
+    memset(sjpeg->frags, 0, sizeof(sjpeg_frag_t) * cnt);
+    for(int i = 0; i < cnt; i++) {
+        sjpeg->frags[i].frame_index = -1;
+    }
+    sjpeg->frag_cnt = cnt;
+    sjpeg->io.img_cache_x_res = sjpeg->sjpeg_x_res;
+
+    return true;
+}
+
+/**
+ * Get the decoded pixels of a fragment.
+ * Use the LRU if possible, wait for the worker if the fragment is being prefetched,
+ * or decode it now. Then prefetch the next fragments in the direction of the reading.
+ * @param sjpeg the image
+ * @param frame_index index of the fragment
+ * @return the RGB888 pixels of the fragment or NULL on error
+ */
+static const uint8_t * frag_get(SJPEG * sjpeg, int frame_index)
+{
+    if(frame_index < 0 || frame_index >= sjpeg->sjpeg_total_frames) return NULL;
+
+    sjpeg->frag_use_cnt++;
+
+    sjpeg_frag_t * frag = NULL;
+    for(int i = 0; i < sjpeg->frag_cnt; i++) {
+        if(sjpeg->frags[i].frame_index == frame_index) {
+            frag = &sjpeg->frags[i];
+            break;
+        }
+    }
+
+    enum frag_state state = SJPEG_FRAG_EMPTY;
+    if(frag) {
+        SJPEG_POOL_LOCK();
+#if LV_SJPG_USE_THREADS
+        while(frag->state == SJPEG_FRAG_PENDING) {
+            pthread_cond_wait(&pool.done_cond, &pool.mutex);
+        }
+#endif
+        state = frag->state;
+        SJPEG_POOL_UNLOCK();
+    }
+
+    if(state != SJPEG_FRAG_READY) {
+        if(!frag) frag = frag_evict(sjpeg, -1);
+        if(!frag) return NULL;
+
+        if(!frag->data) {
+            frag->data = lv_mem_alloc(sjpeg->frag_size);
+            if(!frag->data) return NULL;
+        }
+
+        frag->frame_index = -1;
+        if(frag_decode(sjpeg, frame_index, frag->data) != LV_RES_OK) return NULL;
+        frag->frame_index = frame_index;
+        frag->state = SJPEG_FRAG_READY;
+    }
+
+    frag->last_use = sjpeg->frag_use_cnt;
+
+    if(frame_index != sjpeg->sjpeg_cache_frame_index) {
+#if LV_SJPG_USE_THREADS
+        int dir = frame_index >= sjpeg->sjpeg_cache_frame_index ? 1 : -1;
+        frag_prefetch(sjpeg, frame_index, dir);
+#endif
+        sjpeg->sjpeg_cache_frame_index = frame_index;
+    }
+
+    return frag->data;
+}
+
+/**
+ * Decode a fragment in the caller's thread
+ * @param sjpeg the image
+ * @param frame_index index of the fragment
+ * @param dst store the RGB888 pixels here
+ * @return LV_RES_OK: success; LV_RES_INV: decoding failed
+ */
+static lv_res_t frag_decode(SJPEG * sjpeg, int frame_index, uint8_t * dst)
+{
+    JRESULT rc;
+
+    if(sjpeg->io.type == SJPEG_IO_SOURCE_C_ARRAY) {
+        sjpeg->io.raw_sjpg_data = sjpeg->frame_base_array[frame_index];
+        if(frame_index == (sjpeg->sjpeg_total_frames - 1)) {
+            /*This is the last frame. */
+            const uint32_t frame_offset = (uint32_t)(sjpeg->io.raw_sjpg_data - sjpeg->sjpeg_data);
+            sjpeg->io.raw_sjpg_data_size = sjpeg->sjpeg_data_size - frame_offset;
+        }
+        else {
+            sjpeg->io.raw_sjpg_data_size =
+                (uint32_t)(sjpeg->frame_base_array[frame_index + 1] - sjpeg->io.raw_sjpg_data);
+        }
+        sjpeg->io.raw_sjpg_data_next_read_pos = 0;
+    }
+    else {
+        sjpeg->io.raw_sjpg_data_next_read_pos = (int)(sjpeg->frame_base_offset[frame_index]);
+        lv_fs_seek(&(sjpeg->io.lv_file), sjpeg->io.raw_sjpg_data_next_read_pos, LV_FS_SEEK_SET);
+    }
+
+    sjpeg->io.img_cache_buff = dst;
+    rc = jd_prepare(sjpeg->tjpeg_jd, input_func, sjpeg->workb, (size_t)TJPGD_WORKBUFF_SIZE, &(sjpeg->io));
+    if(rc != JDR_OK) return LV_RES_INV;
+    rc = jd_decomp(sjpeg->tjpeg_jd, img_data_cb, 0);
+    if(rc != JDR_OK) return LV_RES_INV;
+
+    return LV_RES_OK;
+}
+
+/**
+ * Find the least recently used fragment which can be reused.
+ * Fragments being decoded by a worker are skipped.
+ * @param sjpeg the image
+ * @param keep_index don't evict the fragment with this index
+ * @return a fragment or NULL if all fragments are busy
+ */
+static sjpeg_frag_t * frag_evict(SJPEG * sjpeg, int keep_index)
+{
+    sjpeg_frag_t * oldest = NULL;
+
+    SJPEG_POOL_LOCK();
+    for(int i = 0; i < sjpeg->frag_cnt; i++) {
+        sjpeg_frag_t * frag = &sjpeg->frags[i];
+        if(frag->state == SJPEG_FRAG_PENDING) continue;
+        if(frag->frame_index >= 0 && frag->frame_index == keep_index) continue;
+        if(oldest == NULL || frag->frame_index < 0 || frag->last_use < oldest->last_use) {
+            oldest = frag;
+            if(frag->frame_index < 0) break;
+        }
+    }
+    if(oldest) oldest->state = SJPEG_FRAG_EMPTY;
+    SJPEG_POOL_UNLOCK();
+
+    return oldest;
+}
+
+#if LV_SJPG_USE_THREADS
+
+/**
+ * Queue the decoding of the fragments following `frame_index` in the direction of the reading.
+ * Can't use more fragments than the LRU has beside the current one.
+ * @param sjpeg the image
+ * @param frame_index the fragment being read now
+ * @param dir 1: the image is read downwards; -1: upwards
+ */
+static void frag_prefetch(SJPEG * sjpeg, int frame_index, int dir)
+{
+    int cnt = LV_MIN(LV_SJPG_PREFETCH_CNT, sjpeg->frag_cnt - 1);
+    if(cnt <= 0) return;
+    if(!pool_start()) return;
+
+    for(int i = 1; i <= cnt; i++) {
+        int prefetch_index = frame_index + dir * i;
+        if(prefetch_index < 0 || prefetch_index >= sjpeg->sjpeg_total_frames) break;
+
+        bool cached = false;
+        for(int j = 0; j < sjpeg->frag_cnt; j++) {
+            if(sjpeg->frags[j].frame_index == prefetch_index) {
+                cached = true;
+                break;
+            }
+        }
+        if(cached) continue;
+
+        sjpeg_frag_t * frag = frag_evict(sjpeg, frame_index);
+        if(!frag) break;
+        frag->frame_index = -1;
+
+        if(!frag->data) {
+            frag->data = lv_mem_alloc(sjpeg->frag_size);
+            if(!frag->data) break;
+        }
+
+        /*The workers don't access the file system so load the compressed fragment here*/
+        const uint8_t * src;
+        uint32_t src_size;
+        if(sjpeg->io.type == SJPEG_IO_SOURCE_C_ARRAY) {
+            src = sjpeg->frame_base_array[prefetch_index];
+            if(prefetch_index == sjpeg->sjpeg_total_frames - 1) {
+                src_size = sjpeg->sjpeg_data_size - (uint32_t)(src - sjpeg->sjpeg_data);
+            }
+            else {
+                src_size = (uint32_t)(sjpeg->frame_base_array[prefetch_index + 1] - src);
+            }
+        }
+        else {
+            uint32_t start = sjpeg->frame_base_offset[prefetch_index];
+            uint32_t end = prefetch_index == sjpeg->sjpeg_total_frames - 1 ? sjpeg->sjpeg_data_size :
+                           (uint32_t)sjpeg->frame_base_offset[prefetch_index + 1];
+            if(end <= start) break;
+            src_size = end - start;
+            if(frag->src_buf_size < src_size) {
+                uint8_t * new_buf = lv_mem_realloc(frag->src_buf, src_size);
+                if(!new_buf) break;
+                frag->src_buf = new_buf;
+                frag->src_buf_size = src_size;
+            }
+
+            uint32_t rn = 0;
+            lv_fs_seek(&sjpeg->io.lv_file, start, LV_FS_SEEK_SET);
+            lv_fs_res_t res = lv_fs_read(&sjpeg->io.lv_file, frag->src_buf, src_size, &rn);
+            if(res != LV_FS_RES_OK || rn != src_size) break;
+            src = frag->src_buf;
+        }
+
+        SJPEG_POOL_LOCK();
+        if(pool.queue_cnt >= SJPEG_JOB_QUEUE_SIZE) {
+            SJPEG_POOL_UNLOCK();
+            break;
+        }
+        sjpeg_job_t * job = &pool.queue[(pool.queue_head + pool.queue_cnt) % SJPEG_JOB_QUEUE_SIZE];
+        job->sjpeg = sjpeg;
+        job->frag = frag;
+        job->src = src;
+        job->src_size = src_size;
+        pool.queue_cnt++;
+        sjpeg->jobs_pending++;
+        frag->frame_index = prefetch_index;
+        frag->last_use = sjpeg->frag_use_cnt;
+        frag->state = SJPEG_FRAG_PENDING;
+        pthread_cond_signal(&pool.job_cond);
+        SJPEG_POOL_UNLOCK();
+    }
+}
+
+/**
+ * Drop the queued jobs of an image and wait until the running ones finish
+ * @param sjpeg the image
+ */
+static void frag_jobs_cancel(SJPEG * sjpeg)
+{
+    SJPEG_POOL_LOCK();
+    uint32_t kept = 0;
+    for(uint32_t i = 0; i < pool.queue_cnt; i++) {
+        sjpeg_job_t * job = &pool.queue[(pool.queue_head + i) % SJPEG_JOB_QUEUE_SIZE];
+        if(job->sjpeg == sjpeg) {
+            job->frag->state = SJPEG_FRAG_EMPTY;
+            job->frag->frame_index = -1;
+            sjpeg->jobs_pending--;
+        }
+        else {
+            pool.queue[(pool.queue_head + kept) % SJPEG_JOB_QUEUE_SIZE] = *job;
+            kept++;
+        }
+    }
+    pool.queue_cnt = kept;
+
+    while(sjpeg->jobs_pending > 0) {
+        pthread_cond_wait(&pool.done_cond, &pool.mutex);
+    }
+    SJPEG_POOL_UNLOCK();
+}
+
+/**
+ * Start the worker threads if they are not running yet.
+ * Each worker gets its own TJPGD context allocated here as the workers can't use `lv_mem`.
+ * @return true: the workers are running
+ */
+static bool pool_start(void)
+{
+    if(pool.started) return true;
+
+    int started_cnt = 0;
+    for(int i = 0; i < LV_SJPG_THREAD_CNT; i++) {
+        JDEC * jd = lv_mem_alloc(sizeof(JDEC) + TJPGD_WORKBUFF_SIZE);
+        if(!jd) break;
+
+        pthread_t thread;
+        if(pthread_create(&thread, NULL, pool_worker, jd) != 0) {
+            lv_mem_free(jd);
+            break;
+        }
+        pthread_detach(thread);
+        started_cnt++;
+    }
+
+    if(started_cnt == 0) {
+        LV_LOG_WARN("couldn't start the SJPG workers");
+        return false;
+    }
+
+    pool.started = true;
+    return true;
+}
+
+static void * pool_worker(void * arg)
+{
+    JDEC * jd = arg;
+    uint8_t * workb = (uint8_t *)(jd + 1);
+
+    SJPEG_POOL_LOCK();
+    while(1) {
+        while(pool.queue_cnt == 0) {
+            pthread_cond_wait(&pool.job_cond, &pool.mutex);
+        }
+
+        sjpeg_job_t job = pool.queue[pool.queue_head];
+        pool.queue_head = (pool.queue_head + 1) % SJPEG_JOB_QUEUE_SIZE;
+        pool.queue_cnt--;
+        SJPEG_POOL_UNLOCK();
+
+        io_source_t io;
+        memset(&io, 0, sizeof(io));
+        io.type = SJPEG_IO_SOURCE_C_ARRAY;
+        io.raw_sjpg_data = (uint8_t *)job.src;
+        io.raw_sjpg_data_size = job.src_size;
+        io.img_cache_buff = job.frag->data;
+        io.img_cache_x_res = job.sjpeg->sjpeg_x_res;
+
+        JRESULT rc = jd_prepare(jd, input_func, workb, (size_t)TJPGD_WORKBUFF_SIZE, &io);
+        if(rc == JDR_OK) rc = jd_decomp(jd, img_data_cb, 0);
+
+        SJPEG_POOL_LOCK();
+        if(rc == JDR_OK) {
+            job.frag->state = SJPEG_FRAG_READY;
+        }
+        else {
+            /*Will be decoded again when it's needed*/
+            job.frag->state = SJPEG_FRAG_EMPTY;
+        }
+        job.sjpeg->jobs_pending--;
+        pthread_cond_broadcast(&pool.done_cond);
+    }
+
+    return NULL;
+}
+
+#endif /*LV_SJPG_USE_THREADS*/
+
 #endif /*LV_USE_SJPG*/
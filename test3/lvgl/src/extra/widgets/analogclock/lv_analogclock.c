@@ -16,6 +16,10 @@
 #if LV_USE_ANALOGCLOCK != 0
 
 #include "../../../misc/lv_assert.h"
+#if LV_ANALOGCLOCK_CACHE_SCALE
+    #include "../../../misc/lv_gc.h"
+    #include "../../../draw/sw/lv_draw_sw.h"
+#endif
 
 /*********************
  *      DEFINES
@@ -37,6 +41,12 @@ static void draw_ticks_and_labels(lv_obj_t * obj, lv_draw_ctx_t * draw_ctx, cons
 static void draw_needles(lv_obj_t * obj, lv_draw_ctx_t * draw_ctx, const lv_area_t * scale_area);
 static void inv_arc(lv_obj_t * obj, lv_analogclock_indicator_t * indic, int32_t old_value, int32_t new_value);
 static void inv_line(lv_obj_t * obj, lv_analogclock_indicator_t * indic, int32_t value);
+static void inv_scale(lv_obj_t * obj);
+#if LV_ANALOGCLOCK_CACHE_SCALE
+static void get_scale_cache_area(lv_obj_t * obj, lv_area_t * area);
+static bool render_scale_cache(lv_obj_t * obj, const lv_area_t * scale_area);
+static void free_scale_cache(lv_obj_t * obj);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -105,6 +115,7 @@ lv_analogclock_scale_t * lv_analogclock_add_scale(lv_obj_t * obj)
     scale->max = 60;
     scale->rotation = 270;
 
+    inv_scale(obj);
     return scale;
 }
 
@@ -115,7 +126,7 @@ void lv_analogclock_set_ticks(lv_obj_t * obj, uint16_t width, uint16_t len, lv_c
     scale->tick_width = width;
     scale->tick_length = len;
     scale->tick_color = color;
-    lv_obj_invalidate(obj);
+    inv_scale(obj);
 }
 
 void lv_analogclock_set_major_ticks(lv_obj_t * obj, uint16_t width, uint16_t len, lv_color_t color, int16_t label_gap)
@@ -126,7 +137,7 @@ void lv_analogclock_set_major_ticks(lv_obj_t * obj, uint16_t width, uint16_t len
     scale->tick_major_length = len;
     scale->tick_major_color = color;
     scale->label_gap = label_gap;
-    lv_obj_invalidate(obj);
+    inv_scale(obj);
 }
 
 void lv_analogclock_set_scale_range(lv_obj_t * obj, lv_analogclock_scale_t * scale, int32_t min, int32_t max,
@@ -137,7 +148,7 @@ void lv_analogclock_set_scale_range(lv_obj_t * obj, lv_analogclock_scale_t * sca
     scale->max = max;
     scale->angle_range = angle_range;
     scale->rotation = rotation;
-    lv_obj_invalidate(obj);
+    inv_scale(obj);
 }
 
 /*=====================
@@ -264,7 +275,7 @@ lv_analogclock_indicator_t * lv_analogclock_add_scale_lines(lv_obj_t * obj,  lv_
     indic->type_data.scale_lines.local_grad = local;
     indic->type_data.scale_lines.width_mod = width_mod;
 
-    lv_obj_invalidate(obj);
+    inv_scale(obj);
     return indic;
 }
 
@@ -276,12 +287,14 @@ void lv_analogclock_hide_digits(lv_obj_t * obj, bool hide_digits)
     lv_analogclock_t * analogclock = (lv_analogclock_t *)obj;
     lv_analogclock_scale_t * scale = analogclock->scale;
     scale->hide_label = hide_digits;
+    inv_scale(obj);
 }
 
 void lv_analogclock_hide_point(lv_obj_t * obj, bool hide_point)
 {
     lv_analogclock_t * analogclock = (lv_analogclock_t *)obj;
     analogclock->hide_point = hide_point;
+    lv_obj_invalidate(obj);
 }
 
 /*=====================
@@ -306,7 +319,7 @@ void lv_analogclock_set_indicator_value(lv_obj_t * obj, lv_analogclock_indicator
         inv_line(obj, indic, value);
     }
     else {
-        lv_obj_invalidate(obj);
+        inv_scale(obj);
     }
 }
 
@@ -324,7 +337,7 @@ void lv_analogclock_set_indicator_start_value(lv_obj_t * obj, lv_analogclock_ind
         inv_line(obj, indic, value);
     }
     else {
-        lv_obj_invalidate(obj);
+        inv_scale(obj);
     }
 }
 
@@ -342,7 +355,7 @@ void lv_analogclock_set_indicator_end_value(lv_obj_t * obj, lv_analogclock_indic
         inv_line(obj, indic, value);
     }
     else {
-        lv_obj_invalidate(obj);
+        inv_scale(obj);
     }
 }
 
@@ -354,6 +367,16 @@ void lv_analogclock_set_time(lv_obj_t * obj, int32_t hour, int32_t min, int32_t
     lv_analogclock_set_indicator_value(obj, analogclock->sec_indic, sec);
 }
 
+/*=====================
+ * Other functions
+ *====================*/
+
+void lv_analogclock_refresh_scale(lv_obj_t * obj)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    inv_scale(obj);
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -380,7 +403,9 @@ static void lv_analogclock_destructor(const lv_obj_class_t * class_p, lv_obj_t *
     lv_analogclock_t * analogclock = (lv_analogclock_t *)obj;
     _lv_ll_clear(&analogclock->indicator_ll);
     _lv_ll_clear(&analogclock->scale_ll);
-
+#if LV_ANALOGCLOCK_CACHE_SCALE
+    free_scale_cache(obj);
+#endif
 }
 
 static void lv_analogclock_event(const lv_obj_class_t * class_p, lv_event_t * e)
@@ -399,7 +424,21 @@ static void lv_analogclock_event(const lv_obj_class_t * class_p, lv_event_t * e)
         lv_obj_get_content_coords(obj, &scale_area);
 
         draw_arcs(obj, draw_ctx, &scale_area);
+#if LV_ANALOGCLOCK_CACHE_SCALE
+        /*Blit the pre-rendered ticks and labels. Draw them directly if there is no memory for the layer.*/
+        if(render_scale_cache(obj, &scale_area)) {
+            lv_area_t cache_area;
+            get_scale_cache_area(obj, &cache_area);
+            lv_draw_img_dsc_t img_dsc;
+            lv_draw_img_dsc_init(&img_dsc);
+            lv_draw_img(draw_ctx, &img_dsc, &cache_area, &analogclock->scale_cache);
+        }
+        else {
+            draw_ticks_and_labels(obj, draw_ctx, &scale_area);
+        }
+#else
         draw_ticks_and_labels(obj, draw_ctx, &scale_area);
+#endif
         draw_needles(obj, draw_ctx, &scale_area);
 
         if(!analogclock->hide_point) {
@@ -421,6 +460,11 @@ static void lv_analogclock_event(const lv_obj_class_t * class_p, lv_event_t * e)
             lv_draw_rect(draw_ctx, &mid_dsc, &nm_cord);
         }
     }
+#if LV_ANALOGCLOCK_CACHE_SCALE
+    else if(code == LV_EVENT_STYLE_CHANGED || code == LV_EVENT_SIZE_CHANGED) {
+        free_scale_cache(obj);
+    }
+#endif
 }
 
 static void draw_arcs(lv_obj_t * obj, lv_draw_ctx_t * draw_ctx, const lv_area_t * scale_area)
@@ -806,4 +850,115 @@ static void inv_line(lv_obj_t * obj, lv_analogclock_indicator_t * indic, int32_t
         lv_obj_invalidate_area(obj, &a);
     }
 }
+/**
+ * Redraw the whole analogclock because the ticks or labels have changed
+ * @param obj       pointer to a analogclock object
+ */
+static void inv_scale(lv_obj_t * obj)
+{
+#if LV_ANALOGCLOCK_CACHE_SCALE
+    free_scale_cache(obj);
+#endif
+    lv_obj_invalidate(obj);
+}
+
+#if LV_ANALOGCLOCK_CACHE_SCALE
+/**
+ * Get the area covered by the cached layer. Drawing is clipped to this area anyway.
+ * @param obj       pointer to a analogclock object
+ * @param area      store the area here
+ */
+static void get_scale_cache_area(lv_obj_t * obj, lv_area_t * area)
+{
+    lv_coord_t ext_size = _lv_obj_get_ext_draw_size(obj);
+    lv_obj_get_coords(obj, area);
+    lv_area_increase(area, ext_size, ext_size);
+}
+
+/**
+ * Render the ticks and labels into the cached layer if it's not rendered yet.
+ * It's drawn like `lv_snapshot` does: with a software draw context to an ARGB buffer.
+ * @param obj           pointer to a analogclock object
+ * @param scale_area    the content area of the analogclock
+ * @return              true: the layer is ready; false: out of memory
+ */
+static bool render_scale_cache(lv_obj_t * obj, const lv_area_t * scale_area)
+{
+    lv_analogclock_t * analogclock = (lv_analogclock_t *)obj;
+    if(analogclock->scale_cache.data) return true;
+    if(analogclock->scale_cache_failed) return false;
+
+    lv_area_t cache_area;
+    get_scale_cache_area(obj, &cache_area);
+    lv_coord_t w = lv_area_get_width(&cache_area);
+    lv_coord_t h = lv_area_get_height(&cache_area);
+    if(w <= 0 || h <= 0) return false;
+
+    uint32_t buf_size = (uint32_t)w * h * LV_IMG_PX_SIZE_ALPHA_BYTE;
+    uint8_t * buf = lv_mem_alloc(buf_size);
+    if(buf == NULL) {
+        LV_LOG_WARN("couldn't allocate the scale cache, drawing the ticks directly");
+        analogclock->scale_cache_failed = true;
+        return false;
+    }
+    lv_memset_00(buf, buf_size);
+
+    lv_disp_drv_t driver;
+    lv_disp_drv_init(&driver);
+    driver.hor_res = w;
+    driver.ver_res = h;
+    lv_disp_drv_use_generic_set_px_cb(&driver, LV_IMG_CF_TRUE_COLOR_ALPHA);
+
+    lv_disp_t fake_disp;
+    lv_memset_00(&fake_disp, sizeof(lv_disp_t));
+    fake_disp.driver = &driver;
+
+    lv_draw_sw_ctx_t sw_ctx;
+    lv_draw_ctx_t * draw_ctx = (lv_draw_ctx_t *)&sw_ctx;
+    lv_draw_sw_init_ctx(&driver, draw_ctx);
+    draw_ctx->buf = buf;
+    draw_ctx->buf_area = &cache_area;
+    draw_ctx->clip_area = &cache_area;
+    driver.draw_ctx = draw_ctx;
+
+    /*The masks of the parents (e.g. clip corner) shouldn't be rendered into the layer*/
+    _lv_draw_mask_saved_arr_t masks_ori;
+    lv_memcpy(masks_ori, LV_GC_ROOT(_lv_draw_mask_list), sizeof(masks_ori));
+    lv_memset_00(LV_GC_ROOT(_lv_draw_mask_list), sizeof(masks_ori));
+    lv_disp_t * refr_ori = _lv_refr_get_disp_refreshing();
+    _lv_refr_set_disp_refreshing(&fake_disp);
+
+    draw_ticks_and_labels(obj, draw_ctx, scale_area);
+    draw_ctx->wait_for_finish(draw_ctx);
+
+    _lv_refr_set_disp_refreshing(refr_ori);
+    lv_memcpy(LV_GC_ROOT(_lv_draw_mask_list), masks_ori, sizeof(masks_ori));
+    lv_draw_sw_deinit_ctx(&driver, draw_ctx);
+
+    analogclock->scale_cache.header.always_zero = 0;
+    analogclock->scale_cache.header.cf = LV_IMG_CF_TRUE_COLOR_ALPHA;
+    analogclock->scale_cache.header.w = w;
+    analogclock->scale_cache.header.h = h;
+    analogclock->scale_cache.data_size = buf_size;
+    analogclock->scale_cache.data = buf;
+    return true;
+}
+
+/**
+ * Free the cached layer so that it's rendered again on the next redraw.
+ * Also try to allocate it again if it failed before.
+ * @param obj       pointer to a analogclock object
+ */
+static void free_scale_cache(lv_obj_t * obj)
+{
+    lv_analogclock_t * analogclock = (lv_analogclock_t *)obj;
+    analogclock->scale_cache_failed = false;
+    if(analogclock->scale_cache.data == NULL) return;
+
+    lv_img_cache_invalidate_src(&analogclock->scale_cache);
+    lv_mem_free((void *)analogclock->scale_cache.data);
+    analogclock->scale_cache.data = NULL;
+}
+#endif
+
 #endif
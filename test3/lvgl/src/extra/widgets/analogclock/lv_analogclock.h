@@ -107,6 +107,10 @@ typedef struct {
     lv_analogclock_indicator_t * hour_indic;
     lv_analogclock_indicator_t * min_indic;
     lv_analogclock_indicator_t * sec_indic;
+#if LV_ANALOGCLOCK_CACHE_SCALE
+    lv_img_dsc_t scale_cache;   /*The rendered ticks and labels. `data == NULL` if they need to be rendered again*/
+    bool scale_cache_failed;    /*The layer couldn't be allocated. Draw the ticks directly until the size or style changes*/
+#endif
 } lv_analogclock_t;
 
 extern const lv_obj_class_t lv_analogclock_class;
@@ -114,6 +118,8 @@ extern const lv_obj_class_t lv_analogclock_class;
 /**
  * `type` field in `lv_obj_draw_part_dsc_t` if `class_p = lv_analogclock_class`
  * Used in `LV_EVENT_DRAW_PART_BEGIN` and `LV_EVENT_DRAW_PART_END`
+ * @note with `LV_ANALOGCLOCK_CACHE_SCALE` the events of the ticks are sent only when the cached layer is rendered.
+ *       Call `lv_analogclock_refresh_scale()` if the drawing of the ticks should change.
  */
 typedef enum {
     LV_analogclock_DRAW_PART_ARC,             /**< The arc indicator*/
@@ -310,6 +316,17 @@ void lv_analogclock_set_indicator_end_value(lv_obj_t * obj, lv_analogclock_indic
  */
 void lv_analogclock_set_time(lv_obj_t * obj, int32_t hour, int32_t min, int32_t sec);
 
+/*=====================
+ * Other functions
+ *====================*/
+
+/**
+ * Render the ticks and labels again. Needed only with `LV_ANALOGCLOCK_CACHE_SCALE`
+ * if their drawing is changed in an `LV_EVENT_DRAW_PART_BEGIN` event.
+ * @param obj           pointer to a analogclock object
+ */
+void lv_analogclock_refresh_scale(lv_obj_t * obj);
+
 /**********************
  *      MACROS
  **********************/
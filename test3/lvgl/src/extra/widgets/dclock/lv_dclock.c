@@ -35,6 +35,7 @@
 #define LV_DCLOCK_SCROLL_DELAY       300
 #define LV_DCLOCK_DOT_END_INV 0xFFFFFFFF
 #define LV_DCLOCK_HINT_HEIGHT_LIMIT 1024 /*Enable "hint" to buffer info about labels larger than this. (Speed up drawing)*/
+#define LV_DCLOCK_FMT_BUF_SIZE 32 /*Formatted texts shorter than this are updated in place in fixed width mode*/
 
 /**********************
  *      TYPEDEFS
@@ -48,6 +49,14 @@ static void lv_dclock_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
 static void lv_dclock_event(const lv_obj_class_t * class_p, lv_event_t * e);
 static void draw_main(lv_event_t * e);
 static void lv_dclock_refr_text(lv_obj_t * obj);
+static bool set_text_in_place(lv_obj_t * obj, const char * text);
+static bool is_digit(uint32_t letter);
+static void draw_fixed_width(lv_event_t * e);
+static lv_coord_t get_cell_width(const lv_font_t * font);
+static lv_coord_t get_fixed_text_width(lv_obj_t * obj, const char * text);
+static lv_coord_t get_fixed_text_x(lv_obj_t * obj, const lv_area_t * txt_coords);
+static bool render_digit_atlas(lv_obj_t * obj, const lv_font_t * font, lv_color_t color);
+static void free_digit_atlas(lv_obj_t * obj);
 
 /**********************
  *  STATIC VARIABLES
@@ -82,6 +91,9 @@ void lv_dclock_set_text(lv_obj_t * obj, const char * text)
     LV_ASSERT_OBJ(obj, MY_CLASS);
     lv_dclock_t * dclock = (lv_dclock_t *)obj;
 
+    /*Only the changed digits need to be redrawn in fixed width mode*/
+    if(text != NULL && set_text_in_place(obj, text)) return;
+
     lv_obj_invalidate(obj);
 
     /*If text is NULL then just refresh with the current text*/
@@ -144,8 +156,22 @@ void lv_dclock_set_text_fmt(lv_obj_t * obj, const char * fmt, ...)
 
     LV_ASSERT_OBJ(obj, MY_CLASS);
     LV_ASSERT_NULL(fmt);
-    lv_obj_invalidate(obj);
     lv_dclock_t * dclock = (lv_dclock_t *)obj;
+    va_list args;
+
+    /*Format to the stack to update the text in place if possible*/
+    if(fmt != NULL && dclock->fixed_width) {
+        char buf[LV_DCLOCK_FMT_BUF_SIZE];
+        va_start(args, fmt);
+        int len = lv_vsnprintf(buf, sizeof(buf), fmt, args);
+        va_end(args);
+        if(len >= 0 && (size_t)len < sizeof(buf)) {
+            lv_dclock_set_text(obj, buf);
+            return;
+        }
+    }
+
+    lv_obj_invalidate(obj);
 
     /*If text is NULL then refresh*/
     if(fmt == NULL) {
@@ -158,7 +184,6 @@ void lv_dclock_set_text_fmt(lv_obj_t * obj, const char * fmt, ...)
         dclock->text = NULL;
     }
 
-    va_list args;
     va_start(args, fmt);
     dclock->text = _lv_txt_set_text_vfmt(fmt, args);
     va_end(args);
@@ -167,6 +192,19 @@ void lv_dclock_set_text_fmt(lv_obj_t * obj, const char * fmt, ...)
     lv_dclock_refr_text(obj);
 }
 
+void lv_dclock_set_fixed_width(lv_obj_t * obj, bool en)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    lv_dclock_t * dclock = (lv_dclock_t *)obj;
+
+    if(dclock->fixed_width == (en ? 1 : 0)) return;
+
+    dclock->fixed_width = en ? 1 : 0;
+    if(!en) free_digit_atlas(obj);
+
+    lv_dclock_refr_text(obj);
+}
+
 /*=====================
  * Getter functions
  *====================*/
@@ -251,12 +289,11 @@ void clock_count_12(int * hour, int * minute, int * seconds, char * meridiem)
         }
     }
     if(*hour == 12 && *seconds == 0 && *minute == 0) {
-        if((strcmp(meridiem, "PM") == 0)) {
-            strcpy(meridiem, "AM");
-        }
-        else {
-            strcpy(meridiem, "PM");
-        }
+        /*Toggle between "AM" and "PM" in place*/
+        bool pm = meridiem[0] == 'P' && meridiem[1] == 'M' && meridiem[2] == '\0';
+        meridiem[0] = pm ? 'A' : 'P';
+        meridiem[1] = 'M';
+        meridiem[2] = '\0';
     }
 }
 
@@ -277,6 +314,9 @@ static void lv_dclock_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj
     dclock->recolor    = 0;
     dclock->offset.x = 0;
     dclock->offset.y = 0;
+    dclock->fixed_width = 0;
+    dclock->atlas_buf = NULL;
+    dclock->atlas_font = NULL;
 
 #if LV_DCLOCK_TEXT_SELECTION
     dclock->sel_start = LV_DRAW_LABEL_NO_TXT_SEL;
@@ -295,6 +335,8 @@ static void lv_dclock_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
 
     if(!dclock->static_txt) lv_mem_free(dclock->text);
     dclock->text = NULL;
+
+    free_digit_atlas(obj);
 }
 
 static void lv_dclock_event(const lv_obj_class_t * class_p, lv_event_t * e)
@@ -311,6 +353,8 @@ static void lv_dclock_event(const lv_obj_class_t * class_p, lv_event_t * e)
     lv_obj_t * obj = lv_event_get_target(e);
 
     if(code == LV_EVENT_STYLE_CHANGED) {
+        /*The font or the color of the digits might have changed*/
+        free_digit_atlas(obj);
         lv_dclock_refr_text(obj);
     }
     else if(code == LV_EVENT_REFR_EXT_DRAW_SIZE) {
@@ -339,14 +383,22 @@ static void lv_dclock_event(const lv_obj_class_t * class_p, lv_event_t * e)
         if(lv_obj_get_style_width(obj, LV_PART_MAIN) == LV_SIZE_CONTENT && !obj->w_layout) w = LV_COORD_MAX;
         else w = lv_obj_get_content_width(obj);
 
-        lv_txt_get_size(&size, dclock->text, font, letter_space, line_space, w, flag);
+        if(dclock->fixed_width) {
+            size.x = get_fixed_text_width(obj, dclock->text);
+            size.y = lv_font_get_line_height(font);
+        }
+        else {
+            lv_txt_get_size(&size, dclock->text, font, letter_space, line_space, w, flag);
+        }
 
         lv_point_t * self_size = lv_event_get_param(e);
         self_size->x = LV_MAX(self_size->x, size.x);
         self_size->y = LV_MAX(self_size->y, size.y);
     }
     else if(code == LV_EVENT_DRAW_MAIN) {
-        draw_main(e);
+        lv_dclock_t * dclock = (lv_dclock_t *)obj;
+        if(dclock->fixed_width) draw_fixed_width(e);
+        else draw_main(e);
     }
 }
 
@@ -440,4 +492,317 @@ static void lv_dclock_refr_text(lv_obj_t * obj)
 
 }
 
+/**
+ * Update the text in place if only digits have changed and invalidate only their cells
+ * @param obj       pointer to a dclock object
+ * @param text      the new text
+ * @return          true: the text was updated; false: the text needs to be set normally
+ */
+static bool set_text_in_place(lv_obj_t * obj, const char * text)
+{
+    lv_dclock_t * dclock = (lv_dclock_t *)obj;
+    if(!dclock->fixed_width || dclock->static_txt || dclock->text == NULL || dclock->text == text) return false;
+
+    /*Only digits are allowed to change and the length has to be the same*/
+    uint32_t i;
+    for(i = 0; text[i] != '\0' && dclock->text[i] != '\0'; i++) {
+        if(text[i] == dclock->text[i]) continue;
+        if(!is_digit(text[i]) || !is_digit(dclock->text[i])) return false;
+    }
+    if(text[i] != dclock->text[i]) return false;
+
+    lv_area_t txt_coords;
+    lv_obj_get_content_coords(obj, &txt_coords);
+    const lv_font_t * font = lv_obj_get_style_text_font(obj, LV_PART_MAIN);
+    lv_coord_t letter_space = lv_obj_get_style_text_letter_space(obj, LV_PART_MAIN);
+    lv_coord_t cell_w = get_cell_width(font);
+
+    lv_area_t cell;
+    cell.x1 = get_fixed_text_x(obj, &txt_coords);
+    cell.y1 = txt_coords.y1 + dclock->offset.y;
+    cell.y2 = cell.y1 + lv_font_get_line_height(font) - 1;
+
+    uint32_t ofs = 0;
+    while(dclock->text[ofs] != '\0') {
+        uint32_t letter_ofs = ofs;
+        uint32_t letter = _lv_txt_encoded_next(dclock->text, &ofs);
+        bool digit = is_digit(letter);
+        lv_coord_t letter_w = digit ? cell_w : lv_font_get_glyph_width(font, letter, 0);
+
+        if(digit && text[letter_ofs] != dclock->text[letter_ofs]) {
+            dclock->text[letter_ofs] = text[letter_ofs];
+            cell.x2 = cell.x1 + cell_w - 1;
+            lv_obj_invalidate_area(obj, &cell);
+        }
+
+        cell.x1 += letter_w + letter_space;
+    }
+
+    return true;
+}
+
+static bool is_digit(uint32_t letter)
+{
+    return letter >= '0' && letter <= '9';
+}
+
+/**
+ * Draw the text in fixed width mode. The digits are drawn from the pre-rendered atlas.
+ * @param e         the DRAW_MAIN event
+ */
+static void draw_fixed_width(lv_event_t * e)
+{
+    lv_obj_t * obj = lv_event_get_target(e);
+    lv_dclock_t * dclock = (lv_dclock_t *)obj;
+    lv_draw_ctx_t * draw_ctx = lv_event_get_draw_ctx(e);
+    if(dclock->text == NULL) return;
+
+    lv_area_t txt_coords;
+    lv_obj_get_content_coords(obj, &txt_coords);
+
+    lv_area_t txt_clip;
+    bool is_common = _lv_area_intersect(&txt_clip, &txt_coords, draw_ctx->clip_area);
+    if(!is_common) return;
+
+    lv_draw_label_dsc_t dclock_draw_dsc;
+    lv_draw_label_dsc_init(&dclock_draw_dsc);
+    lv_obj_init_draw_label_dsc(obj, LV_PART_MAIN, &dclock_draw_dsc);
+    if(dclock_draw_dsc.opa <= LV_OPA_MIN) return;
+
+    const lv_font_t * font = dclock_draw_dsc.font;
+    lv_coord_t cell_w = get_cell_width(font);
+    lv_coord_t line_h = lv_font_get_line_height(font);
+
+    /*The atlas has only the text color so draw the letters one by one if they might be colored otherwise*/
+    bool use_atlas = dclock->recolor == 0 &&
+                     (lv_dclock_get_text_selection_start(obj) == LV_DRAW_LABEL_NO_TXT_SEL ||
+                      lv_dclock_get_text_selection_end(obj) == LV_DRAW_LABEL_NO_TXT_SEL);
+    if(use_atlas && (dclock->atlas_buf == NULL || dclock->atlas_font != font ||
+                     dclock->atlas_color.full != dclock_draw_dsc.color.full)) {
+        use_atlas = render_digit_atlas(obj, font, dclock_draw_dsc.color);
+    }
+
+    lv_draw_img_dsc_t img_dsc;
+    lv_draw_img_dsc_init(&img_dsc);
+    img_dsc.opa = dclock_draw_dsc.opa;
+    img_dsc.blend_mode = dclock_draw_dsc.blend_mode;
+
+    const lv_area_t * clip_area_ori = draw_ctx->clip_area;
+    draw_ctx->clip_area = &txt_clip;
+
+    lv_point_t pos;
+    pos.x = get_fixed_text_x(obj, &txt_coords);
+    pos.y = txt_coords.y1 + dclock->offset.y;
+
+    uint32_t ofs = 0;
+    while(dclock->text[ofs] != '\0') {
+        uint32_t letter = _lv_txt_encoded_next(dclock->text, &ofs);
+        bool digit = is_digit(letter);
+        lv_coord_t letter_w = digit ? cell_w : lv_font_get_glyph_width(font, letter, 0);
+
+        if(pos.x + letter_w > txt_clip.x1 && pos.x <= txt_clip.x2) {
+            if(digit && use_atlas) {
+                lv_area_t cell;
+                cell.x1 = pos.x;
+                cell.y1 = pos.y;
+                cell.x2 = cell.x1 + cell_w - 1;
+                cell.y2 = cell.y1 + line_h - 1;
+                lv_draw_img(draw_ctx, &img_dsc, &cell, &dclock->atlas_digits[letter - '0']);
+            }
+            else if(digit) {
+                /*Center the digit in its cell*/
+                lv_point_t letter_pos;
+                letter_pos.x = pos.x + (cell_w - lv_font_get_glyph_width(font, letter, 0)) / 2;
+                letter_pos.y = pos.y;
+                lv_draw_letter(draw_ctx, &dclock_draw_dsc, &letter_pos, letter);
+            }
+            else {
+                lv_draw_letter(draw_ctx, &dclock_draw_dsc, &pos, letter);
+            }
+        }
+
+        pos.x += letter_w + dclock_draw_dsc.letter_space;
+    }
+
+    draw_ctx->clip_area = clip_area_ori;
+}
+
+/**
+ * Get the width of a digit cell, i.e. the width of the widest digit
+ * @param font      pointer to a font
+ * @return          the width of the cells
+ */
+static lv_coord_t get_cell_width(const lv_font_t * font)
+{
+    lv_coord_t cell_w = 0;
+    uint32_t i;
+    for(i = 0; i < LV_DCLOCK_DIGIT_CNT; i++) {
+        cell_w = LV_MAX(cell_w, lv_font_get_glyph_width(font, '0' + i, 0));
+    }
+
+    return cell_w;
+}
+
+/**
+ * Get the width of a text in fixed width mode
+ * @param obj       pointer to a dclock object
+ * @param text      the text to measure
+ * @return          the width of the text
+ */
+static lv_coord_t get_fixed_text_width(lv_obj_t * obj, const char * text)
+{
+    if(text == NULL || text[0] == '\0') return 0;
+
+    const lv_font_t * font = lv_obj_get_style_text_font(obj, LV_PART_MAIN);
+    lv_coord_t letter_space = lv_obj_get_style_text_letter_space(obj, LV_PART_MAIN);
+    lv_coord_t cell_w = get_cell_width(font);
+
+    lv_coord_t w = 0;
+    uint32_t ofs = 0;
+    while(text[ofs] != '\0') {
+        uint32_t letter = _lv_txt_encoded_next(text, &ofs);
+        w += is_digit(letter) ? cell_w : lv_font_get_glyph_width(font, letter, 0);
+        w += letter_space;
+    }
+
+    /*Trim the last letter space*/
+    return w - letter_space;
+}
+
+/**
+ * Get the x coordinate of the first letter in fixed width mode according to the text align
+ * @param obj           pointer to a dclock object
+ * @param txt_coords    the content area of the object
+ * @return              the x coordinate of the first letter
+ */
+static lv_coord_t get_fixed_text_x(lv_obj_t * obj, const lv_area_t * txt_coords)
+{
+    lv_dclock_t * dclock = (lv_dclock_t *)obj;
+    lv_text_align_t align = lv_obj_get_style_text_align(obj, LV_PART_MAIN);
+    lv_base_dir_t base_dir = lv_obj_get_style_base_dir(obj, LV_PART_MAIN);
+    lv_bidi_calculate_align(&align, &base_dir, dclock->text);
+
+    lv_coord_t x = txt_coords->x1 + dclock->offset.x;
+    if(align == LV_TEXT_ALIGN_CENTER) {
+        x += (lv_area_get_width(txt_coords) - get_fixed_text_width(obj, dclock->text)) / 2;
+    }
+    else if(align == LV_TEXT_ALIGN_RIGHT) {
+        x += lv_area_get_width(txt_coords) - get_fixed_text_width(obj, dclock->text);
+    }
+
+    return x;
+}
+
+/**
+ * Render the digits into one buffer as ARGB images. Every digit is centered in a cell of the same size.
+ * @param obj       pointer to a dclock object
+ * @param font      render the digits with this font
+ * @param color     render the digits with this color
+ * @return          true: the atlas is ready; false: the digits can't be pre-rendered
+ */
+static bool render_digit_atlas(lv_obj_t * obj, const lv_font_t * font, lv_color_t color)
+{
+    lv_dclock_t * dclock = (lv_dclock_t *)obj;
+    free_digit_atlas(obj);
+
+    if(font->subpx != LV_FONT_SUBPX_NONE) return false;
+
+    lv_coord_t cell_w = get_cell_width(font);
+    lv_coord_t line_h = lv_font_get_line_height(font);
+    if(cell_w <= 0 || line_h <= 0) return false;
+
+    uint32_t digit_size = (uint32_t)cell_w * line_h * LV_IMG_PX_SIZE_ALPHA_BYTE;
+    uint8_t * buf = lv_mem_alloc(digit_size * LV_DCLOCK_DIGIT_CNT);
+    if(buf == NULL) {
+        LV_LOG_WARN("Couldn't allocate the digit atlas");
+        return false;
+    }
+
+    uint32_t i;
+    for(i = 0; i < LV_DCLOCK_DIGIT_CNT; i++) {
+        uint8_t * digit_buf = buf + i * digit_size;
+        uint32_t letter = '0' + i;
+
+        /*Start from a transparent cell with the text color*/
+        uint32_t px;
+        for(px = 0; px < digit_size; px += LV_IMG_PX_SIZE_ALPHA_BYTE) {
+            lv_memcpy_small(&digit_buf[px], &color, sizeof(lv_color_t));
+            digit_buf[px + LV_IMG_PX_SIZE_ALPHA_BYTE - 1] = LV_OPA_TRANSP;
+        }
+
+        lv_font_glyph_dsc_t g;
+        const uint8_t * map_p = NULL;
+        if(lv_font_get_glyph_dsc(font, &g, letter, '\0')) {
+            map_p = lv_font_get_glyph_bitmap(g.resolved_font, letter);
+        }
+
+        uint8_t bpp = g.bpp == 3 ? 4 : g.bpp;
+        if(map_p != NULL && bpp != 1 && bpp != 2 && bpp != 4 && bpp != 8) {
+            lv_mem_free(buf);
+            return false;
+        }
+
+        if(map_p != NULL) {
+            /*Place the glyph like lv_draw_letter does, centered in the cell*/
+            lv_coord_t x_ofs = (cell_w - g.adv_w) / 2 + g.ofs_x;
+            lv_coord_t y_ofs = (font->line_height - font->base_line) - g.box_h - g.ofs_y;
+            uint8_t bitmask_init = (uint8_t)((1 << bpp) - 1);
+
+            lv_coord_t row;
+            for(row = 0; row < g.box_h; row++) {
+                lv_coord_t y = y_ofs + row;
+                if(y < 0 || y >= line_h) continue;
+
+                lv_coord_t col;
+                for(col = 0; col < g.box_w; col++) {
+                    lv_coord_t x = x_ofs + col;
+                    if(x < 0 || x >= cell_w) continue;
+
+                    /*The bitmap is packed without padding at the end of the rows*/
+                    uint32_t bit_pos = ((uint32_t)row * g.box_w + col) * bpp;
+                    uint8_t letter_px = (map_p[bit_pos >> 3] >> (8 - (bit_pos & 0x7) - bpp)) & bitmask_init;
+                    lv_opa_t opa = (lv_opa_t)(letter_px * 255 / bitmask_init);
+
+                    digit_buf[((uint32_t)y * cell_w + x) * LV_IMG_PX_SIZE_ALPHA_BYTE + LV_IMG_PX_SIZE_ALPHA_BYTE - 1] = opa;
+                }
+            }
+        }
+
+        lv_img_dsc_t * dsc = &dclock->atlas_digits[i];
+        lv_memset_00(dsc, sizeof(lv_img_dsc_t));
+        dsc->header.always_zero = 0;
+        dsc->header.cf = LV_IMG_CF_TRUE_COLOR_ALPHA;
+        dsc->header.w = cell_w;
+        dsc->header.h = line_h;
+        dsc->data_size = digit_size;
+        dsc->data = digit_buf;
+    }
+
+    dclock->atlas_buf = buf;
+    dclock->atlas_font = font;
+    dclock->atlas_color = color;
+
+    return true;
+}
+
+/**
+ * Free the pre-rendered digits
+ * @param obj       pointer to a dclock object
+ */
+static void free_digit_atlas(lv_obj_t * obj)
+{
+    lv_dclock_t * dclock = (lv_dclock_t *)obj;
+    if(dclock->atlas_buf == NULL) return;
+
+    /*The images might be cached by their source*/
+    uint32_t i;
+    for(i = 0; i < LV_DCLOCK_DIGIT_CNT; i++) {
+        lv_img_cache_invalidate_src(&dclock->atlas_digits[i]);
+    }
+
+    lv_mem_free(dclock->atlas_buf);
+    dclock->atlas_buf = NULL;
+    dclock->atlas_font = NULL;
+}
+
 #endif
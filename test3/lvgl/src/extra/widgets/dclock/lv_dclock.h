@@ -38,6 +38,7 @@ extern "C" {
 #define LV_DCLOCK_DOT_NUM 3
 #define LV_DCLOCK_POS_LAST 0xFFFF
 #define LV_DCLOCK_TEXT_SELECTION_OFF LV_DRAW_LABEL_NO_TXT_SEL
+#define LV_DCLOCK_DIGIT_CNT 10
 
 
 LV_EXPORT_CONST_INT(LV_DCLOCK_DOT_NUM);
@@ -62,6 +63,13 @@ typedef struct {
     uint8_t static_txt : 1;             /*Flag to indicate the text is static*/
     uint8_t recolor : 1;                /*Enable in-line letter re-coloring*/
     uint8_t expand : 1;                 /*Ignore real width (used by the library with LV_LABEL_LONG_SCROLL)*/
+    uint8_t fixed_width : 1;            /*Draw the digits in cells of the same width*/
+
+    /*Digits pre-rendered for the fixed width mode*/
+    uint8_t * atlas_buf;                /*The pixels of all digits, NULL if not rendered yet*/
+    const lv_font_t * atlas_font;       /*The digits were rendered with this font and color*/
+    lv_color_t atlas_color;
+    lv_img_dsc_t atlas_digits[LV_DCLOCK_DIGIT_CNT];
 } lv_dclock_t;
 
 
@@ -89,6 +97,16 @@ void lv_dclock_set_text_fmt(lv_obj_t * obj, const char * fmt, ...) LV_FORMAT_ATT
 
 void lv_dclock_set_text(lv_obj_t * obj, const char * text);
 
+/**
+ * Enable the fixed width mode. The digits are drawn in cells of the same width from pre-rendered images,
+ * so the layout doesn't change while the clock is running. If only digits change in the new text
+ * it's updated in place and only the cells of the changed digits are redrawn.
+ * The text is drawn in one line and recoloring, selection and text decoration are not supported in this mode.
+ * @param obj       pointer to a dclock object
+ * @param en        true: enable the fixed width mode
+ */
+void lv_dclock_set_fixed_width(lv_obj_t * obj, bool en);
+
 /**
  * @brief           Calculate the digital clock by the 12-hours mode
  * @param obj       pointer to the values for hour/minute/seconds and the bool value to select AM/PM
@@ -34,19 +34,33 @@
 #else
     #include "decoder.h"
     #include <unistd.h>
+    #if LV_VIDEO_USE_THREADS
+        #include <pthread.h>
+    #endif
+    #if defined(__ARM_NEON)
+        #include <arm_neon.h>
+    #elif defined(__SSE2__)
+        #include <emmintrin.h>
+    #endif
 #endif
 
 /*********************
  *      DEFINES
  *********************/
 #define MY_CLASS &lv_video_class
-#define LV_COLOR_SIZE 16
 #ifndef DEMO_FILE_BUF_SIZE
     #define DEMO_FILE_BUF_SIZE (16 * 1024)
 #endif
 #ifndef DEMO_DECODE_BUF_SIZE
     #define DEMO_DECODE_BUF_SIZE (64 * 1024)
 #endif
+#define VIDEO_DEF_FPS 30
+
+/* The decoder threads are used only with the CPU conversion of the simulator */
+#define VIDEO_USE_THREADS (LV_VIDEO_USE_THREADS && LV_USE_GUIDER_SIMULATOR)
+#if VIDEO_USE_THREADS
+    #define FRAME_BUF_CNT LV_MAX(LV_VIDEO_FRAME_CNT, 2)
+#endif
 
 #pragma GCC diagnostic ignored "-Wdeprecated-declarations"
 
@@ -54,11 +68,64 @@
 /**********************
  *      TYPEDEFS
  **********************/
+#if VIDEO_USE_THREADS
+enum {
+    VIDEO_FRAME_FREE,
+    VIDEO_FRAME_CONVERTING,
+    VIDEO_FRAME_QUEUED,
+    VIDEO_FRAME_SHOWN,
+};
+
+typedef struct {
+    lv_color_t * buf;
+    uint32_t pts;       /* Presentation time [ms] */
+    uint32_t seq;       /* Decoding order */
+    uint8_t state;
+} video_frame_t;
+
+typedef struct _lv_video_worker_t {
+    /* Shared by the decoder threads and the UI thread. Protected by the mutex of the pool. */
+    lv_obj_t * obj;
+    struct _lv_video_worker_t * next;   /* Next video in the pool */
+    video_frame_t frames[FRAME_BUF_CNT];
+    int32_t frame_act;          /* Index of the shown frame or -1 */
+    uint32_t frame_seq;
+    uint32_t frame_period;      /* [ms] */
+    uint32_t next_pts;
+    uint32_t clock_ms;          /* Playback position */
+    bool clock_valid;
+    bool busy;                  /* A thread is decoding this video */
+    bool stop;
+    bool failed;
+
+    /* Used only by the thread which is decoding the video */
+    uint32_t pass_frames;       /* Frames decoded since the start of the file */
+    int32_t flush_cnt;          /* Frames to get from the decoder at the end of the file */
+    bool input_end;             /* The whole file is in the decode buffer */
+    bool flushed;
+
+    /* Used only by the UI thread */
+    lv_timer_t * timer;
+    uint32_t clock_start;       /* Tick when the frame with 0 presentation time should have been shown */
+    bool clock_sync;            /* Start the clock from the next shown frame */
+} lv_video_worker_t;
+
+/* Threads shared by all videos */
+typedef struct {
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;        /* Broadcasted when a frame is queued or shown, on stop and on quit */
+    pthread_t threads[LV_VIDEO_THREAD_CNT];
+    lv_video_worker_t * videos; /* The playing videos, the next job is searched from the head */
+    uint32_t thread_cnt;
+    bool quit;
+} video_pool_t;
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 
+/* Size of the video being created */
 static int16_t video_width = 0;
 static int16_t video_height = 0;
 static void lv_video_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
@@ -76,13 +143,38 @@ static void PXP_DisplayFrame(uint16_t width,
                              uint32_t UV_Stride,
                              lv_obj_t * obj);
 #else
-static void yuv420pToRgb565(int oriWidth,
-                            int oriHeight,
-                            int width, int height,
-                            uint8_t * py, uint8_t * pu, uint8_t * pv,
-                            unsigned short * dst);
+static bool updateScaleTables(lv_video_t * video, int oriWidth, int oriHeight);
+static void yuv420pToColor(lv_video_t * video, const uint8_t * py, const uint8_t * pu, const uint8_t * pv,
+                           int yStride, int uvStride, lv_color_t * dst);
+static void yuv420pRowToColor(const uint8_t * py, const uint8_t * pu, const uint8_t * pv,
+                              const uint16_t * colTbl, lv_color_t * dst, int width);
+static inline lv_color_t yuvToColor(int y, int u, int v);
 static void CPU_DisplayFrame(SBufferInfo sDstBufInfo, unsigned char ** dst, lv_obj_t * obj);
 #endif
+static void displayFrame(lv_obj_t * obj, SBufferInfo * info, unsigned char ** dst);
+static bool decoderCreate(lv_video_t * video);
+static void decoderDelete(lv_video_t * video);
+static int decoderDecode(lv_video_t * video, const uint8_t * src, int32_t len, unsigned char ** dst,
+                         SBufferInfo * info);
+static int32_t decoderRemainingFrames(lv_video_t * video);
+static void decoderFlushFrame(lv_video_t * video, unsigned char ** dst, SBufferInfo * info);
+static void decodeBufReset(lv_video_t * video);
+static int32_t decodeBufPrepare(lv_video_t * video);
+static int32_t decodeBufNextNalu(lv_video_t * video, bool endOfInput);
+static bool decodeNalu(lv_video_t * video, int32_t size, unsigned char ** dst, SBufferInfo * info);
+static lv_fs_res_t readFileBlock(lv_video_t * video);
+#if VIDEO_USE_THREADS
+static void videoThreadStart(lv_obj_t * obj);
+static void videoThreadStop(lv_obj_t * obj);
+static lv_fs_res_t videoReadInput(lv_video_t * video);
+static int videoDecodeNext(lv_video_t * video, unsigned char ** dst, SBufferInfo * info);
+static void * videoPoolThread(void * arg);
+static lv_video_worker_t * videoPoolGetJob(video_frame_t ** frame);
+static void videoConvertFrame(lv_video_worker_t * worker, video_frame_t * frame, unsigned char ** dst,
+                              SBufferInfo * info);
+static video_frame_t * videoGetQueuedFrame(lv_video_worker_t * worker, video_frame_t * skip);
+static void videoTimerCb(lv_timer_t * timer);
+#endif
 /**********************
  *  STATIC VARIABLES
  **********************/
@@ -99,15 +191,18 @@ const lv_obj_class_t lv_video_class = {
     /* PXP Usage */
     static pxp_output_buffer_config_t s_pxpOutputBufferConfig;
     static pxp_ps_buffer_config_t s_pxpPsBufferConfig;
-    static volatile uint8_t s_lcdActiveFbIdx = 0;
     static int buffer_byte_per_pixel = 2;
-    static uint8_t * s_lcdBuffer[2];
-#else
-    static int mallocInit = 0;
-    static uint8_t * rgb, *py, *pu, *pv;
+    static lv_obj_t * s_pxpConfiguredObj;  /* The scaler is configured for this video */
+    /* The decoder of the SDK has only one instance, so it's shared by the videos */
+    static uint32_t s_decoderRefCnt;
 #endif
 
-static uint8_t s_decodeBuf[DEMO_DECODE_BUF_SIZE];
+#if VIDEO_USE_THREADS
+    static video_pool_t s_pool = {
+        .mutex = PTHREAD_MUTEX_INITIALIZER,
+        .cond = PTHREAD_COND_INITIALIZER,
+    };
+#endif
 
 /**********************
  *      MACROS
@@ -129,37 +224,57 @@ lv_obj_t * lv_video_create(lv_obj_t * parent, int widgetWidth, int widgetHeight)
     video_width = widgetWidth;
     video_height = widgetHeight;
 
-#if !LV_USE_GUIDER_SIMULATOR
-    s_lcdBuffer[0] = malloc(widgetWidth * widgetHeight * buffer_byte_per_pixel);
-    s_lcdBuffer[1] = malloc(widgetWidth * widgetHeight * buffer_byte_per_pixel);
-#endif
-
     lv_obj_t * obj = lv_obj_class_create_obj(MY_CLASS, parent);
     lv_obj_class_init_obj(obj);
     return obj;
 }
 
+/**
+ * Play the video. Without `LV_VIDEO_USE_THREADS` it doesn't return while the video is playing.
+ * Else it adds the video to the decoder threads if it's not playing yet and returns immediately.
+ * @param obj pointer to a video object
+ */
 void lv_video_play(lv_obj_t * obj)
 {
     lv_video_t * video = (lv_video_t *)obj;
+#if VIDEO_USE_THREADS
+    LV_UNUSED(video);
+    videoThreadStart(obj);
+#else
     Read_HFile(video->file_name, obj);
+#endif
 }
 
-static int search_nalu(const uint8_t * data, int32_t len)
+/**
+ * Search the start code (00 00 00 01 or 00 00 01) of the NALU after the one at `start`.
+ * The search continues where the previous one stopped, so the bytes of a NALU which
+ * arrives in several file blocks are scanned only once.
+ * @param buf the decode buffer
+ * @param start index of the current NALU
+ * @param scan index where the search continues. Updated if no start code was found.
+ * @param end index after the last byte in the buffer
+ * @return the size of the current NALU or -1 if the next start code was not found yet
+ */
+static int32_t search_nalu(const uint8_t * buf, int32_t start, int32_t * scan, int32_t end)
 {
-    int i;
-    /* parse NALU 00 00 00 01 or 00 00 01 */
-    for(i = 1; i < len - 4; i++) {
-        if((data[i] == 0 && data[i + 1] == 0 && data[i + 2] == 0 && data[i + 3] == 1) ||
-           (data[i] == 0 && data[i + 1] == 0 && data[i + 2] == 1)) {
-            return i;
-        }
-    }
+    int32_t i = LV_MAX(*scan, start + 1);
 
-    if(data[i] == 0 && data[i + 1] == 0 && data[i + 2] == 1) {
-        return i;
+    /* Look for 00 00 01 and check the zero before it for the 4 bytes start code */
+    while(i + 2 < end) {
+        if(buf[i + 2] > 1) {
+            /* Neither of the 3 bytes can be the first byte of a start code */
+            i += 3;
+        }
+        else if(buf[i + 2] == 1 && buf[i + 1] == 0 && buf[i] == 0) {
+            if(i - 1 > start && buf[i - 1] == 0) i--;
+            return i - start;
+        }
+        else {
+            i++;
+        }
     }
 
+    *scan = i;
     return -1;
 }
 
@@ -173,98 +288,41 @@ int Decoder_Data(const uint8_t * data, int len, bool isStartOfFile, bool isEndOf
     int32_t num_of_frames_in_buffer = 0;
     int32_t leftDataLen;
 
-    static int32_t decodeBufStart = 0;
-    static int32_t decodeBufEnd   = 0;
-
     if(isStartOfFile) {
-        decodeBufStart         = 0;
-        decodeBufEnd           = 0;
+        decodeBufReset(video);
     }
     leftDataLen = len;
 
     while(leftDataLen > 0) {
-        copiedLen = MIN(leftDataLen, ((int32_t)sizeof(s_decodeBuf) - decodeBufEnd));
+        copiedLen = MIN(leftDataLen, decodeBufPrepare(video));
 
         /* Copy the input data to the end of decode buffer. */
-        memcpy(&s_decodeBuf[decodeBufEnd], data, copiedLen);
-        decodeBufEnd += copiedLen;
+        memcpy(&video->decodeBuf[video->decodeBufEnd], data, copiedLen);
+        video->decodeBufEnd += copiedLen;
         data += copiedLen;
         leftDataLen -= copiedLen;
 
-        while(decodeBufStart < decodeBufEnd) {
-            sliceSize = search_nalu(&s_decodeBuf[decodeBufStart], decodeBufEnd - decodeBufStart);
+        /* At the file end pass the last part to the H264 decoder too. */
+        while((sliceSize = decodeBufNextNalu(video, isEndOfFile && (0 == leftDataLen))) > 0) {
             if(video->exist) {
                 return 0;
             }
-            /* Could not find NALU. */
-            if(sliceSize < 0) {
-                /* This is the file end part, pass them all to H264 decoder. */
-                if(isEndOfFile && (0 == leftDataLen)) {
-                    sliceSize = decodeBufEnd - decodeBufStart;
-                }
-                else {
-                    /* After searching the full buffer, no slice found, then drop the data in buffer. */
-                    if((decodeBufStart == 0) && (decodeBufEnd == sizeof(s_decodeBuf))) {
-                        /* Drop the decode buffer, fill using left input data. */
-                        decodeBufEnd   = 0;
-                        decodeBufStart = 0;
-                    }
-
-                    /* Have processed all slice in the buffer. */
-                    break;
-                }
-            }
-            /* Slice size too small, skip it. */
-            else if(sliceSize < 4) {
-                decodeBufStart += sliceSize;
-                continue;
+            if(decodeNalu(video, sliceSize, dst, &sDstBufInfo)) {
+                displayFrame(obj, &sDstBufInfo, dst);
             }
-            /* Found NALU, decode. */
-            if(OpenH264_Decode(&s_decodeBuf[decodeBufStart], sliceSize, dst, &sDstBufInfo) == 0) {
-                if(sDstBufInfo.iBufferStatus == 1) {
-#if LV_USE_GUIDER_SIMULATOR
-                    CPU_DisplayFrame(sDstBufInfo, dst, obj);
-#else
-                    PXP_DisplayFrame(
-                        sDstBufInfo.UsrData.sSystemBuffer.iWidth, sDstBufInfo.UsrData.sSystemBuffer.iHeight,
-                        sDstBufInfo.pDst[0], sDstBufInfo.pDst[1], sDstBufInfo.pDst[2],
-                        sDstBufInfo.UsrData.sSystemBuffer.iStride[0], sDstBufInfo.UsrData.sSystemBuffer.iStride[1], obj);
-#endif
-                }
-
-            }
-            else {
-                LV_LOG_ERROR("decode error\r\n");
-            }
-
-            decodeBufStart += sliceSize;
         }
-
-        /* Move the left data in decode buffer to the start of decode buffer,
-         * left input data will be appended to the end.
-         */
-        memcpy(s_decodeBuf, &s_decodeBuf[decodeBufStart], decodeBufEnd - decodeBufStart);
-        decodeBufEnd -= decodeBufStart;
-        decodeBufStart = 0;
     }
 
     if(isEndOfFile) {
-        OpenH264_GetOption(&num_of_frames_in_buffer);
+        num_of_frames_in_buffer = decoderRemainingFrames(video);
         for(int32_t i = 0; i < num_of_frames_in_buffer; i++) {
             dst[0] = NULL;
             dst[1] = NULL;
             dst[2] = NULL;
 
-            OpenH264_FlashFrame(dst, &sDstBufInfo);
+            decoderFlushFrame(video, dst, &sDstBufInfo);
             if(sDstBufInfo.iBufferStatus == 1) {
-#if LV_USE_GUIDER_SIMULATOR
-                CPU_DisplayFrame(sDstBufInfo, dst, obj);
-#else
-                PXP_DisplayFrame(
-                    sDstBufInfo.UsrData.sSystemBuffer.iWidth, sDstBufInfo.UsrData.sSystemBuffer.iHeight,
-                    sDstBufInfo.pDst[0], sDstBufInfo.pDst[1], sDstBufInfo.pDst[2],
-                    sDstBufInfo.UsrData.sSystemBuffer.iStride[0], sDstBufInfo.UsrData.sSystemBuffer.iStride[1], obj);
-#endif
+                displayFrame(obj, &sDstBufInfo, dst);
             }
         }
     }
@@ -275,7 +333,6 @@ int Decoder_Data(const uint8_t * data, int len, bool isStartOfFile, bool isEndOf
 void Read_HFile(const char * fileName, lv_obj_t * obj)
 {
     lv_video_t * video = (lv_video_t *)obj;
-    uint32_t bytesRead;
     while(1) {
         int error = lv_fs_open(&video->h264File, video->file_name, LV_FS_MODE_RD);
         if(error != LV_FS_RES_OK) {
@@ -284,14 +341,10 @@ void Read_HFile(const char * fileName, lv_obj_t * obj)
         video->fileStart = true;
         while(1) {
             if(video->play_status == 1) {
-                error = lv_fs_read(&video->h264File, video->blk.data, DEMO_FILE_BUF_SIZE, &bytesRead);
+                error = readFileBlock(video);
                 if(error != LV_FS_RES_OK) {
                     break;
                 }
-                video->blk.len           = bytesRead;
-                video->blk.isEndOfFile   = (DEMO_FILE_BUF_SIZE > bytesRead);
-                video->blk.isStartOfFile = video->fileStart;
-                video->fileStart         = false;
                 Decoder_Data(video->blk.data, video->blk.len, video->blk.isStartOfFile, video->blk.isEndOfFile, obj);
                 if(video->blk.isEndOfFile) {
                     break;
@@ -325,15 +378,13 @@ int Video_InitPXP()
 
     memset(&s_pxpPsBufferConfig, 0, sizeof(s_pxpPsBufferConfig));
     memset(&s_pxpOutputBufferConfig, 0, sizeof(s_pxpOutputBufferConfig));
-    memset(s_lcdBuffer[0], 0, video_width * video_height * buffer_byte_per_pixel);
-    memset(s_lcdBuffer[1], 0, video_width * video_height * buffer_byte_per_pixel);
     s_pxpPsBufferConfig.pixelFormat = kPXP_PsPixelFormatYVU420;
     s_pxpPsBufferConfig.swapByte    = false,
 
     s_pxpOutputBufferConfig.pixelFormat    = kPXP_OutputPixelFormatRGB565;
     s_pxpOutputBufferConfig.interlacedMode = kPXP_OutputProgressive;
     s_pxpOutputBufferConfig.buffer1Addr    = 0U,
-    s_pxpOutputBufferConfig.pitchBytes     = (video_width * buffer_byte_per_pixel);
+    s_pxpConfiguredObj                     = NULL;
 
     /* Initialize hardware. */
     PXP_Init(PXP);
@@ -361,11 +412,9 @@ static void PXP_DisplayFrame(uint16_t width,
     lv_video_t * video = (lv_video_t *)obj;
     void * lcdFrameAddr;
     bool rotate                    = false;
-    static uint16_t oldInputWidth  = 0U;
-    static uint16_t oldInputHeight = 0U;
 
-    uint16_t lcdWidth  = video_width;
-    uint16_t lcdHeight = video_height;
+    uint16_t lcdWidth  = video->frameImage.header.w;
+    uint16_t lcdHeight = video->frameImage.header.h;
 
     DCACHE_CleanInvalidateByRange((uint32_t)Y, height * Y_Stride);
     DCACHE_CleanInvalidateByRange((uint32_t)U, height * UV_Stride / 2);
@@ -379,8 +428,8 @@ static void PXP_DisplayFrame(uint16_t width,
 
     PXP_SetProcessSurfaceBufferConfig(PXP, &s_pxpPsBufferConfig);
 
-    /* Input frame size changed. */
-    if((oldInputHeight != height) || (oldInputWidth != width)) {
+    /* Input frame size changed or the PXP was used for an other video. */
+    if((video->srcHeight != height) || (video->srcWidth != width) || (s_pxpConfiguredObj != obj)) {
 
         rotate = (height > width);
 
@@ -396,15 +445,18 @@ static void PXP_DisplayFrame(uint16_t width,
             s_pxpOutputBufferConfig.width  = lcdWidth;
             s_pxpOutputBufferConfig.height = lcdHeight;
 
+            PXP_SetRotateConfig(PXP, kPXP_RotateOutputBuffer, kPXP_Rotate0, kPXP_FlipDisable);
             PXP_SetProcessSurfaceScaler(PXP, width, height, lcdWidth, lcdHeight);
             PXP_SetProcessSurfacePosition(PXP, 0, 0, lcdWidth - 1, lcdHeight - 1);
         }
+        s_pxpOutputBufferConfig.pitchBytes = s_pxpOutputBufferConfig.width * buffer_byte_per_pixel;
 
-        oldInputHeight = height;
-        oldInputWidth  = width;
+        video->srcHeight   = height;
+        video->srcWidth    = width;
+        s_pxpConfiguredObj = obj;
     }
 
-    lcdFrameAddr                              = s_lcdBuffer[s_lcdActiveFbIdx ^ 1];
+    lcdFrameAddr                              = video->lcdBuffer[video->lcdActiveFbIdx ^ 1];
     s_pxpOutputBufferConfig.buffer0Addr = (uint32_t)lcdFrameAddr;
 
     PXP_SetOutputBufferConfig(PXP, &s_pxpOutputBufferConfig);
@@ -415,99 +467,241 @@ static void PXP_DisplayFrame(uint16_t width,
     PXP_ClearStatusFlags(PXP, kPXP_CompleteFlag);
 
     video->frameImage.data = lcdFrameAddr;
-    s_lcdActiveFbIdx ^= 1;
+    video->lcdActiveFbIdx ^= 1;
+    video->stats.decoded++;
+    video->stats.shown++;
     lv_img_set_src(obj, &video->frameImage);
 }
 #else
 static void CPU_DisplayFrame(SBufferInfo sDstBufInfo, unsigned char ** dst, lv_obj_t * obj)
 {
     lv_video_t * video = (lv_video_t *)obj;
-    int width = 0;
-    int height = 0;
     if(sDstBufInfo.iBufferStatus == 1) {
-        width = sDstBufInfo.UsrData.sSystemBuffer.iWidth;
-        height = sDstBufInfo.UsrData.sSystemBuffer.iHeight;
+        int width = sDstBufInfo.UsrData.sSystemBuffer.iWidth;
+        int height = sDstBufInfo.UsrData.sSystemBuffer.iHeight;
         int YStride = sDstBufInfo.UsrData.sSystemBuffer.iStride[0];
         int UVStride = sDstBufInfo.UsrData.sSystemBuffer.iStride[1];
-        unsigned char * pPtr = NULL;
-        if(mallocInit == 0) {
-            rgb = malloc(2 * width * height);
-            py = malloc(width * height);
-            pu = malloc(width * height / 4);
-            pv = malloc(width * height / 4);
-            mallocInit = 1;
-        }
-        pPtr = dst[0];
-        for(int i = 0; i < height; i++) {
-            memcpy(py + i * width, pPtr, width);
-            pPtr += YStride;
+        uint8_t * rgb = video->lcdBuffer[0];
+        if(rgb == NULL) {
+            rgb = malloc(video->frameImage.data_size);
+            if(rgb == NULL) return;
+            video->lcdBuffer[0] = rgb;
         }
+        if(!updateScaleTables(video, width, height)) return;
 
-        height = height / 2;
-        width = width / 2;
-        pPtr = dst[1];
-        for(int i = 0; i < height; i++) {
-            memcpy(pu + i * width, pPtr, width);
-            pPtr += UVStride;
-        }
-        pPtr = dst[2];
-        for(int i = 0; i < height; i++) {
-            memcpy(pv + i * width, pPtr, width);
-            pPtr += UVStride;
-        }
-        yuv420pToRgb565(width * 2, height * 2, video_width, video_height, py, pu, pv, (uint16_t *)rgb);
+        /*Convert straight from the decoder's planes, no need to copy them first*/
+        yuv420pToColor(video, dst[0], dst[1], dst[2], YStride, UVStride, (lv_color_t *)rgb);
+        video->stats.decoded++;
+        video->stats.shown++;
         // update the image data.
         video->frameImage.data = rgb;
         lv_img_set_src(obj, &video->frameImage);
         lv_img_cache_invalidate_src(lv_img_get_src(obj));
         lv_obj_invalidate(obj);
         lv_task_handler();
-        usleep(30 * 1000);
+        usleep(1000 * 1000 / video->fps);
     }
 }
 
-static void yuv420pToRgb565(int oriWidth, int oriHeight, int width, int height, uint8_t * py, uint8_t * pu,
-                            uint8_t * pv, unsigned short * dst)
+/**
+ * Compute which source row and column is sampled for each row and column of the video.
+ * The tables are only recalculated if the size of the decoded frames changes.
+ * @param video pointer to a video object
+ * @param oriWidth width of the decoded frame
+ * @param oriHeight height of the decoded frame
+ * @return true: the tables are ready; false: out of memory
+ */
+static bool updateScaleTables(lv_video_t * video, int oriWidth, int oriHeight)
 {
-    int y, u, v, yy, vr, ug, vg, ub;
-    int r, g, b;
-    int oriLine, oriCol;
-
-    for(int i = 0; i < height; i++) {
-        oriLine = i * oriHeight / height;
-        for(int j = 0; j < width; j++) {
-            oriCol = j * oriWidth / width;
-            y = py[oriLine * oriWidth + oriCol];
-            yy = y << 8;
-            u = pu[(oriLine / 2) * (oriWidth / 2) + (oriCol / 2)] - 128;
-            ug = 88 * u;
-            ub = 454 * u;
-            v = pv[(oriLine / 2) * (oriWidth / 2) + (oriCol / 2)] - 128;
-            vg = 183 * v;
-            vr = 359 * v;
-
-            r = (yy + vr) >> 8;
-            g = (yy - ug - vg) >> 8;
-            b = (yy + ub) >> 8;
-            if(r < 0)
-                r = 0;
-            if(r > 255)
-                r = 255;
-            if(g < 0)
-                g = 0;
-            if(g > 255)
-                g = 255;
-            if(b < 0)
-                b = 0;
-            if(b > 255)
-                b = 255;
-            dst[i * width + j] = (((unsigned short)r >> 3) << 11) | (((unsigned short)g >> 2) << 5) | (((
-                                                                                                            unsigned short)b >> 3) << 0);
+    if(video->colTbl && video->srcWidth == oriWidth && video->srcHeight == oriHeight) {
+        return true;
+    }
+
+    int width = video->frameImage.header.w;
+    int height = video->frameImage.header.h;
+    free(video->colTbl);
+    video->colTbl = malloc((width + height) * sizeof(uint16_t));
+    if(video->colTbl == NULL) return false;
+    video->rowTbl = video->colTbl + width;
+
+    int i;
+    for(i = 0; i < width; i++) {
+        video->colTbl[i] = i * oriWidth / width;
+    }
+
+    for(i = 0; i < height; i++) {
+        video->rowTbl[i] = i * oriHeight / height;
+    }
+
+    video->srcWidth = oriWidth;
+    video->srcHeight = oriHeight;
+    return true;
+}
+
+/**
+ * Convert a YUV420p frame to the current color depth and scale it to the size of the video.
+ * `updateScaleTables()` needs to be called before for the size of the frame.
+ * @param video pointer to a video object
+ * @param py pointer to the Y plane
+ * @param pu pointer to the U plane
+ * @param pv pointer to the V plane
+ * @param yStride byte offset between two rows of the Y plane
+ * @param uvStride byte offset between two rows of the U and V planes
+ * @param dst store the converted pixels here
+ */
+static void yuv420pToColor(lv_video_t * video, const uint8_t * py, const uint8_t * pu, const uint8_t * pv,
+                           int yStride, int uvStride, lv_color_t * dst)
+{
+    int width = video->frameImage.header.w;
+    int height = video->frameImage.header.h;
+
+    /*If there is no horizontal scaling the planes can be read as they are*/
+    const uint16_t * colTbl = video->srcWidth == width ? NULL : video->colTbl;
+    int prevRow = -1;
+    int i;
+    for(i = 0; i < height; i++) {
+        int oriLine = video->rowTbl[i];
+        lv_color_t * dstRow = dst + i * width;
+        if(oriLine == prevRow) {
+            /*Upscaling: the same source row again*/
+            memcpy(dstRow, dstRow - width, width * sizeof(lv_color_t));
+            continue;
         }
+
+        yuv420pRowToColor(py + oriLine * yStride, pu + (oriLine / 2) * uvStride, pv + (oriLine / 2) * uvStride,
+                          colTbl, dstRow, width);
+        prevRow = oriLine;
     }
 }
+
+/**
+ * Convert one row of YUV420p pixels. Blocks of 8 pixels are converted with NEON or SSE2 if available.
+ * @param py pointer to the row in the Y plane
+ * @param pu pointer to the row in the U plane
+ * @param pv pointer to the row in the V plane
+ * @param colTbl source column for each pixel or NULL to read `width` pixels without scaling
+ * @param dst store the converted pixels here
+ * @param width number of pixels to convert
+ */
+static void yuv420pRowToColor(const uint8_t * py, const uint8_t * pu, const uint8_t * pv,
+                              const uint16_t * colTbl, lv_color_t * dst, int width)
+{
+    int j = 0;
+#if (LV_COLOR_DEPTH == 16 || LV_COLOR_DEPTH == 32) && (defined(__ARM_NEON) || defined(__SSE2__))
+    uint8_t y8[8];
+    uint8_t u8[8];
+    uint8_t v8[8];
+    for(; j + 8 <= width; j += 8) {
+        const uint8_t * y;
+        int k;
+        if(colTbl) {
+            for(k = 0; k < 8; k++) {
+                int oriCol = colTbl[j + k];
+                y8[k] = py[oriCol];
+                u8[k] = pu[oriCol / 2];
+                v8[k] = pv[oriCol / 2];
+            }
+            y = y8;
+        }
+        else {
+            for(k = 0; k < 8; k++) {
+                u8[k] = pu[(j + k) / 2];
+                v8[k] = pv[(j + k) / 2];
+            }
+            y = py + j;
+        }
+
+        /* The same math as `yuvToColor()` but the coefficients are split so that everything fits to 16 bit.
+         * E.g. (359 * v) >> 8 == v + ((103 * v) >> 8)*/
+#if defined(__ARM_NEON)
+        int16x8_t yy = vreinterpretq_s16_u16(vmovl_u8(vld1_u8(y)));
+        int16x8_t u = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(vld1_u8(u8))), vdupq_n_s16(128));
+        int16x8_t v = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(vld1_u8(v8))), vdupq_n_s16(128));
+
+        int16x8_t dr = vaddq_s16(v, vshrq_n_s16(vmulq_n_s16(v, 103), 8));
+        int16x8_t dg = vsubq_s16(vshrq_n_s16(vsubq_s16(vmulq_n_s16(v, 73), vmulq_n_s16(u, 88)), 8), v);
+        int16x8_t db = vaddq_s16(vaddq_s16(u, u), vshrq_n_s16(vmulq_n_s16(u, -58), 8));
+
+        uint8x8_t r = vqmovun_s16(vaddq_s16(yy, dr));
+        uint8x8_t g = vqmovun_s16(vaddq_s16(yy, dg));
+        uint8x8_t b = vqmovun_s16(vaddq_s16(yy, db));
+#if LV_COLOR_DEPTH == 32
+        uint8x8x4_t px = {{b, g, r, vdup_n_u8(0xFF)}};
+        vst4_u8((uint8_t *)(dst + j), px);
+#else
+        uint16x8_t c = vshlq_n_u16(vmovl_u8(vshr_n_u8(r, 3)), 11);
+        c = vorrq_u16(c, vshlq_n_u16(vmovl_u8(vshr_n_u8(g, 2)), 5));
+        c = vorrq_u16(c, vmovl_u8(vshr_n_u8(b, 3)));
+#if LV_COLOR_16_SWAP
+        c = vreinterpretq_u16_u8(vrev16q_u8(vreinterpretq_u8_u16(c)));
+#endif
+        vst1q_u16((uint16_t *)(dst + j), c);
+#endif
+#elif defined(__SSE2__)
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i c128 = _mm_set1_epi16(128);
+        __m128i yy = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)y), zero);
+        __m128i u = _mm_sub_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)u8), zero), c128);
+        __m128i v = _mm_sub_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)v8), zero), c128);
+
+        __m128i dr = _mm_add_epi16(v, _mm_srai_epi16(_mm_mullo_epi16(v, _mm_set1_epi16(103)), 8));
+        __m128i dg = _mm_sub_epi16(_mm_srai_epi16(_mm_sub_epi16(_mm_mullo_epi16(v, _mm_set1_epi16(73)),
+                                                                _mm_mullo_epi16(u, _mm_set1_epi16(88))), 8), v);
+        __m128i db = _mm_add_epi16(_mm_add_epi16(u, u), _mm_srai_epi16(_mm_mullo_epi16(u, _mm_set1_epi16(-58)), 8));
+
+        /*Saturate to 0..255 and widen again*/
+        __m128i r = _mm_unpacklo_epi8(_mm_packus_epi16(_mm_add_epi16(yy, dr), zero), zero);
+        __m128i g = _mm_unpacklo_epi8(_mm_packus_epi16(_mm_add_epi16(yy, dg), zero), zero);
+        __m128i b = _mm_unpacklo_epi8(_mm_packus_epi16(_mm_add_epi16(yy, db), zero), zero);
+#if LV_COLOR_DEPTH == 32
+        __m128i bg = _mm_or_si128(b, _mm_slli_epi16(g, 8));
+        __m128i ra = _mm_or_si128(r, _mm_set1_epi16((short)0xFF00));
+        _mm_storeu_si128((__m128i *)(dst + j), _mm_unpacklo_epi16(bg, ra));
+        _mm_storeu_si128((__m128i *)(dst + j + 4), _mm_unpackhi_epi16(bg, ra));
+#else
+        __m128i c = _mm_slli_epi16(_mm_srli_epi16(r, 3), 11);
+        c = _mm_or_si128(c, _mm_slli_epi16(_mm_srli_epi16(g, 2), 5));
+        c = _mm_or_si128(c, _mm_srli_epi16(b, 3));
+#if LV_COLOR_16_SWAP
+        c = _mm_or_si128(_mm_slli_epi16(c, 8), _mm_srli_epi16(c, 8));
+#endif
+        _mm_storeu_si128((__m128i *)(dst + j), c);
+#endif
+#endif
+    }
+#endif
+
+    for(; j < width; j++) {
+        int oriCol = colTbl ? colTbl[j] : j;
+        dst[j] = yuvToColor(py[oriCol], pu[oriCol / 2], pv[oriCol / 2]);
+    }
+}
+
+/**
+ * Convert one YUV pixel to the current color depth
+ * @param y luma
+ * @param u blue difference chroma
+ * @param v red difference chroma
+ * @return the color
+ */
+static inline lv_color_t yuvToColor(int y, int u, int v)
+{
+    int r, g, b;
+
+    u -= 128;
+    v -= 128;
+    r = y + ((359 * v) >> 8);
+    g = y + ((-88 * u - 183 * v) >> 8);
+    b = y + ((454 * u) >> 8);
+
+    r = LV_CLAMP(0, r, 255);
+    g = LV_CLAMP(0, g, 255);
+    b = LV_CLAMP(0, b, 255);
+    return lv_color_make(r, g, b);
+}
 #endif
 
+
 /*=====================
  * Setter functions
  *====================*/
@@ -530,6 +724,26 @@ void lv_video_set_status(lv_obj_t * obj, int status)
     video->play_status = status;
 }
 
+void lv_video_set_fps(lv_obj_t * obj, uint16_t fps)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    lv_video_t * video = (lv_video_t *)obj;
+
+    if(fps == 0) fps = 1;
+    video->fps = fps;
+
+#if VIDEO_USE_THREADS
+    lv_video_worker_t * worker = video->worker;
+    if(worker) {
+        pthread_mutex_lock(&s_pool.mutex);
+        worker->frame_period = 1000 / fps;
+        pthread_mutex_unlock(&s_pool.mutex);
+        lv_timer_set_period(worker->timer, LV_MAX(500 / fps, 1));
+    }
+#endif
+}
+
 /*=====================
  * Getter functions
  *====================*/
@@ -552,6 +766,32 @@ const char * lv_video_get_src(lv_obj_t * obj)
     return video->file_name;
 }
 
+uint16_t lv_video_get_fps(lv_obj_t * obj)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    lv_video_t * video = (lv_video_t *)obj;
+
+    return video->fps;
+}
+
+void lv_video_get_stats(lv_obj_t * obj, lv_video_stats_t * stats)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    lv_video_t * video = (lv_video_t *)obj;
+
+#if VIDEO_USE_THREADS
+    if(video->worker) {
+        pthread_mutex_lock(&s_pool.mutex);
+        *stats = video->stats;
+        pthread_mutex_unlock(&s_pool.mutex);
+        return;
+    }
+#endif
+    *stats = video->stats;
+}
+
 
 /**********************
  *   STATIC FUNCTIONS
@@ -564,13 +804,21 @@ static void lv_video_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
 
     video->play_status = 1;
     video->exist = false;
-    OpenH264_Init();
+    video->fps = VIDEO_DEF_FPS;
     video->frameImage.header.always_zero = 0;
     video->frameImage.header.cf = LV_IMG_CF_TRUE_COLOR;
     video->frameImage.header.w = video_width;
     video->frameImage.header.h = video_height;
     video->frameImage.data_size = video_width * video_height * LV_COLOR_SIZE / 8;
     video->blk.data = (uint8_t *)malloc(DEMO_FILE_BUF_SIZE + 4);
+    video->decodeBuf = (uint8_t *)malloc(DEMO_DECODE_BUF_SIZE);
+    if(video->decodeBuf == NULL || !decoderCreate(video)) {
+        LV_LOG_ERROR("Could not create the decoder");
+    }
+#if !LV_USE_GUIDER_SIMULATOR
+    video->lcdBuffer[0] = calloc(1, video_width * video_height * buffer_byte_per_pixel);
+    video->lcdBuffer[1] = calloc(1, video_width * video_height * buffer_byte_per_pixel);
+#endif
     video->frameImage.data = NULL;
     video->fileStart = true;
     LV_TRACE_OBJ_CREATE("finished");
@@ -582,27 +830,685 @@ static void lv_video_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     LV_UNUSED(class_p);
     lv_video_t * video = (lv_video_t *)obj;
     video->exist = true;
+#if VIDEO_USE_THREADS
+    videoThreadStop(obj);
+#endif
     if(video->blk.data) {
         free(video->blk.data);
         video->blk.data = NULL;
     }
 
+    decoderDelete(video);
+    free(video->decodeBuf);
+    video->decodeBuf = NULL;
+    free(video->lcdBuffer[0]);
+    free(video->lcdBuffer[1]);
+    video->lcdBuffer[0] = NULL;
+    video->lcdBuffer[1] = NULL;
+    free(video->colTbl);
+    video->colTbl = NULL;
+    video->rowTbl = NULL;
+#if !LV_USE_GUIDER_SIMULATOR
+    if(s_pxpConfiguredObj == obj) s_pxpConfiguredObj = NULL;
+#endif
+    lv_img_cache_invalidate_src(lv_img_get_src(obj));
+}
+
+/**
+ * Pass a decoded frame to the PXP or the CPU conversion
+ * @param obj pointer to a video object
+ * @param info the output info of the decoder
+ * @param dst pointers to the Y, U and V planes
+ */
+static void displayFrame(lv_obj_t * obj, SBufferInfo * info, unsigned char ** dst)
+{
 #if LV_USE_GUIDER_SIMULATOR
-    mallocInit = 0;
-    if(rgb) {
-        free(py);
-        free(pu);
-        free(pv);
-        free(rgb);
-    }
+    CPU_DisplayFrame(*info, dst, obj);
 #else
-    if(s_lcdBuffer[0] != NULL && s_lcdBuffer[1] != NULL) {
-        free(s_lcdBuffer[0]);
-        free(s_lcdBuffer[1]);
-        s_lcdBuffer[0] = NULL;
-        s_lcdBuffer[1] = NULL;
+    LV_UNUSED(dst);
+    PXP_DisplayFrame(
+        info->UsrData.sSystemBuffer.iWidth, info->UsrData.sSystemBuffer.iHeight,
+        info->pDst[0], info->pDst[1], info->pDst[2],
+        info->UsrData.sSystemBuffer.iStride[0], info->UsrData.sSystemBuffer.iStride[1], obj);
+#endif
+}
+
+/**
+ * Create the H.264 decoder of a video
+ * @param video pointer to a video object
+ * @return true: the decoder is ready; false: error
+ */
+static bool decoderCreate(lv_video_t * video)
+{
+#if LV_USE_GUIDER_SIMULATOR
+    ISVCDecoder * decoder = NULL;
+    if(WelsCreateDecoder(&decoder) != 0 || decoder == NULL) {
+        return false;
     }
+
+    SDecodingParam param;
+    memset(&param, 0, sizeof(param));
+    param.sVideoProperty.eVideoBsType = VIDEO_BITSTREAM_DEFAULT;
+    param.uiTargetDqLayer = (uint8_t) -1;
+    if((*decoder)->Initialize(decoder, &param) != 0) {
+        WelsDestroyDecoder(decoder);
+        return false;
+    }
+
+    video->decoder = decoder;
+    return true;
+#else
+    LV_UNUSED(video);
+    if(s_decoderRefCnt == 0) OpenH264_Init();
+    s_decoderRefCnt++;
+    return true;
+#endif
+}
+
+/**
+ * Delete the H.264 decoder of a video
+ * @param video pointer to a video object
+ */
+static void decoderDelete(lv_video_t * video)
+{
+#if LV_USE_GUIDER_SIMULATOR
+    ISVCDecoder * decoder = video->decoder;
+    if(decoder == NULL) return;
+
+    (*decoder)->Uninitialize(decoder);
+    WelsDestroyDecoder(decoder);
+    video->decoder = NULL;
+#else
+    LV_UNUSED(video);
+    if(s_decoderRefCnt == 0) return;
+    s_decoderRefCnt--;
+    if(s_decoderRefCnt == 0) OpenH264_Uninit();
+#endif
+}
+
+/**
+ * Decode a NALU
+ * @param video pointer to a video object
+ * @param src pointer to the NALU
+ * @param len size of the NALU
+ * @param dst store the pointers to the Y, U and V planes here
+ * @param info store the output info of the decoder here
+ * @return 0: no error; else: decoding error
+ */
+static int decoderDecode(lv_video_t * video, const uint8_t * src, int32_t len, unsigned char ** dst,
+                         SBufferInfo * info)
+{
+#if LV_USE_GUIDER_SIMULATOR
+    ISVCDecoder * decoder = video->decoder;
+    if(decoder == NULL) return -1;
+
+    memset(info, 0, sizeof(SBufferInfo));
+    return (*decoder)->DecodeFrameNoDelay(decoder, src, len, dst, info);
+#else
+    LV_UNUSED(video);
+    return OpenH264_Decode(src, len, dst, info);
+#endif
+}
+
+/**
+ * Get the number of frames which are still in the decoder at the end of the stream
+ * @param video pointer to a video object
+ * @return number of frames to get with `decoderFlushFrame()`
+ */
+static int32_t decoderRemainingFrames(lv_video_t * video)
+{
+    int32_t cnt = 0;
+#if LV_USE_GUIDER_SIMULATOR
+    ISVCDecoder * decoder = video->decoder;
+    if(decoder == NULL) return 0;
+
+    (*decoder)->GetOption(decoder, DECODER_OPTION_NUM_OF_FRAMES_REMAINING_IN_BUFFER, &cnt);
+#else
+    LV_UNUSED(video);
+    OpenH264_GetOption(&cnt);
+#endif
+    return cnt;
+}
+
+/**
+ * Get a frame which is still in the decoder at the end of the stream
+ * @param video pointer to a video object
+ * @param dst store the pointers to the Y, U and V planes here
+ * @param info store the output info of the decoder here
+ */
+static void decoderFlushFrame(lv_video_t * video, unsigned char ** dst, SBufferInfo * info)
+{
+#if LV_USE_GUIDER_SIMULATOR
+    ISVCDecoder * decoder = video->decoder;
+    memset(info, 0, sizeof(SBufferInfo));
+    if(decoder == NULL) return;
+
+    (*decoder)->FlushFrame(decoder, dst, info);
+#else
+    LV_UNUSED(video);
+    OpenH264_FlashFrame(dst, info);
 #endif
+}
+
+/**
+ * Drop the buffered data, e.g. at the start of the file
+ * @param video pointer to a video object
+ */
+static void decodeBufReset(lv_video_t * video)
+{
+    video->decodeBufStart = 0;
+    video->decodeBufEnd   = 0;
+    video->decodeBufScan  = 0;
+}
+
+/**
+ * Make room for new data in the decode buffer. The buffer is compacted only if its end is reached.
+ * @param video pointer to a video object
+ * @return number of bytes which can be added after `decodeBufEnd`
+ */
+static int32_t decodeBufPrepare(lv_video_t * video)
+{
+    if(video->decodeBufEnd == DEMO_DECODE_BUF_SIZE) {
+        if(video->decodeBufStart == 0) {
+            /* After searching the full buffer, no slice found, then drop the data in buffer. */
+            video->decodeBufEnd   = 0;
+            video->decodeBufScan  = 0;
+        }
+        else {
+            /* Move the incomplete NALU to the start of decode buffer,
+             * left input data will be appended to the end.
+             */
+            memmove(video->decodeBuf, &video->decodeBuf[video->decodeBufStart],
+                    video->decodeBufEnd - video->decodeBufStart);
+            video->decodeBufEnd -= video->decodeBufStart;
+            video->decodeBufScan = LV_MAX(video->decodeBufScan - video->decodeBufStart, 0);
+            video->decodeBufStart = 0;
+        }
+    }
+
+    return DEMO_DECODE_BUF_SIZE - video->decodeBufEnd;
+}
+
+/**
+ * Find the next complete NALU in the decode buffer. Too small slices are skipped.
+ * @param video pointer to a video object
+ * @param endOfInput true: no more data will be added, so the remaining data is the last NALU
+ * @return size of the NALU at `decodeBufStart` or 0 if more data is needed
+ */
+static int32_t decodeBufNextNalu(lv_video_t * video, bool endOfInput)
+{
+    while(video->decodeBufStart < video->decodeBufEnd) {
+        int32_t sliceSize = search_nalu(video->decodeBuf, video->decodeBufStart, &video->decodeBufScan,
+                                        video->decodeBufEnd);
+        /* Could not find NALU. */
+        if(sliceSize < 0) {
+            /* This is the file end part, pass them all to H264 decoder. */
+            if(endOfInput) {
+                return video->decodeBufEnd - video->decodeBufStart;
+            }
+            /* Have processed all slice in the buffer. */
+            return 0;
+        }
+        /* Slice size too small, skip it. */
+        else if(sliceSize < 4) {
+            video->decodeBufStart += sliceSize;
+            continue;
+        }
+        return sliceSize;
+    }
+
+    decodeBufReset(video);
+    return 0;
+}
+
+/**
+ * Decode the NALU at the start of the decode buffer and remove it from the buffer
+ * @param video pointer to a video object
+ * @param size size of the NALU returned by `decodeBufNextNalu()`
+ * @param dst store the pointers to the Y, U and V planes here
+ * @param info store the output info of the decoder here
+ * @return true: a frame is ready
+ */
+static bool decodeNalu(lv_video_t * video, int32_t size, unsigned char ** dst, SBufferInfo * info)
+{
+    int res = decoderDecode(video, &video->decodeBuf[video->decodeBufStart], size, dst, info);
+    video->decodeBufStart += size;
+    if(res != 0) {
+        LV_LOG_ERROR("decode error\r\n");
+        return false;
+    }
+
+    return info->iBufferStatus == 1;
+}
+
+/**
+ * Read the next block of the H.264 file into `video->blk`
+ * @param video pointer to a video object
+ * @return LV_FS_RES_OK or an error from the file system
+ */
+static lv_fs_res_t readFileBlock(lv_video_t * video)
+{
+    uint32_t bytesRead;
+    lv_fs_res_t res = lv_fs_read(&video->h264File, video->blk.data, DEMO_FILE_BUF_SIZE, &bytesRead);
+    if(res != LV_FS_RES_OK) {
+        return res;
+    }
+
+    video->blk.len           = bytesRead;
+    video->blk.isEndOfFile   = (DEMO_FILE_BUF_SIZE > bytesRead);
+    video->blk.isStartOfFile = video->fileStart;
+    video->fileStart         = false;
+    return LV_FS_RES_OK;
+}
+
+#if VIDEO_USE_THREADS
+
+/**
+ * Open the file, allocate the frame buffers and add the video to the decoder threads.
+ * The threads are started with the first video. Does nothing if the video is already playing.
+ * @param obj pointer to a video object
+ */
+static void videoThreadStart(lv_obj_t * obj)
+{
+    lv_video_t * video = (lv_video_t *)obj;
+    if(video->worker || video->file_name == NULL || video->decodeBuf == NULL || video->decoder == NULL) return;
+
+    if(lv_fs_open(&video->h264File, video->file_name, LV_FS_MODE_RD) != LV_FS_RES_OK) {
+        LV_LOG_WARN("can't open %s", video->file_name);
+        return;
+    }
+
+    lv_video_worker_t * worker = calloc(1, sizeof(lv_video_worker_t));
+    if(worker == NULL) {
+        lv_fs_close(&video->h264File);
+        return;
+    }
+
+    /* Read the first block here so that the read cache of the file system driver is allocated
+     * by the UI thread. The decoder threads only read and seek. */
+    video->worker = worker;
+    decodeBufReset(video);
+    if(videoReadInput(video) != LV_FS_RES_OK) {
+        video->worker = NULL;
+        free(worker);
+        lv_fs_close(&video->h264File);
+        return;
+    }
+
+    uint32_t i;
+    for(i = 0; i < FRAME_BUF_CNT; i++) {
+        worker->frames[i].buf = malloc(video->frameImage.data_size);
+        if(worker->frames[i].buf == NULL) {
+            LV_LOG_ERROR("Could not allocate frame buffer %d", (int)i);
+            while(i > 0) {
+                i--;
+                free(worker->frames[i].buf);
+            }
+            video->worker = NULL;
+            free(worker);
+            lv_fs_close(&video->h264File);
+            return;
+        }
+        worker->frames[i].state = VIDEO_FRAME_FREE;
+    }
+
+    worker->obj = obj;
+    worker->frame_act = -1;
+    worker->frame_period = 1000 / video->fps;
+    worker->clock_sync = true;
+
+    pthread_mutex_lock(&s_pool.mutex);
+    while(s_pool.thread_cnt < LV_VIDEO_THREAD_CNT) {
+        if(pthread_create(&s_pool.threads[s_pool.thread_cnt], NULL, videoPoolThread, NULL) != 0) break;
+        s_pool.thread_cnt++;
+    }
+
+    if(s_pool.thread_cnt == 0) {
+        pthread_mutex_unlock(&s_pool.mutex);
+        LV_LOG_ERROR("Could not start the decoder threads");
+        for(i = 0; i < FRAME_BUF_CNT; i++) {
+            free(worker->frames[i].buf);
+        }
+        video->worker = NULL;
+        free(worker);
+        lv_fs_close(&video->h264File);
+        return;
+    }
+
+    lv_video_worker_t ** tail = &s_pool.videos;
+    while(*tail) tail = &(*tail)->next;
+    *tail = worker;
+    pthread_cond_broadcast(&s_pool.cond);
+    pthread_mutex_unlock(&s_pool.mutex);
+
+    worker->timer = lv_timer_create(videoTimerCb, LV_MAX(500 / video->fps, 1), obj);
+}
+
+/**
+ * Remove the video from the decoder threads, close the file and free the frame buffers.
+ * The threads are stopped with the last video.
+ * @param obj pointer to a video object
+ */
+static void videoThreadStop(lv_obj_t * obj)
+{
+    lv_video_t * video = (lv_video_t *)obj;
+    lv_video_worker_t * worker = video->worker;
+    if(worker == NULL) return;
+
+    pthread_mutex_lock(&s_pool.mutex);
+    worker->stop = true;
+    while(worker->busy) {
+        pthread_cond_wait(&s_pool.cond, &s_pool.mutex);
+    }
+
+    lv_video_worker_t ** prev = &s_pool.videos;
+    while(*prev != worker) prev = &(*prev)->next;
+    *prev = worker->next;
+
+    uint32_t thread_cnt = 0;
+    if(s_pool.videos == NULL) {
+        s_pool.quit = true;
+        thread_cnt = s_pool.thread_cnt;
+        pthread_cond_broadcast(&s_pool.cond);
+    }
+    pthread_mutex_unlock(&s_pool.mutex);
+
+    if(thread_cnt) {
+        uint32_t t;
+        for(t = 0; t < thread_cnt; t++) {
+            pthread_join(s_pool.threads[t], NULL);
+        }
+        pthread_mutex_lock(&s_pool.mutex);
+        s_pool.thread_cnt = 0;
+        s_pool.quit = false;
+        pthread_mutex_unlock(&s_pool.mutex);
+    }
+
+    lv_timer_del(worker->timer);
+    lv_fs_close(&video->h264File);
+
+    LV_LOG_INFO("decoded: %d, shown: %d, dropped: %d frames",
+                (int)video->stats.decoded, (int)video->stats.shown, (int)video->stats.dropped);
+
+    uint32_t i;
+    for(i = 0; i < FRAME_BUF_CNT; i++) {
+        free(worker->frames[i].buf);
+    }
+    video->frameImage.data = NULL;
+    video->worker = NULL;
+    free(worker);
+}
+
+/**
+ * Read the next part of the file straight into the decode buffer
+ * @param video pointer to a video object
+ * @return LV_FS_RES_OK or an error from the file system
+ */
+static lv_fs_res_t videoReadInput(lv_video_t * video)
+{
+    int32_t size = LV_MIN(decodeBufPrepare(video), DEMO_FILE_BUF_SIZE);
+    uint32_t bytesRead;
+    lv_fs_res_t res = lv_fs_read(&video->h264File, &video->decodeBuf[video->decodeBufEnd], size, &bytesRead);
+    if(res != LV_FS_RES_OK) {
+        return res;
+    }
+
+    video->decodeBufEnd += bytesRead;
+    video->worker->input_end = ((uint32_t)size > bytesRead);
+    return LV_FS_RES_OK;
+}
+
+/**
+ * Decode until the next frame is ready. The file is played in a loop.
+ * Called in a decoder thread which has reserved the video.
+ * @param video pointer to a video object
+ * @param dst store the pointers to the Y, U and V planes here
+ * @param info store the output info of the decoder here
+ * @return 1: a frame is ready; -1: the video can't be played
+ */
+static int videoDecodeNext(lv_video_t * video, unsigned char ** dst, SBufferInfo * info)
+{
+    lv_video_worker_t * worker = video->worker;
+
+    while(1) {
+        /* Get the frames left in the decoder at the end of the file */
+        if(worker->flush_cnt > 0) {
+            worker->flush_cnt--;
+            dst[0] = NULL;
+            dst[1] = NULL;
+            dst[2] = NULL;
+            decoderFlushFrame(video, dst, info);
+            if(info->iBufferStatus == 1) {
+                worker->pass_frames++;
+                return 1;
+            }
+            continue;
+        }
+
+        int32_t sliceSize = decodeBufNextNalu(video, worker->input_end);
+        if(sliceSize > 0) {
+            if(decodeNalu(video, sliceSize, dst, info)) {
+                worker->pass_frames++;
+                return 1;
+            }
+            continue;
+        }
+
+        if(worker->input_end) {
+            if(!worker->flushed) {
+                worker->flushed = true;
+                worker->flush_cnt = decoderRemainingFrames(video);
+                continue;
+            }
+
+            /* Play it again if there was anything to play */
+            if(worker->pass_frames == 0) return -1;
+            if(lv_fs_seek(&video->h264File, 0, LV_FS_SEEK_SET) != LV_FS_RES_OK) return -1;
+            decodeBufReset(video);
+            worker->input_end = false;
+            worker->flushed = false;
+            worker->pass_frames = 0;
+        }
+
+        if(videoReadInput(video) != LV_FS_RES_OK) return -1;
+    }
+}
+
+/**
+ * Decode and convert the frames of the playing videos in turns
+ */
+static void * videoPoolThread(void * arg)
+{
+    LV_UNUSED(arg);
+    SBufferInfo info;
+    unsigned char * dst[3];
+
+    pthread_mutex_lock(&s_pool.mutex);
+    while(!s_pool.quit) {
+        video_frame_t * frame;
+        lv_video_worker_t * worker = videoPoolGetJob(&frame);
+        if(worker == NULL) {
+            pthread_cond_wait(&s_pool.cond, &s_pool.mutex);
+            continue;
+        }
+
+        worker->busy = true;
+        frame->state = VIDEO_FRAME_CONVERTING;
+        pthread_mutex_unlock(&s_pool.mutex);
+
+        lv_video_t * video = (lv_video_t *)worker->obj;
+        int res = videoDecodeNext(video, dst, &info);
+        if(res > 0) {
+            videoConvertFrame(worker, frame, dst, &info);
+        }
+
+        pthread_mutex_lock(&s_pool.mutex);
+        if(res < 0) {
+            frame->state = VIDEO_FRAME_FREE;
+            worker->failed = true;
+        }
+        worker->busy = false;
+        pthread_cond_broadcast(&s_pool.cond);
+    }
+    pthread_mutex_unlock(&s_pool.mutex);
+
+    return NULL;
+}
+
+/**
+ * Find a video which needs a new frame. The found video is moved to the end of the list
+ * so that the videos get their turns. Called with the mutex of the pool locked.
+ * @param frame store the free frame buffer of the video here
+ * @return pointer to the worker of the video or NULL if there is nothing to do
+ */
+static lv_video_worker_t * videoPoolGetJob(video_frame_t ** frame)
+{
+    lv_video_worker_t ** prev = &s_pool.videos;
+    while(*prev) {
+        lv_video_worker_t * worker = *prev;
+        if(!worker->busy && !worker->stop && !worker->failed) {
+            uint32_t i;
+            for(i = 0; i < FRAME_BUF_CNT; i++) {
+                if(worker->frames[i].state == VIDEO_FRAME_FREE) break;
+            }
+
+            if(i < FRAME_BUF_CNT) {
+                *frame = &worker->frames[i];
+                if(worker->next) {
+                    *prev = worker->next;
+                    lv_video_worker_t ** tail = prev;
+                    while(*tail) tail = &(*tail)->next;
+                    *tail = worker;
+                    worker->next = NULL;
+                }
+                return worker;
+            }
+        }
+        prev = &worker->next;
+    }
+
+    return NULL;
+}
+
+/**
+ * Convert a decoded frame into the reserved frame buffer and queue it to be shown by the UI thread.
+ * Called in a decoder thread. Frames which are already late are not converted.
+ * @param worker pointer to the worker of the video
+ * @param frame the frame buffer reserved for this frame
+ * @param dst pointers to the Y, U and V planes
+ * @param info the output info of the decoder
+ */
+static void videoConvertFrame(lv_video_worker_t * worker, video_frame_t * frame, unsigned char ** dst,
+                              SBufferInfo * info)
+{
+    lv_video_t * video = (lv_video_t *)worker->obj;
+
+    pthread_mutex_lock(&s_pool.mutex);
+    uint32_t pts = worker->next_pts;
+    worker->next_pts += worker->frame_period;
+    video->stats.decoded++;
+
+    bool late = worker->clock_valid && (int32_t)(pts + worker->frame_period - worker->clock_ms) < 0;
+    if(late) video->stats.dropped++;
+    pthread_mutex_unlock(&s_pool.mutex);
+
+    /* The scale tables are used only by the thread which is decoding the video */
+    bool converted = false;
+    if(!late && updateScaleTables(video, info->UsrData.sSystemBuffer.iWidth, info->UsrData.sSystemBuffer.iHeight)) {
+        yuv420pToColor(video, dst[0], dst[1], dst[2],
+                       info->UsrData.sSystemBuffer.iStride[0], info->UsrData.sSystemBuffer.iStride[1], frame->buf);
+        converted = true;
+    }
+
+    pthread_mutex_lock(&s_pool.mutex);
+    if(converted) {
+        frame->pts = pts;
+        frame->seq = worker->frame_seq++;
+        frame->state = VIDEO_FRAME_QUEUED;
+    }
+    else {
+        frame->state = VIDEO_FRAME_FREE;
+    }
+    pthread_mutex_unlock(&s_pool.mutex);
+}
+
+/**
+ * Get the oldest converted frame
+ * @param worker pointer to the worker of the video
+ * @param skip don't return this frame
+ * @return pointer to a frame or NULL if there is no queued frame
+ */
+static video_frame_t * videoGetQueuedFrame(lv_video_worker_t * worker, video_frame_t * skip)
+{
+    video_frame_t * oldest = NULL;
+    uint32_t i;
+    for(i = 0; i < FRAME_BUF_CNT; i++) {
+        video_frame_t * frame = &worker->frames[i];
+        if(frame == skip || frame->state != VIDEO_FRAME_QUEUED) continue;
+        if(oldest == NULL || (int32_t)(frame->seq - oldest->seq) < 0) oldest = frame;
+    }
+
+    return oldest;
+}
+
+/**
+ * Show the queued frame which is due according to the frame rate.
+ * Frames which are already late are dropped.
+ * @param timer pointer to the timer of the video
+ */
+static void videoTimerCb(lv_timer_t * timer)
+{
+    lv_obj_t * obj = timer->user_data;
+    lv_video_t * video = (lv_video_t *)obj;
+    lv_video_worker_t * worker = video->worker;
+
+    if(video->play_status != 1) {
+        /* Continue from the next frame after resuming */
+        worker->clock_sync = true;
+        return;
+    }
+
+    pthread_mutex_lock(&s_pool.mutex);
+    video_frame_t * next = videoGetQueuedFrame(worker, NULL);
+    if(next == NULL) {
+        pthread_mutex_unlock(&s_pool.mutex);
+        return;
+    }
+
+    if(worker->clock_sync) {
+        worker->clock_start = lv_tick_get() - next->pts;
+        worker->clock_sync = false;
+    }
+    worker->clock_ms = lv_tick_elaps(worker->clock_start);
+    worker->clock_valid = true;
+
+    if((int32_t)(next->pts - worker->clock_ms) > 0) {
+        pthread_mutex_unlock(&s_pool.mutex);
+        return;
+    }
+
+    /* Skip the frames which are due but a newer frame is due too */
+    while(1) {
+        video_frame_t * newer = videoGetQueuedFrame(worker, next);
+        if(newer == NULL || (int32_t)(newer->pts - worker->clock_ms) > 0) break;
+        next->state = VIDEO_FRAME_FREE;
+        video->stats.dropped++;
+        next = newer;
+    }
+
+    if(worker->frame_act >= 0) worker->frames[worker->frame_act].state = VIDEO_FRAME_FREE;
+    next->state = VIDEO_FRAME_SHOWN;
+    worker->frame_act = next - worker->frames;
+    video->stats.shown++;
+    pthread_cond_broadcast(&s_pool.cond);
+    pthread_mutex_unlock(&s_pool.mutex);
+
+    /* The shown buffer is not written by the decoder threads */
+    video->frameImage.data = (const uint8_t *)next->buf;
+    lv_img_set_src(obj, &video->frameImage);
     lv_img_cache_invalidate_src(lv_img_get_src(obj));
+    lv_obj_invalidate(obj);
 }
 #endif
+
+#endif
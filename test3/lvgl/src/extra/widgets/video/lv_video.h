@@ -41,6 +41,14 @@ typedef struct {
     bool isStartOfFile; /* Is start of file. */
 } file_data_block_t;
 
+typedef struct {
+    uint32_t decoded;   /* Frames output by the decoder. */
+    uint32_t shown;     /* Frames set as the image of the widget. */
+    uint32_t dropped;   /* Frames not shown because they were late. */
+} lv_video_stats_t;
+
+struct _lv_video_worker_t;
+
 typedef struct {
     lv_obj_t obj;
     const void * src; /*Image source: Pointer to an array or a file or a symbol*/
@@ -61,6 +69,24 @@ typedef struct {
     file_data_block_t blk;
     bool  fileStart;
     bool exist;
+    uint16_t fps;
+    lv_video_stats_t stats;
+    /* Decoder input */
+    uint8_t * decodeBuf;        /* Buffered part of the H.264 stream */
+    int32_t decodeBufStart;     /* Start of the current NALU in `decodeBuf` */
+    int32_t decodeBufEnd;       /* End of the buffered data */
+    int32_t decodeBufScan;      /* The search for the next NALU continues here */
+    void * decoder;             /* Own decoder instance if the platform supports it */
+    /* Decoder output */
+    uint8_t * lcdBuffer[2];     /* Converted frames, `frameImage.data` points to one of them */
+    uint8_t lcdActiveFbIdx;
+    uint16_t srcWidth;          /* Size of the last decoded frame */
+    uint16_t srcHeight;
+    uint16_t * colTbl;          /* Source column of every output column */
+    uint16_t * rowTbl;          /* Source row of every output row */
+#if LV_VIDEO_USE_THREADS
+    struct _lv_video_worker_t * worker;
+#endif
 } lv_video_t;
 
 extern const lv_obj_class_t lv_video_class;
@@ -96,6 +122,14 @@ lv_obj_t * lv_video_create(lv_obj_t * parent, int widgetWidth, int widgetHeight)
 void lv_video_set_src(lv_obj_t * obj, const char * src);
 
 void lv_video_set_status(lv_obj_t * obj, int status);
+
+/**
+ * Set the frame rate of the video. Raw H.264 streams have no timing information.
+ * @param obj pointer to a video object
+ * @param fps frames per second
+ */
+void lv_video_set_fps(lv_obj_t * obj, uint16_t fps);
+
 /*=====================
  * Getter functions
  *====================*/
@@ -103,6 +137,20 @@ void lv_video_set_status(lv_obj_t * obj, int status);
 int lv_video_get_status(lv_obj_t * obj);
 const char * lv_video_get_src(lv_obj_t * obj);
 
+/**
+ * Get the frame rate of the video
+ * @param obj pointer to a video object
+ * @return frames per second
+ */
+uint16_t lv_video_get_fps(lv_obj_t * obj);
+
+/**
+ * Get the number of decoded, shown and dropped frames since the video was created
+ * @param obj pointer to a video object
+ * @param stats store the counters here
+ */
+void lv_video_get_stats(lv_obj_t * obj, lv_video_stats_t * stats);
+
 /*=====================
  * Other functions
  *====================*/
@@ -90,6 +90,7 @@ lv_font_t * lv_font_load(const char * font_name)
     if(res != LV_FS_RES_OK)
         return NULL;
 
+    lv_mem_tag_t tag_prev = lv_mem_tag_set(LV_MEM_TAG_FONT);
     lv_font_t * font = lv_mem_alloc(sizeof(lv_font_t));
     if(font) {
         memset(font, 0, sizeof(lv_font_t));
@@ -104,6 +105,7 @@ lv_font_t * lv_font_load(const char * font_name)
             font = NULL;
         }
     }
+    lv_mem_tag_set(tag_prev);
 
     lv_fs_close(&file);
 
@@ -191,8 +191,19 @@ typedef struct _lv_disp_t {
     /** Double buffer sync areas */
     lv_ll_t sync_areas;
 
+#if LV_USE_SCROLL_COPY
+    /** Area to move by `scroll_copy_diff` in the frame buffer before the next refresh*/
+    lv_area_t scroll_copy_area;
+    lv_point_t scroll_copy_diff;
+    uint8_t scroll_copy_pending : 1;
+#endif
+
     /*Miscellaneous data*/
     uint32_t last_activity_time;        /**< Last time when there was activity on this display*/
+
+#if LV_ANIM_REFR_SYNC
+    uint32_t refr_time_avg;             /**< Average time of the refreshes. Used to predict when a frame is shown*/
+#endif
 } lv_disp_t;
 
 /**********************
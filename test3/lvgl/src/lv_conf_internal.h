@@ -157,6 +157,38 @@
         #endif
     #endif
 
+    /*Allocate the blocks up to this size from pages of fixed size classes (8, 16, 24, 32, 48, 64, 96, 128, 192, 256, 384, 512 bytes)
+     *instead of the general allocator. It's faster and reduces the fragmentation caused by many small allocations.
+     *Larger blocks still use the general allocator. [bytes] 0: disable the size classes*/
+    #ifndef LV_MEM_SLAB_MAX_SIZE
+        #ifdef CONFIG_LV_MEM_SLAB_MAX_SIZE
+            #define LV_MEM_SLAB_MAX_SIZE CONFIG_LV_MEM_SLAB_MAX_SIZE
+        #else
+            #define LV_MEM_SLAB_MAX_SIZE 0
+        #endif
+    #endif
+
+    /*Make `lv_mem_alloc()`, `lv_mem_free()` and `lv_mem_realloc()` callable from any thread (requires pthread).
+     *The other LVGL functions (including `lv_mem_buf_get()`) still can be called only from the UI thread.*/
+    #ifndef LV_MEM_THREAD_SAFE
+        #ifdef CONFIG_LV_MEM_THREAD_SAFE
+            #define LV_MEM_THREAD_SAFE CONFIG_LV_MEM_THREAD_SAFE
+        #else
+            #define LV_MEM_THREAD_SAFE 0
+        #endif
+    #endif
+    #if LV_MEM_THREAD_SAFE
+        /*Number of freed small blocks (<= 256 bytes) kept per size by each thread to reuse them without locking.
+         *0: always lock*/
+        #ifndef LV_MEM_THREAD_CACHE_CNT
+            #ifdef CONFIG_LV_MEM_THREAD_CACHE_CNT
+                #define LV_MEM_THREAD_CACHE_CNT CONFIG_LV_MEM_THREAD_CACHE_CNT
+            #else
+                #define LV_MEM_THREAD_CACHE_CNT 8
+            #endif
+        #endif
+    #endif
+
 #else       /*LV_MEM_CUSTOM*/
     #ifndef LV_MEM_CUSTOM_INCLUDE
         #ifdef CONFIG_LV_MEM_CUSTOM_INCLUDE
@@ -198,6 +230,29 @@
     #endif
 #endif
 
+/*Serve the intermediate buffers from a static arena instead of `LV_MEM_BUF_MAX_NUM` slots allocated by `lv_mem_alloc()`.
+ *The buffers are taken from the arena with a bump pointer and it's reset after every refresh.
+ *If it's not enough extra chunks are allocated for the frame. `lv_mem_buf_arena_monitor()` tells the required size.
+ *[bytes] 0: use the slots*/
+#ifndef LV_MEM_BUF_ARENA_SIZE
+    #ifdef CONFIG_LV_MEM_BUF_ARENA_SIZE
+        #define LV_MEM_BUF_ARENA_SIZE CONFIG_LV_MEM_BUF_ARENA_SIZE
+    #else
+        #define LV_MEM_BUF_ARENA_SIZE 0
+    #endif
+#endif
+
+/*Record which subsystem (objects, styles, image cache, fonts, etc) allocated each memory block.
+ *`lv_mem_tag_monitor()` and `lv_mem_tag_dump()` tell the live heap usage per subsystem.
+ *Adds a small header to each allocation, the counters are updated in constant time.*/
+#ifndef LV_MEM_TAG
+    #ifdef CONFIG_LV_MEM_TAG
+        #define LV_MEM_TAG CONFIG_LV_MEM_TAG
+    #else
+        #define LV_MEM_TAG 0
+    #endif
+#endif
+
 /*Use the standard `memcpy` and `memset` instead of LVGL's own functions. (Might or might not be faster).*/
 #ifndef LV_MEMCPY_MEMSET_STD
     #ifdef CONFIG_LV_MEMCPY_MEMSET_STD
@@ -220,6 +275,16 @@
     #endif
 #endif
 
+/*1: Step the animations right before a display is refreshed instead of in their own timer.
+ *The animations are evaluated at the expected time of showing the frame (start + average render time)*/
+#ifndef LV_ANIM_REFR_SYNC
+    #ifdef CONFIG_LV_ANIM_REFR_SYNC
+        #define LV_ANIM_REFR_SYNC CONFIG_LV_ANIM_REFR_SYNC
+    #else
+        #define LV_ANIM_REFR_SYNC 0
+    #endif
+#endif
+
 /*Input device read period in milliseconds*/
 #ifndef LV_INDEV_DEF_READ_PERIOD
     #ifdef CONFIG_LV_INDEV_DEF_READ_PERIOD
@@ -343,6 +408,51 @@
     #endif
 #endif
 
+/*Number of layer buffers to keep for reuse when a layer is destroyed (per display).
+ *The next layers (e.g. in the next band or frame) can use them instead of allocating new buffers.
+ *The kept buffers are freed if a new buffer can't be allocated. 0: always free the layer buffers*/
+#ifndef LV_LAYER_BUF_POOL_CNT
+    #ifdef CONFIG_LV_LAYER_BUF_POOL_CNT
+        #define LV_LAYER_BUF_POOL_CNT CONFIG_LV_LAYER_BUF_POOL_CNT
+    #else
+        #define LV_LAYER_BUF_POOL_CNT 0
+    #endif
+#endif
+
+/*Objects with `LV_OBJ_FLAG_RENDER_CACHE` are rendered once together with their children
+ *and redrawn from the rendered image until something changes in them. Moving them only moves the image.
+ *[bytes] the max. memory all the cached images can use together. 0: to disable the render cache*/
+#ifndef LV_OBJ_RENDER_CACHE_SIZE
+    #ifdef CONFIG_LV_OBJ_RENDER_CACHE_SIZE
+        #define LV_OBJ_RENDER_CACHE_SIZE CONFIG_LV_OBJ_RENDER_CACHE_SIZE
+    #else
+        #define LV_OBJ_RENDER_CACHE_SIZE 0
+    #endif
+#endif
+
+/*Cache the resolved values of the frequently used style properties (background, border, outline, shadow,
+ *padding, text, radius and opacity) per object and part, so drawing doesn't have to look them up in the styles.
+ *Styles modified after they were added to objects need `lv_obj_report_style_change()` to update the cache.
+ *It uses about 50 * `sizeof(void *)` bytes for each drawn part of the objects*/
+#ifndef LV_OBJ_STYLE_CACHE
+    #ifdef CONFIG_LV_OBJ_STYLE_CACHE
+        #define LV_OBJ_STYLE_CACHE CONFIG_LV_OBJ_STYLE_CACHE
+    #else
+        #define LV_OBJ_STYLE_CACHE 0
+    #endif
+#endif
+
+/*If the draw buffer is smaller than an area to redraw, record the draw operations of the area once
+ *and replay them in every band instead of drawing the widgets again for each band.
+ *[bytes] the max. size of the recorded draw operations. 0: to disable the draw list*/
+#ifndef LV_DRAW_LIST_SIZE
+    #ifdef CONFIG_LV_DRAW_LIST_SIZE
+        #define LV_DRAW_LIST_SIZE CONFIG_LV_DRAW_LIST_SIZE
+    #else
+        #define LV_DRAW_LIST_SIZE 0
+    #endif
+#endif
+
 /*Default image cache size. Image caching keeps the images opened.
  *If only the built-in image formats are used there is no real advantage of caching. (I.e. if no new image decoder is added)
  *With complex image decoders (e.g. PNG or JPG) caching can save the continuous open/decode of images.
@@ -412,6 +522,18 @@
     #endif
 #endif
 
+/*In direct mode move the already rendered content of the scrolled objects in the frame buffer
+ *and redraw only the newly exposed parts instead of the whole object.
+ *Used only for opaque, not transformed objects which don't draw anything else than their children
+ *(e.g. simple containers and lists) and only without rotation.*/
+#ifndef LV_USE_SCROLL_COPY
+    #ifdef CONFIG_LV_USE_SCROLL_COPY
+        #define LV_USE_SCROLL_COPY CONFIG_LV_USE_SCROLL_COPY
+    #else
+        #define LV_USE_SCROLL_COPY 0
+    #endif
+#endif
+
 /*-------------
  * GPU
  *-----------*/
@@ -1531,6 +1653,35 @@
         #define LV_USE_VIDEO      1
     #endif
 #endif
+#if LV_USE_VIDEO
+    /*1: Decode and convert the videos in separate threads and show the frames from an `lv_timer`.
+     *Used only with LV_USE_GUIDER_SIMULATOR. Requires pthread.*/
+    #ifndef LV_VIDEO_USE_THREADS
+        #ifdef CONFIG_LV_VIDEO_USE_THREADS
+            #define LV_VIDEO_USE_THREADS CONFIG_LV_VIDEO_USE_THREADS
+        #else
+            #define LV_VIDEO_USE_THREADS 0
+        #endif
+    #endif
+    #if LV_VIDEO_USE_THREADS
+        /*Number of frame buffers: one is shown and the others are filled by the decoder threads (at least 2)*/
+        #ifndef LV_VIDEO_FRAME_CNT
+            #ifdef CONFIG_LV_VIDEO_FRAME_CNT
+                #define LV_VIDEO_FRAME_CNT CONFIG_LV_VIDEO_FRAME_CNT
+            #else
+                #define LV_VIDEO_FRAME_CNT 3
+            #endif
+        #endif
+        /*Number of decoder threads shared by all playing videos*/
+        #ifndef LV_VIDEO_THREAD_CNT
+            #ifdef CONFIG_LV_VIDEO_THREAD_CNT
+                #define LV_VIDEO_THREAD_CNT CONFIG_LV_VIDEO_THREAD_CNT
+            #else
+                #define LV_VIDEO_THREAD_CNT 2
+            #endif
+        #endif
+    #endif
+#endif
 
 #ifndef LV_USE_LINE
     #ifdef _LV_KCONFIG_PRESENT
@@ -1845,6 +1996,17 @@
 #    define  LV_USE_ANALOGCLOCK        1
 #  endif
 #endif
+#if LV_USE_ANALOGCLOCK
+    /*1: Render the ticks and labels once into a cached layer and redraw only the needles when the time changes.
+     *Needs `(width + ext. draw size) * (height + ext. draw size) * LV_IMG_PX_SIZE_ALPHA_BYTE` bytes from `lv_mem`*/
+#  ifndef LV_ANALOGCLOCK_CACHE_SCALE
+#    ifdef CONFIG_LV_ANALOGCLOCK_CACHE_SCALE
+#      define LV_ANALOGCLOCK_CACHE_SCALE CONFIG_LV_ANALOGCLOCK_CACHE_SCALE
+#    else
+#      define LV_ANALOGCLOCK_CACHE_SCALE 0
+#    endif
+#  endif
+#endif
 
 #ifndef LV_USE_MSGBOX
     #ifdef _LV_KCONFIG_PRESENT
@@ -2232,6 +2394,25 @@
         #define LV_USE_PNG 0
     #endif
 #endif
+#if LV_USE_PNG
+    /*1: Decode large PNGs row by row while drawing instead of decoding the whole image on open.
+     *Lowers the peak memory usage as no 32 bit copy of the image is created.*/
+    #ifndef LV_PNG_STREAM_DECODE
+        #ifdef CONFIG_LV_PNG_STREAM_DECODE
+            #define LV_PNG_STREAM_DECODE CONFIG_LV_PNG_STREAM_DECODE
+        #else
+            #define LV_PNG_STREAM_DECODE 0
+        #endif
+    #endif
+    /*Stream only the images having at least this many pixels*/
+    #ifndef LV_PNG_STREAM_MIN_PX
+        #ifdef CONFIG_LV_PNG_STREAM_MIN_PX
+            #define LV_PNG_STREAM_MIN_PX CONFIG_LV_PNG_STREAM_MIN_PX
+        #else
+            #define LV_PNG_STREAM_MIN_PX (128 * 128)
+        #endif
+    #endif
+#endif
 
 /*BMP decoder library*/
 #ifndef LV_USE_BMP
@@ -2251,6 +2432,42 @@
         #define LV_USE_SJPG 0
     #endif
 #endif
+#if LV_USE_SJPG
+    /*Memory for caching decoded fragments [bytes]. At least one fragment is always cached.*/
+    #ifndef LV_SJPG_FRAG_CACHE_SIZE
+        #ifdef CONFIG_LV_SJPG_FRAG_CACHE_SIZE
+            #define LV_SJPG_FRAG_CACHE_SIZE CONFIG_LV_SJPG_FRAG_CACHE_SIZE
+        #else
+            #define LV_SJPG_FRAG_CACHE_SIZE 0
+        #endif
+    #endif
+    /*1: Decode the next fragments in the direction of reading in worker threads. Requires pthread.*/
+    #ifndef LV_SJPG_USE_THREADS
+        #ifdef CONFIG_LV_SJPG_USE_THREADS
+            #define LV_SJPG_USE_THREADS CONFIG_LV_SJPG_USE_THREADS
+        #else
+            #define LV_SJPG_USE_THREADS 0
+        #endif
+    #endif
+    #if LV_SJPG_USE_THREADS
+        /*Number of worker threads*/
+        #ifndef LV_SJPG_THREAD_CNT
+            #ifdef CONFIG_LV_SJPG_THREAD_CNT
+                #define LV_SJPG_THREAD_CNT CONFIG_LV_SJPG_THREAD_CNT
+            #else
+                #define LV_SJPG_THREAD_CNT 2
+            #endif
+        #endif
+        /*Fragments to decode ahead. Limited by the fragments fitting into `LV_SJPG_FRAG_CACHE_SIZE`*/
+        #ifndef LV_SJPG_PREFETCH_CNT
+            #ifdef CONFIG_LV_SJPG_PREFETCH_CNT
+                #define LV_SJPG_PREFETCH_CNT CONFIG_LV_SJPG_PREFETCH_CNT
+            #else
+                #define LV_SJPG_PREFETCH_CNT 2
+            #endif
+        #endif
+    #endif
+#endif
 
 /*GIF decoder library*/
 #ifndef LV_USE_GIF
@@ -2260,6 +2477,17 @@
         #define LV_USE_GIF 0
     #endif
 #endif
+#if LV_USE_GIF
+    /*Memory for keeping the composed frames of looping GIFs to replay them without decoding [bytes].
+     *0: disable the frame cache*/
+    #ifndef LV_GIF_CACHE_SIZE
+        #ifdef CONFIG_LV_GIF_CACHE_SIZE
+            #define LV_GIF_CACHE_SIZE CONFIG_LV_GIF_CACHE_SIZE
+        #else
+            #define LV_GIF_CACHE_SIZE 0
+        #endif
+    #endif
+#endif
 
 /*QR code library*/
 #ifndef LV_USE_QRCODE
@@ -2334,6 +2562,34 @@
         #define LV_USE_RLOTTIE 0
     #endif
 #endif
+#if LV_USE_RLOTTIE
+    /*1: Render the next frames in a worker thread while the current one is shown. Requires pthread.*/
+    #ifndef LV_RLOTTIE_USE_THREADS
+        #ifdef CONFIG_LV_RLOTTIE_USE_THREADS
+            #define LV_RLOTTIE_USE_THREADS CONFIG_LV_RLOTTIE_USE_THREADS
+        #else
+            #define LV_RLOTTIE_USE_THREADS 0
+        #endif
+    #endif
+    #if LV_RLOTTIE_USE_THREADS
+        /*Number of frame buffers: one is shown and the others are rendered ahead (at least 2)*/
+        #ifndef LV_RLOTTIE_RING_SIZE
+            #ifdef CONFIG_LV_RLOTTIE_RING_SIZE
+                #define LV_RLOTTIE_RING_SIZE CONFIG_LV_RLOTTIE_RING_SIZE
+            #else
+                #define LV_RLOTTIE_RING_SIZE 3
+            #endif
+        #endif
+    #endif
+    /*Memory to keep all the frames of an animation if they fit into it [bytes]. 0: disable*/
+    #ifndef LV_RLOTTIE_CACHE_SIZE
+        #ifdef CONFIG_LV_RLOTTIE_CACHE_SIZE
+            #define LV_RLOTTIE_CACHE_SIZE CONFIG_LV_RLOTTIE_CACHE_SIZE
+        #else
+            #define LV_RLOTTIE_CACHE_SIZE 0
+        #endif
+    #endif
+#endif
 
 /*FFmpeg library for image decoding and playing videos
  *Supports all major image formats so do not enable other image decoder with it*/
@@ -2353,6 +2609,24 @@
             #define LV_FFMPEG_DUMP_FORMAT 0
         #endif
     #endif
+    /*1: Decode the video in a separate thread into a queue of frames. Requires pthread.*/
+    #ifndef LV_FFMPEG_PLAYER_USE_THREADS
+        #ifdef CONFIG_LV_FFMPEG_PLAYER_USE_THREADS
+            #define LV_FFMPEG_PLAYER_USE_THREADS CONFIG_LV_FFMPEG_PLAYER_USE_THREADS
+        #else
+            #define LV_FFMPEG_PLAYER_USE_THREADS 0
+        #endif
+    #endif
+    #if LV_FFMPEG_PLAYER_USE_THREADS
+        /*Number of frame buffers: one is shown and the others are filled by the decoder thread (at least 2)*/
+        #ifndef LV_FFMPEG_PLAYER_FRAME_CNT
+            #ifdef CONFIG_LV_FFMPEG_PLAYER_FRAME_CNT
+                #define LV_FFMPEG_PLAYER_FRAME_CNT CONFIG_LV_FFMPEG_PLAYER_FRAME_CNT
+            #else
+                #define LV_FFMPEG_PLAYER_FRAME_CNT 3
+            #endif
+        #endif
+    #endif
 #endif
 
 /*-----------
@@ -18,6 +18,9 @@
 #include "lv_math.h"
 #include "lv_mem.h"
 #include "lv_gc.h"
+#if LV_ANIM_REFR_SYNC
+    #include "../hal/lv_hal_disp.h"
+#endif
 
 /*********************
  *      DEFINES
@@ -25,25 +28,91 @@
 #define LV_ANIM_RESOLUTION 1024
 #define LV_ANIM_RES_SHIFT 10
 
+/*The precomputed paths store a value in every `1 << PATH_LUT_SHIFT` step and interpolate between them*/
+#define PATH_LUT_SHIFT 2
+#define PATH_LUT_SEG_CNT (LV_BEZIER_VAL_MAX >> PATH_LUT_SHIFT)
+
 /**********************
  *      TYPEDEFS
  **********************/
 
+/*The animations are grouped in the batch by these kinds of paths*/
+enum {
+    ANIM_PATH_LINEAR,
+    ANIM_PATH_EASE_IN,
+    ANIM_PATH_EASE_OUT,
+    ANIM_PATH_EASE_IN_OUT,
+    ANIM_PATH_OVERSHOOT,
+    ANIM_PATH_BOUNCE,
+    ANIM_PATH_STEP,
+    ANIM_PATH_CUSTOM_BEZIER3,
+    ANIM_PATH_CUSTOM,   /*Any other `path_cb`*/
+    _ANIM_PATH_LAST
+};
+
+/*A curve precomputed in `PATH_LUT_SEG_CNT` segments*/
+typedef struct _lv_anim_path_lut_t {
+    int16_t points[4];  /*The control points the curve was created from*/
+    bool css;           /*true: `points` are x1, y1, x2, y2 of a CSS cubic-bezier; false: `lv_bezier3` values*/
+    uint32_t ref_cnt;   /*Number of running animations using it. The built-in curves hold one reference forever.*/
+    int16_t values[PATH_LUT_SEG_CNT + 1];   /*The value of the curve in [0..LV_BEZIER_VAL_MAX] range*/
+} lv_anim_path_lut_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static void anim_timer(lv_timer_t * param);
+static void anim_run(uint32_t tick);
 static void anim_mark_list_change(void);
 static void anim_ready_handler(lv_anim_t * a);
+static void anim_remove(lv_anim_t * a);
+static void anim_free(lv_anim_t * a);
+static bool anim_batch_reserve(uint32_t cnt);
+static void anim_batch_build(void);
+static void anim_batch_eval(uint32_t kind, lv_anim_t ** anims, int32_t * values, uint32_t cnt);
+static uint32_t anim_path_kind(lv_anim_path_cb_t path_cb);
+static int32_t anim_path_bezier(const lv_anim_t * a, uint32_t kind);
+static const lv_anim_path_lut_t * anim_path_lut_get(bool css, const int16_t points[4]);
+static void anim_path_lut_release(const lv_anim_path_lut_t * lut);
+static const lv_anim_path_lut_t * anim_path_lut_get_builtin(uint32_t kind);
+static inline int32_t anim_path_lut_step(const lv_anim_path_lut_t * lut, int32_t t);
+static int32_t bezier3_css(int32_t t, int32_t p1, int32_t p2);
 
 /**********************
  *  STATIC VARIABLES
  **********************/
 static uint32_t last_timer_run;
-static bool anim_list_changed;
-static bool anim_run_round;
 static lv_timer_t * _lv_anim_tmr;
 
+static bool anim_timer_running;
+static bool batch_changed;
+static uint32_t anim_cnt;           /*Number of animations in `_lv_anim_ll`*/
+static uint32_t batch_size;         /*Number of animations `_lv_anim_batch` can store*/
+static uint32_t batch_group[_ANIM_PATH_LAST + 1];  /*Start index of each kind of paths in the batch*/
+static lv_anim_t ** batch_in_use;   /*The batch iterated by `anim_timer`. Not freed until it returns.*/
+static const lv_anim_path_lut_t * builtin_luts[ANIM_PATH_CUSTOM];  /*Created on first use*/
+
+/*The built-in paths evaluated by the batch without calling `path_cb`. Indexed by the `ANIM_PATH_...` kinds*/
+static const lv_anim_path_cb_t anim_path_cbs[ANIM_PATH_CUSTOM] = {
+    lv_anim_path_linear,
+    lv_anim_path_ease_in,
+    lv_anim_path_ease_out,
+    lv_anim_path_ease_in_out,
+    lv_anim_path_overshoot,
+    lv_anim_path_bounce,
+    lv_anim_path_step,
+    lv_anim_path_custom_bezier3,
+};
+
+/*The `lv_bezier3` values of the built-in curves*/
+static const int16_t anim_path_bezier_points[ANIM_PATH_CUSTOM][4] = {
+    [ANIM_PATH_EASE_IN] = {0, 50, 100, LV_BEZIER_VAL_MAX},
+    [ANIM_PATH_EASE_OUT] = {0, 900, 950, LV_BEZIER_VAL_MAX},
+    [ANIM_PATH_EASE_IN_OUT] = {0, 50, 952, LV_BEZIER_VAL_MAX},
+    [ANIM_PATH_OVERSHOOT] = {0, 1000, 1300, LV_BEZIER_VAL_MAX},
+    [ANIM_PATH_BOUNCE] = {LV_BEZIER_VAL_MAX, 800, 500, 0},
+};
+
 /**********************
  *      MACROS
  **********************/
@@ -61,9 +130,18 @@ static lv_timer_t * _lv_anim_tmr;
 void _lv_anim_core_init(void)
 {
     _lv_ll_init(&LV_GC_ROOT(_lv_anim_ll), sizeof(lv_anim_t));
+    _lv_ll_init(&LV_GC_ROOT(_lv_anim_del_ll), sizeof(lv_anim_t));
+    _lv_ll_init(&LV_GC_ROOT(_lv_anim_path_lut_ll), sizeof(lv_anim_path_lut_t));
+    lv_memset_00(builtin_luts, sizeof(builtin_luts));
+    LV_GC_ROOT(_lv_anim_batch) = NULL;
+    anim_timer_running = false;
+    batch_changed = false;
+    anim_cnt = 0;
+    batch_size = 0;
+    batch_in_use = NULL;
+    lv_memset_00(batch_group, sizeof(batch_group));
     _lv_anim_tmr = lv_timer_create(anim_timer, LV_DISP_DEF_REFR_PERIOD, NULL);
     anim_mark_list_change(); /*Turn off the animation timer*/
-    anim_list_changed = false;
 }
 
 void lv_anim_init(lv_anim_t * a)
@@ -82,6 +160,15 @@ lv_anim_t * lv_anim_start(const lv_anim_t * a)
 {
     TRACE_ANIM("begin");
 
+    /*Get the curve before deleting the old animation, which might be the last one using it*/
+    const lv_anim_path_lut_t * path_lut = NULL;
+    if(a->path_cb == lv_anim_path_custom_bezier3) {
+        path_lut = anim_path_lut_get(true, a->bezier3_points);
+        if(path_lut == NULL) {
+            LV_LOG_WARN("couldn't allocate the curve, the animation will be linear");
+        }
+    }
+
     /*Do not let two animations for the same 'var' with the same 'exec_cb'*/
     if(a->exec_cb != NULL) lv_anim_del(a->var, a->exec_cb); /*exec_cb == NULL would delete all animations of var*/
 
@@ -90,15 +177,25 @@ lv_anim_t * lv_anim_start(const lv_anim_t * a)
         last_timer_run = lv_tick_get();
     }
 
-    /*Add the new animation to the animation linked list*/
-    lv_anim_t * new_anim = _lv_ll_ins_head(&LV_GC_ROOT(_lv_anim_ll));
+    /*Add the new animation to the animation linked list.
+     *Make room for it in the batch too so building the batch can't fail later*/
+    lv_anim_t * new_anim = NULL;
+    lv_mem_tag_t tag_prev = lv_mem_tag_set(LV_MEM_TAG_ANIM);
+    if(anim_batch_reserve(anim_cnt + 1)) new_anim = _lv_ll_ins_head(&LV_GC_ROOT(_lv_anim_ll));
+    lv_mem_tag_set(tag_prev);
     LV_ASSERT_MALLOC(new_anim);
-    if(new_anim == NULL) return NULL;
+    if(new_anim == NULL) {
+        anim_path_lut_release(path_lut);
+        return NULL;
+    }
+
+    anim_cnt++;
 
     /*Initialize the animation descriptor*/
     lv_memcpy(new_anim, a, sizeof(lv_anim_t));
     if(a->var == a) new_anim->var = new_anim;
-    new_anim->run_round = anim_run_round;
+    new_anim->deleted = 0;
+    new_anim->path_lut = path_lut;
 
     /*Set the start value*/
     if(new_anim->early_apply) {
@@ -111,14 +208,41 @@ lv_anim_t * lv_anim_start(const lv_anim_t * a)
         if(new_anim->exec_cb && new_anim->var) new_anim->exec_cb(new_anim->var, new_anim->start_value);
     }
 
-    /*Creating an animation changed the linked list.
-     *It's important if it happens in a ready callback. (see `anim_timer`)*/
+    /*The batch needs to be built again to contain the new animation.
+     *The new animation doesn't run in the current `anim_timer` if it's started from a callback.*/
     anim_mark_list_change();
 
     TRACE_ANIM("finished");
     return new_anim;
 }
 
+void lv_anim_set_bezier3_param(lv_anim_t * a, int16_t x1, int16_t y1, int16_t x2, int16_t y2)
+{
+    /*Out of range X coordinates would make the curve go back in time*/
+    const int16_t points[4] = {LV_CLAMP(0, x1, LV_BEZIER_VAL_MAX), y1, LV_CLAMP(0, x2, LV_BEZIER_VAL_MAX), y2};
+
+    lv_memcpy(a->bezier3_points, points, sizeof(points));
+    a->path_cb = lv_anim_path_custom_bezier3;
+
+    /*A not started animation gets its curve in `lv_anim_start`*/
+    lv_anim_t * a_act;
+    _LV_LL_READ(&LV_GC_ROOT(_lv_anim_ll), a_act) {
+        if(a_act == a) break;
+    }
+    if(a_act == NULL) return;
+
+    /*Get the new curve first to not free and create again the same curve*/
+    const lv_anim_path_lut_t * lut_prev = a->path_lut;
+    a->path_lut = anim_path_lut_get(true, points);
+    anim_path_lut_release(lut_prev);
+    if(a->path_lut == NULL) {
+        LV_LOG_WARN("couldn't allocate the curve, the animation will be linear");
+    }
+
+    /*The animation might need to move to an other path group*/
+    anim_mark_list_change();
+}
+
 uint32_t lv_anim_get_playtime(lv_anim_t * a)
 {
     uint32_t playtime = LV_ANIM_PLAYTIME_INFINITE;
@@ -190,11 +314,9 @@ bool lv_anim_del(void * var, lv_anim_exec_xcb_t exec_cb)
         a_next = _lv_ll_get_next(&LV_GC_ROOT(_lv_anim_ll), a);
 
         if((a->var == var || var == NULL) && (a->exec_cb == exec_cb || exec_cb == NULL)) {
-            _lv_ll_remove(&LV_GC_ROOT(_lv_anim_ll), a);
+            anim_remove(a);
             if(a->deleted_cb != NULL) a->deleted_cb(a);
-            lv_mem_free(a);
-            anim_mark_list_change(); /*Read by `anim_timer`. It need to know if a delete occurred in
-                                       the linked list*/
+            anim_free(a);
             del = true;
         }
 
@@ -206,8 +328,22 @@ bool lv_anim_del(void * var, lv_anim_exec_xcb_t exec_cb)
 
 void lv_anim_del_all(void)
 {
-    _lv_ll_clear(&LV_GC_ROOT(_lv_anim_ll));
-    anim_mark_list_change();
+    if(anim_timer_running) {
+        /*The batch of `anim_timer` still points to the animations so only remove them from the list*/
+        lv_anim_t * a;
+        while((a = _lv_ll_get_head(&LV_GC_ROOT(_lv_anim_ll))) != NULL) {
+            anim_remove(a);
+        }
+    }
+    else {
+        lv_anim_t * a;
+        _LV_LL_READ(&LV_GC_ROOT(_lv_anim_ll), a) {
+            anim_path_lut_release(a->path_lut);
+        }
+        _lv_ll_clear(&LV_GC_ROOT(_lv_anim_ll));
+        anim_cnt = 0;
+        anim_mark_list_change();
+    }
 }
 
 lv_anim_t * lv_anim_get(void * var, lv_anim_exec_xcb_t exec_cb)
@@ -253,6 +389,11 @@ void lv_anim_refr_now(void)
     anim_timer(NULL);
 }
 
+void _lv_anim_refr_sync(uint32_t tick)
+{
+    anim_run(tick);
+}
+
 int32_t lv_anim_path_linear(const lv_anim_t * a)
 {
     /*Calculate the current step*/
@@ -270,58 +411,22 @@ int32_t lv_anim_path_linear(const lv_anim_t * a)
 
 int32_t lv_anim_path_ease_in(const lv_anim_t * a)
 {
-    /*Calculate the current step*/
-    uint32_t t = lv_map(a->act_time, 0, a->time, 0, LV_BEZIER_VAL_MAX);
-    int32_t step = lv_bezier3(t, 0, 50, 100, LV_BEZIER_VAL_MAX);
-
-    int32_t new_value;
-    new_value = step * (a->end_value - a->start_value);
-    new_value = new_value >> LV_BEZIER_VAL_SHIFT;
-    new_value += a->start_value;
-
-    return new_value;
+    return anim_path_bezier(a, ANIM_PATH_EASE_IN);
 }
 
 int32_t lv_anim_path_ease_out(const lv_anim_t * a)
 {
-    /*Calculate the current step*/
-    uint32_t t = lv_map(a->act_time, 0, a->time, 0, LV_BEZIER_VAL_MAX);
-    int32_t step = lv_bezier3(t, 0, 900, 950, LV_BEZIER_VAL_MAX);
-
-    int32_t new_value;
-    new_value = step * (a->end_value - a->start_value);
-    new_value = new_value >> LV_BEZIER_VAL_SHIFT;
-    new_value += a->start_value;
-
-    return new_value;
+    return anim_path_bezier(a, ANIM_PATH_EASE_OUT);
 }
 
 int32_t lv_anim_path_ease_in_out(const lv_anim_t * a)
 {
-    /*Calculate the current step*/
-    uint32_t t = lv_map(a->act_time, 0, a->time, 0, LV_BEZIER_VAL_MAX);
-    int32_t step = lv_bezier3(t, 0, 50, 952, LV_BEZIER_VAL_MAX);
-
-    int32_t new_value;
-    new_value = step * (a->end_value - a->start_value);
-    new_value = new_value >> LV_BEZIER_VAL_SHIFT;
-    new_value += a->start_value;
-
-    return new_value;
+    return anim_path_bezier(a, ANIM_PATH_EASE_IN_OUT);
 }
 
 int32_t lv_anim_path_overshoot(const lv_anim_t * a)
 {
-    /*Calculate the current step*/
-    uint32_t t = lv_map(a->act_time, 0, a->time, 0, LV_BEZIER_VAL_MAX);
-    int32_t step = lv_bezier3(t, 0, 1000, 1300, LV_BEZIER_VAL_MAX);
-
-    int32_t new_value;
-    new_value = step * (a->end_value - a->start_value);
-    new_value = new_value >> LV_BEZIER_VAL_SHIFT;
-    new_value += a->start_value;
-
-    return new_value;
+    return anim_path_bezier(a, ANIM_PATH_OVERSHOOT);
 }
 
 int32_t lv_anim_path_bounce(const lv_anim_t * a)
@@ -365,7 +470,8 @@ int32_t lv_anim_path_bounce(const lv_anim_t * a)
 
     if(t > LV_BEZIER_VAL_MAX) t = LV_BEZIER_VAL_MAX;
     if(t < 0) t = 0;
-    int32_t step = lv_bezier3(t, LV_BEZIER_VAL_MAX, 800, 500, 0);
+    const lv_anim_path_lut_t * lut = anim_path_lut_get_builtin(ANIM_PATH_BOUNCE);
+    int32_t step = lut ? anim_path_lut_step(lut, t) : (int32_t)lv_bezier3(t, LV_BEZIER_VAL_MAX, 800, 500, 0);
 
     int32_t new_value;
     new_value = step * diff;
@@ -383,76 +489,135 @@ int32_t lv_anim_path_step(const lv_anim_t * a)
         return a->start_value;
 }
 
+int32_t lv_anim_path_custom_bezier3(const lv_anim_t * a)
+{
+    if(a->path_lut == NULL) return lv_anim_path_linear(a);
+
+    /*Calculate the current step*/
+    int32_t t = lv_map(a->act_time, 0, a->time, 0, LV_BEZIER_VAL_MAX);
+    int32_t step = anim_path_lut_step(a->path_lut, t);
+
+    int32_t new_value;
+    new_value = step * (a->end_value - a->start_value);
+    new_value = new_value >> LV_BEZIER_VAL_SHIFT;
+    new_value += a->start_value;
+
+    return new_value;
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
 
 /**
  * Periodically handle the animations.
- * @param param unused
+ * With `LV_ANIM_REFR_SYNC` the displays step the animations before refreshing,
+ * so only keep them refreshing while there are animations. Without displays handle the animations here.
+ * @param param pointer to the timer or NULL to step the animations anyway
  */
 static void anim_timer(lv_timer_t * param)
 {
+#if LV_ANIM_REFR_SYNC
+    if(param && lv_disp_get_next(NULL)) {
+        lv_disp_t * disp;
+        for(disp = lv_disp_get_next(NULL); disp; disp = lv_disp_get_next(disp)) {
+            if(disp->refr_timer) lv_timer_resume(disp->refr_timer);
+        }
+        return;
+    }
+#else
     LV_UNUSED(param);
+#endif
 
-    uint32_t elaps = lv_tick_elaps(last_timer_run);
+    anim_run(lv_tick_get());
+}
 
-    /*Flip the run round*/
-    anim_run_round = anim_run_round ? false : true;
+/**
+ * Step the animations to a given time.
+ * The running animations are handled as a batch: first the time of all of them is advanced,
+ * then the values of each kind of built-in path are calculated in a loop, and finally the values are applied.
+ * Animations started in the callbacks run from the next call. Deleted animations are freed only at the end.
+ * @param tick the current time or the time when the next frame is expected to be shown
+ */
+static void anim_run(uint32_t tick)
+{
+    /*E.g. `lv_refr_now()` called from an animation callback*/
+    if(anim_timer_running) return;
+
+    /*`last_timer_run` can be ahead of `tick` if the animations were stepped to a predicted presentation time.
+     *Don't step them back in this case.*/
+    int32_t elaps = (int32_t)(tick - last_timer_run);
+    if(elaps < 0) elaps = 0;
+    else last_timer_run = tick;
+
+    /*No animation was started yet*/
+    if(LV_GC_ROOT(_lv_anim_batch) == NULL) return;
+
+    if(batch_changed) anim_batch_build();
+
+    anim_timer_running = true;
+    batch_in_use = LV_GC_ROOT(_lv_anim_batch);
+
+    lv_anim_t ** anims = batch_in_use;
+    int32_t * values = (int32_t *)(anims + batch_size);
+    uint32_t cnt = batch_group[_ANIM_PATH_LAST];
+    uint32_t i;
+
+    /*Advance the time of the animations*/
+    for(i = 0; i < cnt; i++) {
+        lv_anim_t * a = anims[i];
+        if(a->deleted || a->anim_pause) continue;
+
+        /*The animation will run now for the first time. Call `start_cb`*/
+        int32_t new_act_time = a->act_time + elaps;
+        if(!a->start_cb_called && a->act_time <= 0 && new_act_time >= 0) {
+            if(a->early_apply == 0 && a->get_value_cb) {
+                int32_t v_ofs = a->get_value_cb(a);
+                a->start_value += v_ofs;
+                a->end_value += v_ofs;
+            }
+            if(a->start_cb) a->start_cb(a);
+            a->start_cb_called = 1;
+        }
+        a->act_time += elaps;
+        if(a->act_time > a->time) a->act_time = a->time;
+    }
 
-    lv_anim_t * a = _lv_ll_get_head(&LV_GC_ROOT(_lv_anim_ll));
+    /*Calculate the new values of each kind of path*/
+    uint32_t kind;
+    for(kind = 0; kind < _ANIM_PATH_LAST; kind++) {
+        uint32_t start = batch_group[kind];
+        anim_batch_eval(kind, anims + start, values + start, batch_group[kind + 1] - start);
+    }
 
-    while(a != NULL) {
-        /*It can be set by `lv_anim_del()` typically in `end_cb`. If set then an animation delete
-         * happened in `anim_ready_handler` which could make this linked list reading corrupt
-         * because the list is changed meanwhile
-         */
-        anim_list_changed = false;
-
-        /*Add the animation pause flag check*/
-        if(a->run_round != anim_run_round && !a->anim_pause) {
-            a->run_round = anim_run_round; /*The list readying might be reset so need to know which anim has run already*/
-
-            /*The animation will run now for the first time. Call `start_cb`*/
-            int32_t new_act_time = a->act_time + elaps;
-            if(!a->start_cb_called && a->act_time <= 0 && new_act_time >= 0) {
-                if(a->early_apply == 0 && a->get_value_cb) {
-                    int32_t v_ofs = a->get_value_cb(a);
-                    a->start_value += v_ofs;
-                    a->end_value += v_ofs;
-                }
-                if(a->start_cb) a->start_cb(a);
-                a->start_cb_called = 1;
-            }
-            a->act_time += elaps;
-            if(a->act_time >= 0) {
-                if(a->act_time > a->time) a->act_time = a->time;
-
-                int32_t new_value;
-                new_value = a->path_cb(a);
-
-                if(new_value != a->current_value) {
-                    a->current_value = new_value;
-                    /*Apply the calculated value*/
-                    if(a->exec_cb) a->exec_cb(a->var, new_value);
-                }
-
-                /*If the time is elapsed the animation is ready*/
-                if(a->act_time >= a->time) {
-                    anim_ready_handler(a);
-                }
-            }
+    /*Apply the values and handle the ready animations*/
+    for(i = 0; i < cnt; i++) {
+        lv_anim_t * a = anims[i];
+        if(a->deleted || a->anim_pause || a->act_time < 0) continue;
+
+        if(values[i] != a->current_value) {
+            a->current_value = values[i];
+            /*Apply the calculated value*/
+            if(a->exec_cb) a->exec_cb(a->var, values[i]);
+            if(a->deleted) continue;
         }
 
-        /*If the linked list changed due to anim. delete then it's not safe to continue
-         *the reading of the list from here -> start from the head*/
-        if(anim_list_changed)
-            a = _lv_ll_get_head(&LV_GC_ROOT(_lv_anim_ll));
-        else
-            a = _lv_ll_get_next(&LV_GC_ROOT(_lv_anim_ll), a);
+        /*If the time is elapsed the animation is ready*/
+        if(a->act_time >= a->time) {
+            anim_ready_handler(a);
+        }
     }
 
-    last_timer_run = lv_tick_get();
+    anim_timer_running = false;
+
+    /*Free what was deleted meanwhile*/
+    if(batch_in_use != LV_GC_ROOT(_lv_anim_batch)) lv_mem_free(batch_in_use);
+    batch_in_use = NULL;
+    lv_anim_t * a;
+    _LV_LL_READ(&LV_GC_ROOT(_lv_anim_del_ll), a) {
+        anim_path_lut_release(a->path_lut);
+    }
+    _lv_ll_clear(&LV_GC_ROOT(_lv_anim_del_ll));
 }
 
 /**
@@ -474,14 +639,12 @@ static void anim_ready_handler(lv_anim_t * a)
 
         /*Delete the animation from the list.
          * This way the `ready_cb` will see the animations like it's animation is ready deleted*/
-        _lv_ll_remove(&LV_GC_ROOT(_lv_anim_ll), a);
-        /*Flag that the list has changed*/
-        anim_mark_list_change();
+        anim_remove(a);
 
         /*Call the callback function at the end*/
         if(a->ready_cb != NULL) a->ready_cb(a);
         if(a->deleted_cb != NULL) a->deleted_cb(a);
-        lv_mem_free(a);
+        anim_free(a);
     }
     /*If the animation is not deleted then restart it*/
     else {
@@ -507,9 +670,316 @@ static void anim_ready_handler(lv_anim_t * a)
 
 static void anim_mark_list_change(void)
 {
-    anim_list_changed = true;
+    batch_changed = true;
     if(_lv_ll_get_head(&LV_GC_ROOT(_lv_anim_ll)) == NULL)
         lv_timer_pause(_lv_anim_tmr);
     else
         lv_timer_resume(_lv_anim_tmr);
 }
+
+/**
+ * Remove an animation from the list of the running animations.
+ * If it happens in `anim_timer` the animation stays allocated until `anim_timer` returns
+ * because its batch can still refer to it.
+ * @param a pointer to an animation in `_lv_anim_ll`
+ */
+static void anim_remove(lv_anim_t * a)
+{
+    if(anim_timer_running) {
+        _lv_ll_chg_list(&LV_GC_ROOT(_lv_anim_ll), &LV_GC_ROOT(_lv_anim_del_ll), a, false);
+        a->deleted = 1;
+    }
+    else {
+        _lv_ll_remove(&LV_GC_ROOT(_lv_anim_ll), a);
+    }
+
+    anim_cnt--;
+    anim_mark_list_change();
+}
+
+/**
+ * Free an animation removed by `anim_remove`
+ * @param a pointer to an animation
+ */
+static void anim_free(lv_anim_t * a)
+{
+    /*Else it's freed at the end of `anim_timer` with `_lv_anim_del_ll`*/
+    if(a->deleted) return;
+
+    anim_path_lut_release(a->path_lut);
+    lv_mem_free(a);
+}
+
+/**
+ * Make sure the batch can store `cnt` animations.
+ * The content of the batch is not kept: it's built again after the list changed.
+ * @param cnt the number of animations to store
+ * @return true: success; false: out of memory
+ */
+static bool anim_batch_reserve(uint32_t cnt)
+{
+    if(cnt <= batch_size) return true;
+
+    uint32_t new_size = batch_size ? batch_size * 2 : 16;
+    lv_anim_t ** batch = lv_mem_alloc(new_size * (sizeof(lv_anim_t *) + sizeof(int32_t)));
+    if(batch == NULL) return false;
+
+    /*Don't free the batch `anim_timer` is iterating*/
+    if(LV_GC_ROOT(_lv_anim_batch) != batch_in_use) lv_mem_free(LV_GC_ROOT(_lv_anim_batch));
+
+    LV_GC_ROOT(_lv_anim_batch) = batch;
+    batch_size = new_size;
+    batch_changed = true;
+    return true;
+}
+
+/**
+ * Collect the not paused animations into the batch grouped by the kind of their path.
+ * The pointers are followed by the same number of `int32_t` values calculated by `anim_timer`.
+ */
+static void anim_batch_build(void)
+{
+    lv_anim_t ** batch = LV_GC_ROOT(_lv_anim_batch);
+    uint32_t cnt[_ANIM_PATH_LAST] = {0};
+    uint32_t kind;
+    lv_anim_t * a;
+
+    _LV_LL_READ(&LV_GC_ROOT(_lv_anim_ll), a) {
+        if(!a->anim_pause) cnt[anim_path_kind(a->path_cb)]++;
+    }
+
+    uint32_t ofs = 0;
+    for(kind = 0; kind < _ANIM_PATH_LAST; kind++) {
+        batch_group[kind] = ofs;
+        ofs += cnt[kind];
+        cnt[kind] = batch_group[kind];
+    }
+    batch_group[_ANIM_PATH_LAST] = ofs;
+
+    /*Keep the order of the list in each group*/
+    _LV_LL_READ(&LV_GC_ROOT(_lv_anim_ll), a) {
+        if(!a->anim_pause) batch[cnt[anim_path_kind(a->path_cb)]++] = a;
+    }
+
+    batch_changed = false;
+}
+
+/**
+ * Calculate the values of a group of animations having the same kind of path
+ * @param kind      the kind of the paths (`ANIM_PATH_...`)
+ * @param anims     the animations
+ * @param values    store the new values here
+ * @param cnt       number of animations
+ */
+static void anim_batch_eval(uint32_t kind, lv_anim_t ** anims, int32_t * values, uint32_t cnt)
+{
+    uint32_t i;
+
+    /*The `path_cb` of an animation might be changed since the batch was built. Call it in this case.*/
+    switch(kind) {
+        case ANIM_PATH_LINEAR:
+            for(i = 0; i < cnt; i++) {
+                const lv_anim_t * a = anims[i];
+                if(a->act_time < 0 || a->deleted) continue;
+                values[i] = a->path_cb == lv_anim_path_linear ? lv_anim_path_linear(a) : a->path_cb(a);
+            }
+            break;
+        case ANIM_PATH_EASE_IN:
+        case ANIM_PATH_EASE_OUT:
+        case ANIM_PATH_EASE_IN_OUT:
+        case ANIM_PATH_OVERSHOOT:
+            for(i = 0; i < cnt; i++) {
+                const lv_anim_t * a = anims[i];
+                if(a->act_time < 0 || a->deleted) continue;
+                values[i] = a->path_cb == anim_path_cbs[kind] ? anim_path_bezier(a, kind) : a->path_cb(a);
+            }
+            break;
+        case ANIM_PATH_BOUNCE:
+            for(i = 0; i < cnt; i++) {
+                const lv_anim_t * a = anims[i];
+                if(a->act_time < 0 || a->deleted) continue;
+                values[i] = a->path_cb == lv_anim_path_bounce ? lv_anim_path_bounce(a) : a->path_cb(a);
+            }
+            break;
+        case ANIM_PATH_STEP:
+            for(i = 0; i < cnt; i++) {
+                const lv_anim_t * a = anims[i];
+                if(a->act_time < 0 || a->deleted) continue;
+                values[i] = a->path_cb == lv_anim_path_step ? lv_anim_path_step(a) : a->path_cb(a);
+            }
+            break;
+        case ANIM_PATH_CUSTOM_BEZIER3:
+            for(i = 0; i < cnt; i++) {
+                const lv_anim_t * a = anims[i];
+                if(a->act_time < 0 || a->deleted) continue;
+                values[i] = a->path_cb == lv_anim_path_custom_bezier3 ? lv_anim_path_custom_bezier3(a) : a->path_cb(a);
+            }
+            break;
+        default:
+            for(i = 0; i < cnt; i++) {
+                const lv_anim_t * a = anims[i];
+                if(a->act_time < 0 || a->deleted || a->anim_pause) continue;
+                values[i] = a->path_cb(a);
+            }
+            break;
+    }
+}
+
+/**
+ * Get which group of the batch an animation belongs to
+ * @param path_cb   the path of the animation
+ * @return          one of the `ANIM_PATH_...` kinds
+ */
+static uint32_t anim_path_kind(lv_anim_path_cb_t path_cb)
+{
+    uint32_t kind;
+    for(kind = 0; kind < ANIM_PATH_CUSTOM; kind++) {
+        if(anim_path_cbs[kind] == path_cb) return kind;
+    }
+
+    return ANIM_PATH_CUSTOM;
+}
+
+/**
+ * Calculate the current value of an animation on one of the built-in bezier paths
+ * @param a     pointer to an animation
+ * @param kind  `ANIM_PATH_EASE_IN/EASE_OUT/EASE_IN_OUT/OVERSHOOT`
+ * @return      the current value to set
+ */
+static int32_t anim_path_bezier(const lv_anim_t * a, uint32_t kind)
+{
+    /*Calculate the current step*/
+    int32_t t = lv_map(a->act_time, 0, a->time, 0, LV_BEZIER_VAL_MAX);
+    const lv_anim_path_lut_t * lut = anim_path_lut_get_builtin(kind);
+    int32_t step;
+    if(lut) step = anim_path_lut_step(lut, t);
+    else step = lv_bezier3(t, 0, anim_path_bezier_points[kind][1], anim_path_bezier_points[kind][2], LV_BEZIER_VAL_MAX);
+
+    int32_t new_value;
+    new_value = step * (a->end_value - a->start_value);
+    new_value = new_value >> LV_BEZIER_VAL_SHIFT;
+    new_value += a->start_value;
+
+    return new_value;
+}
+
+/**
+ * Get the precomputed curve of the given control points. Create it if it doesn't exist yet.
+ * Each call takes a reference which should be released with `anim_path_lut_release`.
+ * @param css       true: `points` are x1, y1, x2, y2 of a CSS cubic-bezier;
+ *                  false: `points` are the `u0..u3` values of `lv_bezier3`
+ * @param points    the control points
+ * @return          the curve or NULL if out of memory
+ */
+static const lv_anim_path_lut_t * anim_path_lut_get(bool css, const int16_t points[4])
+{
+    lv_anim_path_lut_t * lut;
+    _LV_LL_READ(&LV_GC_ROOT(_lv_anim_path_lut_ll), lut) {
+        if(lut->css == css && lut->points[0] == points[0] && lut->points[1] == points[1] &&
+           lut->points[2] == points[2] && lut->points[3] == points[3]) {
+            lut->ref_cnt++;
+            return lut;
+        }
+    }
+
+    lv_mem_tag_t tag_prev = lv_mem_tag_set(LV_MEM_TAG_ANIM);
+    lut = _lv_ll_ins_tail(&LV_GC_ROOT(_lv_anim_path_lut_ll));
+    lv_mem_tag_set(tag_prev);
+    if(lut == NULL) return NULL;
+
+    lv_memcpy(lut->points, points, sizeof(lut->points));
+    lut->css = css;
+    lut->ref_cnt = 1;
+
+    uint32_t i;
+    if(!css) {
+        for(i = 0; i <= PATH_LUT_SEG_CNT; i++) {
+            lut->values[i] = lv_bezier3(i << PATH_LUT_SHIFT, points[0], points[1], points[2], points[3]);
+        }
+        return lut;
+    }
+
+    /*The curve is given by its X and Y coordinates as a function of a parameter `s`.
+     *Walk `s` until X reaches the time of each entry and interpolate Y there.*/
+    int32_t s = 0;
+    int32_t x = 0;
+    int32_t x_prev = 0;
+    for(i = 0; i <= PATH_LUT_SEG_CNT; i++) {
+        int32_t x_act = i << PATH_LUT_SHIFT;
+        while(x < x_act && s < LV_BEZIER_VAL_MAX) {
+            s++;
+            x_prev = x;
+            x = bezier3_css(s, points[0], points[2]);
+        }
+
+        int32_t y = bezier3_css(s, points[1], points[3]);
+        if(x > x_act && x != x_prev) {
+            int32_t y_prev = bezier3_css(s - 1, points[1], points[3]);
+            y = y_prev + (y - y_prev) * (x_act - x_prev) / (x - x_prev);
+        }
+        lut->values[i] = y;
+    }
+
+    return lut;
+}
+
+/**
+ * Release a reference taken by `anim_path_lut_get`. The curve is freed when it's not used anymore.
+ * @param lut   pointer to a curve or NULL
+ */
+static void anim_path_lut_release(const lv_anim_path_lut_t * lut)
+{
+    if(lut == NULL) return;
+
+    lv_anim_path_lut_t * lut_mut = (lv_anim_path_lut_t *)lut;
+    lut_mut->ref_cnt--;
+    if(lut_mut->ref_cnt > 0) return;
+
+    _lv_ll_remove(&LV_GC_ROOT(_lv_anim_path_lut_ll), lut_mut);
+    lv_mem_free(lut_mut);
+}
+
+/**
+ * Get the precomputed curve of a built-in path
+ * @param kind  `ANIM_PATH_EASE_IN/EASE_OUT/EASE_IN_OUT/OVERSHOOT/BOUNCE`
+ * @return      the curve or NULL if out of memory
+ */
+static const lv_anim_path_lut_t * anim_path_lut_get_builtin(uint32_t kind)
+{
+    if(builtin_luts[kind] == NULL) builtin_luts[kind] = anim_path_lut_get(false, anim_path_bezier_points[kind]);
+    return builtin_luts[kind];
+}
+
+/**
+ * Get the value of a precomputed curve
+ * @param lut   pointer to a curve
+ * @param t     time in [0..LV_BEZIER_VAL_MAX] range
+ * @return      the value of the curve at `t`
+ */
+static inline int32_t anim_path_lut_step(const lv_anim_path_lut_t * lut, int32_t t)
+{
+    if(t >= LV_BEZIER_VAL_MAX) return lut->values[PATH_LUT_SEG_CNT];
+    if(t <= 0) return lut->values[0];
+
+    uint32_t i = t >> PATH_LUT_SHIFT;
+    int32_t frac = t & ((1 << PATH_LUT_SHIFT) - 1);
+    int32_t v = lut->values[i];
+
+    return v + (((lut->values[i + 1] - v) * frac) >> PATH_LUT_SHIFT);
+}
+
+/**
+ * Calculate a cubic bezier going from 0 to `LV_BEZIER_VAL_MAX`.
+ * Unlike `lv_bezier3` the control values can be negative too.
+ * @param t     the parameter of the curve in [0..LV_BEZIER_VAL_MAX] range
+ * @param p1    first control value
+ * @param p2    second control value
+ * @return      the value of the curve at `t`
+ */
+static int32_t bezier3_css(int32_t t, int32_t p1, int32_t p2)
+{
+    int64_t t_rem = LV_BEZIER_VAL_MAX - t;
+    int64_t v = 3 * t_rem * t_rem * t * p1 + 3 * t_rem * t * t * p2 + (int64_t)t * t * t * LV_BEZIER_VAL_MAX;
+
+    return (int32_t)(v >> (3 * LV_BEZIER_VAL_SHIFT));
+}
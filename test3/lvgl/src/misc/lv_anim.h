@@ -45,6 +45,7 @@ typedef enum {
 
 struct _lv_anim_t;
 struct _lv_timer_t;
+struct _lv_anim_path_lut_t;
 
 /** Get the current value during an animation*/
 typedef int32_t (*lv_anim_path_cb_t)(const struct _lv_anim_t *);
@@ -85,6 +86,8 @@ typedef struct _lv_anim_t {
     void * user_data; /**< Custom user data*/
 #endif
     lv_anim_path_cb_t path_cb;         /**< Describe the path (curve) of animations*/
+    const struct _lv_anim_path_lut_t * path_lut; /**< Precomputed curve of `lv_anim_path_custom_bezier3`. Set by `lv_anim_start`*/
+    int16_t bezier3_points[4];         /**< Control points of `lv_anim_path_custom_bezier3`*/
     int32_t start_value;               /**< Start value*/
     int32_t current_value;             /**< Current value*/
     int32_t end_value;                 /**< End value*/
@@ -98,8 +101,8 @@ typedef struct _lv_anim_t {
 
     /*Animation system use these - user shouldn't set*/
     uint8_t playback_now : 1; /**< Play back is in progress*/
-    uint8_t run_round : 1;    /**< Indicates the animation has run in this round*/
     uint8_t start_cb_called : 1;    /**< Indicates that the `start_cb` was already called*/
+    uint8_t deleted : 1;      /**< Deleted while the animations were handled. Freed at the end of the handling*/
     bool anim_pause;
 } lv_anim_t;
 
@@ -203,6 +206,19 @@ static inline void lv_anim_set_path_cb(lv_anim_t * a, lv_anim_path_cb_t path_cb)
     a->path_cb = path_cb;
 }
 
+/**
+ * Make the animation follow a cubic-bezier curve. The same as `cubic-bezier(x1, y1, x2, y2)` in CSS
+ * but the coordinates are scaled to `LV_BEZIER_VAL_MAX`. E.g. `ease` is (256, 102, 256, 1024).
+ * The curve is precomputed once and shared by all the animations using the same control points.
+ * It's freed when the last of these animations is deleted.
+ * @param a         pointer to an initialized `lv_anim_t` variable
+ * @param x1        X coordinate of the first control point in [0..LV_BEZIER_VAL_MAX] range
+ * @param y1        Y coordinate of the first control point. Can be out of [0..LV_BEZIER_VAL_MAX] to overshoot.
+ * @param x2        X coordinate of the second control point in [0..LV_BEZIER_VAL_MAX] range
+ * @param y2        Y coordinate of the second control point. Can be out of [0..LV_BEZIER_VAL_MAX] to overshoot.
+ */
+void lv_anim_set_bezier3_param(lv_anim_t * a, int16_t x1, int16_t y1, int16_t x2, int16_t y2);
+
 /**
  * Set a function call when the animation really starts (considering `delay`)
  * @param a         pointer to an initialized `lv_anim_t` variable
@@ -442,6 +458,13 @@ uint32_t lv_anim_speed_to_time(uint32_t speed, int32_t start, int32_t end);
  */
 void lv_anim_refr_now(void);
 
+/**
+ * Step the animations to a given time. Called before refreshing a display if `LV_ANIM_REFR_SYNC` is enabled.
+ * The animations are never stepped back, so it does nothing if they already run at a later time.
+ * @param tick      the time to which the animations should be stepped (typically the expected presentation time)
+ */
+void _lv_anim_refr_sync(uint32_t tick);
+
 /**
  * Calculate the current value of an animation applying linear characteristic
  * @param a     pointer to an animation
@@ -492,6 +515,13 @@ int32_t lv_anim_path_bounce(const lv_anim_t * a);
  */
 int32_t lv_anim_path_step(const lv_anim_t * a);
 
+/**
+ * Calculate the current value of an animation on the cubic-bezier curve set by `lv_anim_set_bezier3_param`
+ * @param a     pointer to an animation
+ * @return      the current value to set
+ */
+int32_t lv_anim_path_custom_bezier3(const lv_anim_t * a);
+
 /**********************
  *   GLOBAL VARIABLES
  **********************/
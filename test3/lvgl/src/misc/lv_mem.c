@@ -12,6 +12,7 @@
 #include "lv_gc.h"
 #include "lv_assert.h"
 #include "lv_log.h"
+#include "lv_printf.h"
 
 #if LV_MEM_CUSTOM != 0
     #include LV_MEM_CUSTOM_INCLUDE
@@ -21,6 +22,10 @@
     #include LV_MEM_POOL_INCLUDE
 #endif
 
+#if LV_MEM_CUSTOM == 0 && LV_MEM_THREAD_SAFE
+    #include <pthread.h>
+#endif
+
 /*********************
  *      DEFINES
  *********************/
@@ -39,17 +44,133 @@
 
 #define ZERO_MEM_SENTINEL  0xa1b2c3d4
 
+#if LV_MEM_CUSTOM == 0 && LV_MEM_THREAD_SAFE
+    #define MEM_THREAD_SAFE     1
+    #define MEM_THREAD_LOCAL    __thread
+    #define TCACHE_CNT          LV_MEM_THREAD_CACHE_CNT
+#else
+    #define MEM_THREAD_SAFE     0
+    #define MEM_THREAD_LOCAL
+    #define TCACHE_CNT          0
+#endif
+
+#if TCACHE_CNT
+    #define TCACHE_BIN_CNT          5       /*16, 32, 64, 128 and 256 bytes*/
+    #define TCACHE_BIN_SIZE(bin)    (16U << (bin))
+    #define TCACHE_MAX_SIZE         TCACHE_BIN_SIZE(TCACHE_BIN_CNT - 1)
+#endif
+
+#if _LV_MEM_SLAB_CLASS_CNT
+    #define SLAB_PAGE_SIZE      (LV_MEM_SLAB_MAX_SIZE > 256 ? 2048 : 1024)
+    #define SLAB_GRANULE_CNT    (LV_MEM_SIZE / SLAB_PAGE_SIZE + 2)  /*+2: the pool might not be aligned to the granules*/
+    #define SLAB_HEADER_SIZE    ((sizeof(slab_page_t) + ALIGN_MASK) & ~ALIGN_MASK)
+    #define SLAB_MAX_SIZE       (slab_class_size[_LV_MEM_SLAB_CLASS_CNT - 1])
+#endif
+
+#if LV_MEM_BUF_ARENA_SIZE
+    #define ARENA_ALIGN(size)   (((size) + ALIGN_MASK) & ~ALIGN_MASK)
+    #define ARENA_NONE          UINT32_MAX
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
+#if TCACHE_CNT
+/*Blocks freed by a thread. They are reused by the same thread without locking.*/
+typedef struct {
+    void * bins[TCACHE_BIN_CNT];    /*The first free block of each bin. The blocks store the address of the next one.*/
+    uint8_t cnt[TCACHE_BIN_CNT];
+    bool registered;                /*The cache is registered to be flushed when the thread exits*/
+} tcache_t;
+#endif
+
+#if LV_MEM_TAG
+/*Stored before each allocated block. Its size keeps the alignment of the block.*/
+typedef struct {
+    uint32_t size;
+    uint32_t tag;
+} mem_tag_header_t;
+#endif
+
+#if _LV_MEM_SLAB_CLASS_CNT
+/*A page of a size class. It's allocated from TLSF and the blocks follow the header*/
+typedef struct _slab_page_t {
+    struct _slab_page_t * prev;
+    struct _slab_page_t * next;
+    void * free_list;           /*The first free block. The free blocks store the address of the next free block.*/
+    uint16_t used_cnt;
+    uint8_t class_id;
+} slab_page_t;
+
+typedef struct {
+    slab_page_t * partial;      /*Pages with at least one free block*/
+    uint32_t used_cnt;
+    uint16_t page_cnt;
+} slab_class_t;
+#endif
+
+#if LV_MEM_BUF_ARENA_SIZE
+/*Header of a buffer in the arena*/
+typedef struct {
+    uint32_t prev_ofs;          /*Offset of the previous buffer in the chunk or `ARENA_NONE`*/
+    uint32_t size : 31;         /*Size of the buffer together with this header*/
+    uint32_t released : 1;
+} arena_block_t;
+
+/*The static arena is the first chunk. Extra chunks are allocated if it's full.*/
+typedef struct _arena_chunk_t {
+    struct _arena_chunk_t * prev;
+    struct _arena_chunk_t * next;   /*Empty chunks are kept until the end of the refresh*/
+    uint8_t * buf;
+    uint32_t size;
+    uint32_t used;
+    uint32_t last_ofs;              /*Offset of the last buffer or `ARENA_NONE`*/
+} arena_chunk_t;
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+static void * mem_alloc(size_t size);
+static void mem_free(void * data);
+static void * mem_realloc(void * data_p, size_t new_size);
+static void * heap_alloc(size_t size);
+static void heap_free(void * data);
+
+#if TCACHE_CNT
+    static size_t heap_get_size(void * data);
+    static uint32_t tcache_get_bin(size_t size);
+    static void * tcache_pop(uint32_t bin);
+    static bool tcache_push(void * data);
+    static bool tcache_flush(tcache_t * cache);
+    static void tcache_key_create(void);
+    static void tcache_exit_cb(void * cache);
+#endif
+
+#if LV_MEM_TAG
+    static void tag_add(lv_mem_tag_t tag, uint32_t size);
+#endif
+
 #if LV_MEM_CUSTOM == 0
     static void lv_mem_walker(void * ptr, size_t size, int used, void * user);
 #endif
 
+#if _LV_MEM_SLAB_CLASS_CNT
+    static void slab_init(void);
+    static void * slab_alloc(size_t size);
+    static void slab_free(slab_page_t * page, void * data);
+    static slab_page_t * slab_get_page(const void * data);
+    static slab_page_t * slab_get_page_in_granule(uint32_t granule_id, uintptr_t addr);
+    static void slab_monitor(lv_mem_monitor_t * mon_p);
+#endif
+
+#if LV_MEM_BUF_ARENA_SIZE
+    static void arena_init(void);
+    static void * arena_get(uint32_t size);
+    static void arena_release(void * p);
+    static void arena_reset(void);
+#endif
+
 /**********************
  *  STATIC VARIABLES
  **********************/
@@ -61,6 +182,44 @@
 
 static uint32_t zero_mem = ZERO_MEM_SENTINEL; /*Give the address of this variable if 0 byte should be allocated*/
 
+#if MEM_THREAD_SAFE
+    static pthread_mutex_t mem_mutex = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+#if TCACHE_CNT
+    static MEM_THREAD_LOCAL tcache_t tcache;
+    static pthread_key_t tcache_key;
+    static pthread_once_t tcache_key_once = PTHREAD_ONCE_INIT;
+#endif
+
+#if LV_MEM_TAG
+    static MEM_THREAD_LOCAL lv_mem_tag_t tag_act;
+    static lv_mem_tag_monitor_t tag_mon[_LV_MEM_TAG_LAST];
+    static const char * const tag_names[_LV_MEM_TAG_LAST] = {
+        "other", "obj", "style", "img_cache", "font", "timer", "anim", "draw", "user"
+    };
+#endif
+
+#if _LV_MEM_SLAB_CLASS_CNT
+    static const uint16_t slab_class_size[] = {8, 16, 24, 32, 48, 64, 96, 128, 192, 256, 384, 512};
+    static uint8_t slab_class_of[LV_MEM_SLAB_MAX_SIZE / 8 + 1];   /*Class ID for each `(size + 7) / 8`*/
+    static slab_class_t slab_classes[_LV_MEM_SLAB_CLASS_CNT];
+    /*The pool is divided into page sized granules. Each granule stores where a page starts in it as
+     *`offset / 4 + 1` (0: no page starts here). A block's page starts in its granule or in the previous one.*/
+    static uint16_t slab_page_map[SLAB_GRANULE_CNT];
+    static uintptr_t slab_pool_start;                               /*Start of the pool aligned down to the page size*/
+#endif
+
+#if LV_MEM_BUF_ARENA_SIZE
+    static arena_chunk_t arena_first;
+    static arena_chunk_t * arena_act;
+    static uint32_t arena_used;
+    static uint32_t arena_frame_max;
+    static uint32_t arena_last_frame_max;
+    static uint32_t arena_used_max;
+    static uint32_t arena_grow_cnt;
+#endif
+
 /**********************
  *      MACROS
  **********************/
@@ -70,6 +229,14 @@ static uint32_t zero_mem = ZERO_MEM_SENTINEL; /*Give the address of this variabl
     #define MEM_TRACE(...)
 #endif
 
+#if MEM_THREAD_SAFE
+    #define MEM_LOCK()      pthread_mutex_lock(&mem_mutex)
+    #define MEM_UNLOCK()    pthread_mutex_unlock(&mem_mutex)
+#else
+    #define MEM_LOCK()
+    #define MEM_UNLOCK()
+#endif
+
 #define COPY32 *d32 = *s32; d32++; s32++;
 #define COPY8 *d8 = *s8; d8++; s8++;
 #define SET32(x) *d32 = x; d32++;
@@ -100,6 +267,19 @@ void lv_mem_init(void)
 #endif
 #endif
 
+#if _LV_MEM_SLAB_CLASS_CNT
+    slab_init();
+#endif
+
+#if LV_MEM_BUF_ARENA_SIZE
+    arena_init();
+#endif
+
+#if LV_MEM_TAG
+    tag_act = LV_MEM_TAG_OTHER;
+    lv_memset_00(tag_mon, sizeof(tag_mon));
+#endif
+
 #if LV_MEM_ADD_JUNK
     LV_LOG_WARN("LV_MEM_ADD_JUNK is enabled which makes LVGL much slower");
 #endif
@@ -113,6 +293,11 @@ void lv_mem_deinit(void)
 {
 #if LV_MEM_CUSTOM == 0
     lv_tlsf_destroy(tlsf);
+#if TCACHE_CNT
+    /*The cached blocks were in the destroyed pool*/
+    lv_memset_00(tcache.bins, sizeof(tcache.bins));
+    lv_memset_00(tcache.cnt, sizeof(tcache.cnt));
+#endif
     lv_mem_init();
 #endif
 }
@@ -124,42 +309,30 @@ void lv_mem_deinit(void)
  */
 void * lv_mem_alloc(size_t size)
 {
-    MEM_TRACE("allocating %lu bytes", (unsigned long)size);
+#if LV_MEM_TAG
     if(size == 0) {
         MEM_TRACE("using zero_mem");
         return &zero_mem;
     }
 
-#if LV_MEM_CUSTOM == 0
-    void * alloc = lv_tlsf_malloc(tlsf, size);
-#else
-    void * alloc = LV_MEM_CUSTOM_ALLOC(size);
-#endif
-
-    if(alloc == NULL) {
-        LV_LOG_INFO("couldn't allocate memory (%lu bytes)", (unsigned long)size);
-#if LV_LOG_LEVEL <= LV_LOG_LEVEL_INFO
-        lv_mem_monitor_t mon;
-        lv_mem_monitor(&mon);
-        LV_LOG_INFO("used: %6d (%3d %%), frag: %3d %%, biggest free: %6d",
-                    (int)(mon.total_size - mon.free_size), mon.used_pct, mon.frag_pct,
-                    (int)mon.free_biggest_size);
-#endif
-    }
-#if LV_MEM_ADD_JUNK
-    else {
-        lv_memset(alloc, 0xaa, size);
+    mem_tag_header_t * header = mem_alloc(size + sizeof(mem_tag_header_t));
+    if(header == NULL) {
+        LV_LOG_INFO("couldn't allocate memory for %s", tag_names[tag_act]);
+        return NULL;
     }
-#endif
 
-    if(alloc) {
-#if LV_MEM_CUSTOM == 0
-        cur_used += size;
-        max_used = LV_MAX(cur_used, max_used);
+    header->size = size;
+    header->tag = tag_act;
+    MEM_LOCK();
+    tag_add(tag_act, size);
+    tag_mon[tag_act].cur_cnt++;
+    tag_mon[tag_act].alloc_cnt++;
+    MEM_UNLOCK();
+
+    return header + 1;
+#else
+    return mem_alloc(size);
 #endif
-        MEM_TRACE("allocated at %p", alloc);
-    }
-    return alloc;
 }
 
 /**
@@ -168,19 +341,18 @@ void * lv_mem_alloc(size_t size)
  */
 void lv_mem_free(void * data)
 {
-    MEM_TRACE("freeing %p", data);
+#if LV_MEM_TAG
     if(data == &zero_mem) return;
     if(data == NULL) return;
 
-#if LV_MEM_CUSTOM == 0
-#  if LV_MEM_ADD_JUNK
-    lv_memset(data, 0xbb, lv_tlsf_block_size(data));
-#  endif
-    size_t size = lv_tlsf_free(tlsf, data);
-    if(cur_used > size) cur_used -= size;
-    else cur_used = 0;
+    mem_tag_header_t * header = (mem_tag_header_t *)data - 1;
+    MEM_LOCK();
+    tag_mon[header->tag].cur_size -= header->size;
+    tag_mon[header->tag].cur_cnt--;
+    MEM_UNLOCK();
+    mem_free(header);
 #else
-    LV_MEM_CUSTOM_FREE(data);
+    mem_free(data);
 #endif
 }
 
@@ -193,29 +365,36 @@ void lv_mem_free(void * data)
  */
 void * lv_mem_realloc(void * data_p, size_t new_size)
 {
-    MEM_TRACE("reallocating %p with %lu size", data_p, (unsigned long)new_size);
+#if LV_MEM_TAG
     if(new_size == 0) {
         MEM_TRACE("using zero_mem");
         lv_mem_free(data_p);
         return &zero_mem;
     }
 
-    if(data_p == &zero_mem) return lv_mem_alloc(new_size);
+    if(data_p == &zero_mem || data_p == NULL) return lv_mem_alloc(new_size);
 
-#if LV_MEM_CUSTOM == 0
-    void * new_p = lv_tlsf_realloc(tlsf, data_p, new_size);
+    /*Keep the tag of the original allocation*/
+    mem_tag_header_t * header = (mem_tag_header_t *)data_p - 1;
+    uint32_t old_size = header->size;
+    header = mem_realloc(header, new_size + sizeof(mem_tag_header_t));
+    if(header == NULL) return NULL;
+
+    MEM_LOCK();
+    tag_mon[header->tag].cur_size -= old_size;
+    tag_add(header->tag, new_size);
+    MEM_UNLOCK();
+    header->size = new_size;
+
+    return header + 1;
 #else
-    void * new_p = LV_MEM_CUSTOM_REALLOC(data_p, new_size);
+    return mem_realloc(data_p, new_size);
 #endif
-    if(new_p == NULL) {
-        LV_LOG_ERROR("couldn't allocate memory");
-        return NULL;
-    }
-
-    MEM_TRACE("allocated at %p", new_p);
-    return new_p;
 }
 
+
+
+
 lv_res_t lv_mem_test(void)
 {
     if(zero_mem != ZERO_MEM_SENTINEL) {
@@ -224,12 +403,17 @@ lv_res_t lv_mem_test(void)
     }
 
 #if LV_MEM_CUSTOM == 0
-    if(lv_tlsf_check(tlsf)) {
+    MEM_LOCK();
+    int tlsf_res = lv_tlsf_check(tlsf);
+    int pool_res = lv_tlsf_check_pool(lv_tlsf_get_pool(tlsf));
+    MEM_UNLOCK();
+
+    if(tlsf_res) {
         LV_LOG_WARN("failed");
         return LV_RES_INV;
     }
 
-    if(lv_tlsf_check_pool(lv_tlsf_get_pool(tlsf))) {
+    if(pool_res) {
         LV_LOG_WARN("pool failed");
         return LV_RES_INV;
     }
@@ -250,6 +434,7 @@ void lv_mem_monitor(lv_mem_monitor_t * mon_p)
 #if LV_MEM_CUSTOM == 0
     MEM_TRACE("begin");
 
+    MEM_LOCK();
     lv_tlsf_walk_pool(lv_tlsf_get_pool(tlsf), lv_mem_walker, mon_p);
 
     mon_p->total_size = LV_MEM_SIZE;
@@ -264,10 +449,107 @@ void lv_mem_monitor(lv_mem_monitor_t * mon_p)
 
     mon_p->max_used = max_used;
 
+#if _LV_MEM_SLAB_CLASS_CNT
+    slab_monitor(mon_p);
+#endif
+    MEM_UNLOCK();
+
     MEM_TRACE("finished");
 #endif
 }
 
+#if MEM_THREAD_SAFE
+/**
+ * Give back the blocks cached by the calling thread to the heap.
+ * The cache is flushed automatically when the thread exits.
+ */
+void lv_mem_thread_cache_flush(void)
+{
+#if TCACHE_CNT
+    tcache_flush(&tcache);
+#endif
+}
+#endif
+
+#if LV_MEM_TAG
+/**
+ * Set the subsystem the next allocations are attributed to.
+ * @param tag   an element of `LV_MEM_TAG_...`
+ * @return      the previous tag
+ */
+lv_mem_tag_t lv_mem_tag_set(lv_mem_tag_t tag)
+{
+    LV_ASSERT(tag < _LV_MEM_TAG_LAST);
+
+    lv_mem_tag_t tag_prev = tag_act;
+    tag_act = tag;
+    return tag_prev;
+}
+
+/**
+ * Give information about the memory allocated by a subsystem
+ * @param tag   an element of `LV_MEM_TAG_...`
+ * @param mon_p pointer to a lv_mem_tag_monitor_t variable,
+ *              the result of the analysis will be stored here
+ */
+void lv_mem_tag_monitor(lv_mem_tag_t tag, lv_mem_tag_monitor_t * mon_p)
+{
+    LV_ASSERT(tag < _LV_MEM_TAG_LAST);
+
+    MEM_LOCK();
+    *mon_p = tag_mon[tag];
+    MEM_UNLOCK();
+}
+
+/**
+ * Get the name of a tag
+ * @param tag   an element of `LV_MEM_TAG_...`
+ * @return      the name of the subsystem, e.g. "style"
+ */
+const char * lv_mem_tag_get_name(lv_mem_tag_t tag)
+{
+    if(tag >= _LV_MEM_TAG_LAST) return "unknown";
+    return tag_names[tag];
+}
+
+/**
+ * Log the live heap usage of the subsystems with `LV_LOG_USER`, the largest first.
+ */
+void lv_mem_tag_dump(void)
+{
+#if LV_USE_LOG && LV_LOG_LEVEL <= LV_LOG_LEVEL_USER
+    lv_mem_tag_monitor_t tag_mon_copy[_LV_MEM_TAG_LAST];
+    MEM_LOCK();
+    lv_memcpy(tag_mon_copy, tag_mon, sizeof(tag_mon));
+    MEM_UNLOCK();
+
+    /*Sort the tags by the allocated size*/
+    lv_mem_tag_t order[_LV_MEM_TAG_LAST];
+    uint32_t i;
+    for(i = 0; i < _LV_MEM_TAG_LAST; i++) {
+        uint32_t j = i;
+        while(j > 0 && tag_mon_copy[order[j - 1]].cur_size < tag_mon_copy[i].cur_size) {
+            order[j] = order[j - 1];
+            j--;
+        }
+        order[j] = i;
+    }
+
+    uint32_t total = 0;
+    for(i = 0; i < _LV_MEM_TAG_LAST; i++) total += tag_mon_copy[i].cur_size;
+
+    LV_LOG_USER("live heap: %" LV_PRIu32 " bytes", total);
+    for(i = 0; i < _LV_MEM_TAG_LAST; i++) {
+        const lv_mem_tag_monitor_t * mon = &tag_mon_copy[order[i]];
+        if(mon->alloc_cnt == 0) continue;
+        LV_LOG_USER("%-10s %8" LV_PRIu32 " bytes (%3" LV_PRIu32 " %%) in %6" LV_PRIu32 " blocks, max: %8" LV_PRIu32 ", allocations: %"
+                    LV_PRIu32, tag_names[order[i]], mon->cur_size, total ? (uint32_t)((uint64_t)mon->cur_size * 100 / total) : 0,
+                    mon->cur_cnt, mon->max_size, mon->alloc_cnt);
+    }
+#endif
+}
+#endif
+
 
 /**
  * Get a temporal buffer with the given size.
@@ -279,6 +561,10 @@ void * lv_mem_buf_get(uint32_t size)
 
     MEM_TRACE("begin, getting %d bytes", size);
 
+#if LV_MEM_BUF_ARENA_SIZE
+    return arena_get(size);
+#else
+
     /*Try to find a free buffer with suitable size*/
     int8_t i_guess = -1;
     for(uint8_t i = 0; i < LV_MEM_BUF_MAX_NUM; i++) {
@@ -308,7 +594,9 @@ void * lv_mem_buf_get(uint32_t size)
     for(uint8_t i = 0; i < LV_MEM_BUF_MAX_NUM; i++) {
         if(LV_GC_ROOT(lv_mem_buf[i]).used == 0) {
             /*if this fails you probably need to increase your LV_MEM_SIZE/heap size*/
+            lv_mem_tag_t tag_prev = lv_mem_tag_set(LV_MEM_TAG_DRAW);
             void * buf = lv_mem_realloc(LV_GC_ROOT(lv_mem_buf[i]).p, size);
+            lv_mem_tag_set(tag_prev);
             LV_ASSERT_MSG(buf != NULL, "Out of memory, can't allocate a new buffer (increase your LV_MEM_SIZE/heap size)");
             if(buf == NULL) return NULL;
 
@@ -323,6 +611,7 @@ void * lv_mem_buf_get(uint32_t size)
     LV_LOG_ERROR("no more buffers. (increase LV_MEM_BUF_MAX_NUM)");
     LV_ASSERT_MSG(false, "No more buffers. Increase LV_MEM_BUF_MAX_NUM.");
     return NULL;
+#endif
 }
 
 /**
@@ -333,6 +622,10 @@ void lv_mem_buf_release(void * p)
 {
     MEM_TRACE("begin (address: %p)", p);
 
+#if LV_MEM_BUF_ARENA_SIZE
+    arena_release(p);
+#else
+
     for(uint8_t i = 0; i < LV_MEM_BUF_MAX_NUM; i++) {
         if(LV_GC_ROOT(lv_mem_buf[i]).p == p) {
             LV_GC_ROOT(lv_mem_buf[i]).used = 0;
@@ -341,6 +634,7 @@ void lv_mem_buf_release(void * p)
     }
 
     LV_LOG_ERROR("p is not a known buffer");
+#endif
 }
 
 /**
@@ -348,6 +642,9 @@ void lv_mem_buf_release(void * p)
  */
 void lv_mem_buf_free_all(void)
 {
+#if LV_MEM_BUF_ARENA_SIZE
+    arena_reset();
+#else
     for(uint8_t i = 0; i < LV_MEM_BUF_MAX_NUM; i++) {
         if(LV_GC_ROOT(lv_mem_buf[i]).p) {
             lv_mem_free(LV_GC_ROOT(lv_mem_buf[i]).p);
@@ -356,8 +653,25 @@ void lv_mem_buf_free_all(void)
             LV_GC_ROOT(lv_mem_buf[i]).size = 0;
         }
     }
+#endif
 }
 
+#if LV_MEM_BUF_ARENA_SIZE
+/**
+ * Give information about the usage of the intermediate buffer arena
+ * @param mon_p pointer to a lv_mem_buf_arena_monitor_t variable,
+ *              the result of the analysis will be stored here
+ */
+void lv_mem_buf_arena_monitor(lv_mem_buf_arena_monitor_t * mon_p)
+{
+    mon_p->size = LV_MEM_BUF_ARENA_SIZE;
+    mon_p->used = arena_used;
+    mon_p->frame_max = arena_last_frame_max;
+    mon_p->used_max = arena_used_max;
+    mon_p->grow_cnt = arena_grow_cnt;
+}
+#endif
+
 #if LV_MEMCPY_MEMSET_STD == 0
 /**
  * Same as `memcpy` but optimized for 4 byte operation.
@@ -547,6 +861,312 @@ void LV_ATTRIBUTE_FAST_MEM lv_memset_ff(void * dst, size_t len)
  *   STATIC FUNCTIONS
  **********************/
 
+static void * mem_alloc(size_t size)
+{
+    MEM_TRACE("allocating %lu bytes", (unsigned long)size);
+    if(size == 0) {
+        MEM_TRACE("using zero_mem");
+        return &zero_mem;
+    }
+
+#if TCACHE_CNT
+    /*Reuse a block cached by this thread. If there is none allocate the full size of the bin
+     *to make the block reusable for any size of the bin.*/
+    if(size <= TCACHE_MAX_SIZE) {
+        uint32_t bin = tcache_get_bin(size);
+        void * cached = tcache_pop(bin);
+        if(cached) {
+#if LV_MEM_ADD_JUNK
+            lv_memset(cached, 0xaa, size);
+#endif
+            MEM_TRACE("allocated at %p from the thread cache", cached);
+            return cached;
+        }
+        size = TCACHE_BIN_SIZE(bin);
+    }
+#endif
+
+    MEM_LOCK();
+    void * alloc = heap_alloc(size);
+    MEM_UNLOCK();
+
+#if TCACHE_CNT
+    /*Maybe the blocks cached by this thread take the memory*/
+    if(alloc == NULL && tcache_flush(&tcache)) {
+        MEM_LOCK();
+        alloc = heap_alloc(size);
+        MEM_UNLOCK();
+    }
+#endif
+
+    if(alloc == NULL) {
+        LV_LOG_INFO("couldn't allocate memory (%lu bytes)", (unsigned long)size);
+#if LV_LOG_LEVEL <= LV_LOG_LEVEL_INFO
+        lv_mem_monitor_t mon;
+        lv_mem_monitor(&mon);
+        LV_LOG_INFO("used: %6d (%3d %%), frag: %3d %%, biggest free: %6d",
+                    (int)(mon.total_size - mon.free_size), mon.used_pct, mon.frag_pct,
+                    (int)mon.free_biggest_size);
+#endif
+    }
+#if LV_MEM_ADD_JUNK
+    else {
+        lv_memset(alloc, 0xaa, size);
+    }
+#endif
+
+    if(alloc) {
+        MEM_TRACE("allocated at %p", alloc);
+    }
+    return alloc;
+}
+
+static void mem_free(void * data)
+{
+    MEM_TRACE("freeing %p", data);
+    if(data == &zero_mem) return;
+    if(data == NULL) return;
+
+    MEM_LOCK();
+#if TCACHE_CNT
+    /*Keep the small blocks in the thread's cache. Their size can be read only while the heap is locked.*/
+    if(tcache_push(data)) {
+        MEM_UNLOCK();
+        return;
+    }
+#endif
+    heap_free(data);
+    MEM_UNLOCK();
+}
+
+static void * mem_realloc(void * data_p, size_t new_size)
+{
+    MEM_TRACE("reallocating %p with %lu size", data_p, (unsigned long)new_size);
+    if(new_size == 0) {
+        MEM_TRACE("using zero_mem");
+        mem_free(data_p);
+        return &zero_mem;
+    }
+
+    if(data_p == &zero_mem) return mem_alloc(new_size);
+
+#if _LV_MEM_SLAB_CLASS_CNT
+    /*Move the data if it's in a size class or should go to a size class*/
+    MEM_LOCK();
+    slab_page_t * page = slab_get_page(data_p);
+    size_t old_size = page ? slab_class_size[page->class_id] : lv_tlsf_block_size(data_p);
+    MEM_UNLOCK();
+
+    if(page || new_size <= SLAB_MAX_SIZE) {
+        /*Nothing to do if the new size belongs to the same class*/
+        if(page && new_size <= SLAB_MAX_SIZE && slab_class_of[(new_size + 7) >> 3] == page->class_id) return data_p;
+
+        void * new_p = mem_alloc(new_size);
+        if(new_p == NULL) {
+            LV_LOG_ERROR("couldn't allocate memory");
+            return NULL;
+        }
+
+        if(data_p) {
+            lv_memcpy(new_p, data_p, LV_MIN(old_size, new_size));
+            mem_free(data_p);
+        }
+        return new_p;
+    }
+#endif
+
+#if LV_MEM_CUSTOM == 0
+    MEM_LOCK();
+    void * new_p = lv_tlsf_realloc(tlsf, data_p, new_size);
+    MEM_UNLOCK();
+#else
+    void * new_p = LV_MEM_CUSTOM_REALLOC(data_p, new_size);
+#endif
+    if(new_p == NULL) {
+        LV_LOG_ERROR("couldn't allocate memory");
+        return NULL;
+    }
+
+    MEM_TRACE("allocated at %p", new_p);
+    return new_p;
+}
+
+/**
+ * Allocate a block from the size classes, TLSF or the custom allocator.
+ * With `LV_MEM_THREAD_SAFE` the heap should be locked.
+ * @param size      the required size
+ * @return          pointer to the block or NULL if there is not enough memory
+ */
+static void * heap_alloc(size_t size)
+{
+#if _LV_MEM_SLAB_CLASS_CNT
+    /*Small blocks come from the size classes. Use TLSF if there is no space for a new page.*/
+    void * alloc = size <= SLAB_MAX_SIZE ? slab_alloc(size) : NULL;
+    if(alloc == NULL) alloc = lv_tlsf_malloc(tlsf, size);
+#elif LV_MEM_CUSTOM == 0
+    void * alloc = lv_tlsf_malloc(tlsf, size);
+#else
+    void * alloc = LV_MEM_CUSTOM_ALLOC(size);
+#endif
+
+#if LV_MEM_CUSTOM == 0
+    if(alloc) {
+        cur_used += size;
+        max_used = LV_MAX(cur_used, max_used);
+    }
+#endif
+    return alloc;
+}
+
+/**
+ * Give back a block to the size classes, TLSF or the custom allocator.
+ * With `LV_MEM_THREAD_SAFE` the heap should be locked.
+ * @param data      pointer to an allocated block
+ */
+static void heap_free(void * data)
+{
+#if _LV_MEM_SLAB_CLASS_CNT
+    slab_page_t * page = slab_get_page(data);
+    if(page) {
+        uint32_t block_size = slab_class_size[page->class_id];
+        slab_free(page, data);
+        if(cur_used > block_size) cur_used -= block_size;
+        else cur_used = 0;
+        return;
+    }
+#endif
+
+#if LV_MEM_CUSTOM == 0
+#  if LV_MEM_ADD_JUNK
+    lv_memset(data, 0xbb, lv_tlsf_block_size(data));
+#  endif
+    size_t size = lv_tlsf_free(tlsf, data);
+    if(cur_used > size) cur_used -= size;
+    else cur_used = 0;
+#else
+    LV_MEM_CUSTOM_FREE(data);
+#endif
+}
+
+#if TCACHE_CNT
+/**
+ * Get the usable size of an allocated block. The heap should be locked because
+ * the other threads modify the flags in the header of the block when they allocate or free its neighbors.
+ * @param data      pointer to an allocated block
+ * @return          the size of the block in bytes
+ */
+static size_t heap_get_size(void * data)
+{
+#if _LV_MEM_SLAB_CLASS_CNT
+    slab_page_t * page = slab_get_page(data);
+    if(page) return slab_class_size[page->class_id];
+#endif
+    return lv_tlsf_block_size(data);
+}
+
+/**
+ * Get the smallest bin where a block of a given size fits
+ * @param size      the required size. Must be <= `TCACHE_MAX_SIZE`
+ * @return          index of the bin
+ */
+static uint32_t tcache_get_bin(size_t size)
+{
+    uint32_t bin = 0;
+    while(TCACHE_BIN_SIZE(bin) < size) bin++;
+    return bin;
+}
+
+/**
+ * Take a block from a bin of the calling thread's cache
+ * @param bin       index of a bin
+ * @return          pointer to the block or NULL if the bin is empty
+ */
+static void * tcache_pop(uint32_t bin)
+{
+    void * data = tcache.bins[bin];
+    if(data == NULL) return NULL;
+
+    tcache.bins[bin] = *(void **)data;
+    tcache.cnt[bin]--;
+    return data;
+}
+
+/**
+ * Put a freed block to the calling thread's cache. The heap should be locked.
+ * @param data      pointer to an allocated block
+ * @return          true: the block was cached; false: it should be freed
+ */
+static bool tcache_push(void * data)
+{
+    /*Put the block to the largest bin it can serve. Don't keep the blocks much larger than the bins.*/
+    size_t size = heap_get_size(data);
+    if(size < TCACHE_BIN_SIZE(0) || size >= 2 * TCACHE_MAX_SIZE) return false;
+
+    uint32_t bin = TCACHE_BIN_CNT - 1;
+    while(TCACHE_BIN_SIZE(bin) > size) bin--;
+    if(tcache.cnt[bin] >= TCACHE_CNT) return false;
+
+    /*Give back the blocks to the heap when the thread exits*/
+    if(!tcache.registered) {
+        pthread_once(&tcache_key_once, tcache_key_create);
+        pthread_setspecific(tcache_key, &tcache);
+        tcache.registered = true;
+    }
+
+#if LV_MEM_ADD_JUNK
+    lv_memset(data, 0xbb, size);
+#endif
+
+    *(void **)data = tcache.bins[bin];
+    tcache.bins[bin] = data;
+    tcache.cnt[bin]++;
+    return true;
+}
+
+/**
+ * Give back all the blocks of a thread cache to the heap
+ * @param cache     pointer to a thread cache
+ * @return          true: at least one block was freed
+ */
+static bool tcache_flush(tcache_t * cache)
+{
+    bool freed = false;
+
+    MEM_LOCK();
+    uint32_t bin;
+    for(bin = 0; bin < TCACHE_BIN_CNT; bin++) {
+        while(cache->bins[bin]) {
+            void * data = cache->bins[bin];
+            cache->bins[bin] = *(void **)data;
+            heap_free(data);
+            freed = true;
+        }
+        cache->cnt[bin] = 0;
+    }
+    MEM_UNLOCK();
+
+    return freed;
+}
+
+static void tcache_key_create(void)
+{
+    pthread_key_create(&tcache_key, tcache_exit_cb);
+}
+
+static void tcache_exit_cb(void * cache)
+{
+    tcache_flush(cache);
+}
+#endif
+
+#if LV_MEM_TAG
+static void tag_add(lv_mem_tag_t tag, uint32_t size)
+{
+    tag_mon[tag].cur_size += size;
+    tag_mon[tag].max_size = LV_MAX(tag_mon[tag].max_size, tag_mon[tag].cur_size);
+}
+#endif
+
 #if LV_MEM_CUSTOM == 0
 static void lv_mem_walker(void * ptr, size_t size, int used, void * user)
 {
@@ -564,3 +1184,301 @@ static void lv_mem_walker(void * ptr, size_t size, int used, void * user)
     }
 }
 #endif
+
+#if _LV_MEM_SLAB_CLASS_CNT
+static void slab_init(void)
+{
+    lv_memset_00(slab_classes, sizeof(slab_classes));
+    lv_memset_00(slab_page_map, sizeof(slab_page_map));
+    slab_pool_start = (uintptr_t)lv_tlsf_get_pool(tlsf) & ~((uintptr_t)SLAB_PAGE_SIZE - 1);
+
+    uint32_t c = 0;
+    uint32_t i;
+    for(i = 0; i < sizeof(slab_class_of); i++) {
+        while(c < _LV_MEM_SLAB_CLASS_CNT - 1 && slab_class_size[c] < i * 8) c++;
+        slab_class_of[i] = c;
+    }
+}
+
+/**
+ * Allocate a block from the smallest size class where `size` fits
+ * @param size      the required size. Must be <= `SLAB_MAX_SIZE`
+ * @return          pointer to the block or NULL if a new page couldn't be allocated
+ */
+static void * slab_alloc(size_t size)
+{
+    uint32_t class_id = slab_class_of[(size + 7) >> 3];
+    slab_class_t * cls = &slab_classes[class_id];
+
+    slab_page_t * page = cls->partial;
+    if(page == NULL) {
+        /*Don't use `lv_tlsf_memalign` because the alignment gaps would fragment the pool*/
+        page = lv_tlsf_malloc(tlsf, SLAB_PAGE_SIZE);
+        if(page == NULL) return NULL;
+
+        uintptr_t ofs = (uintptr_t)page - slab_pool_start;
+        slab_page_map[ofs / SLAB_PAGE_SIZE] = (ofs % SLAB_PAGE_SIZE) / 4 + 1;
+
+        /*Chain all the blocks into the free list*/
+        uint32_t block_size = slab_class_size[class_id];
+        uint8_t * block = (uint8_t *)page + SLAB_HEADER_SIZE;
+        uint8_t * block_last = (uint8_t *)page + SLAB_PAGE_SIZE - block_size;
+        page->free_list = block;
+        while(block + block_size <= block_last) {
+            *(void **)block = block + block_size;
+            block += block_size;
+        }
+        *(void **)block = NULL;
+
+        page->prev = NULL;
+        page->next = NULL;
+        page->used_cnt = 0;
+        page->class_id = class_id;
+        cls->partial = page;
+        cls->page_cnt++;
+    }
+
+    void * data = page->free_list;
+    page->free_list = *(void **)data;
+    page->used_cnt++;
+    cls->used_cnt++;
+
+    /*Remove the full pages from the list. They are added again when a block is freed.*/
+    if(page->free_list == NULL) {
+        cls->partial = page->next;
+        if(page->next) page->next->prev = NULL;
+        page->next = NULL;
+    }
+
+    return data;
+}
+
+/**
+ * Give back a block to its page. Free the page if it became empty.
+ * @param page      the page of the block
+ * @param data      pointer to the block
+ */
+static void slab_free(slab_page_t * page, void * data)
+{
+    slab_class_t * cls = &slab_classes[page->class_id];
+
+#if LV_MEM_ADD_JUNK
+    lv_memset(data, 0xbb, slab_class_size[page->class_id]);
+#endif
+
+    bool was_full = page->free_list == NULL;
+    *(void **)data = page->free_list;
+    page->free_list = data;
+    page->used_cnt--;
+    cls->used_cnt--;
+
+    if(was_full) {
+        page->prev = NULL;
+        page->next = cls->partial;
+        if(cls->partial) cls->partial->prev = page;
+        cls->partial = page;
+    }
+
+    /*Give back the empty pages to TLSF right away. Kept pages would split the large free areas.*/
+    if(page->used_cnt == 0) {
+        if(page->prev) page->prev->next = page->next;
+        else cls->partial = page->next;
+        if(page->next) page->next->prev = page->prev;
+
+        slab_page_map[((uintptr_t)page - slab_pool_start) / SLAB_PAGE_SIZE] = 0;
+        cls->page_cnt--;
+        lv_tlsf_free(tlsf, page);
+    }
+}
+
+/**
+ * Get the size class page of an allocated memory
+ * @param data      pointer to an allocated memory
+ * @return          pointer to the page or NULL if `data` was allocated by TLSF
+ */
+static slab_page_t * slab_get_page(const void * data)
+{
+    uintptr_t addr = (uintptr_t)data;
+    if(addr < slab_pool_start) return NULL;
+
+    uint32_t granule_id = (addr - slab_pool_start) / SLAB_PAGE_SIZE;
+    if(granule_id >= SLAB_GRANULE_CNT) return NULL;
+
+    slab_page_t * page = slab_get_page_in_granule(granule_id, addr);
+    if(page == NULL && granule_id > 0) page = slab_get_page_in_granule(granule_id - 1, addr);
+    return page;
+}
+
+/**
+ * Get the page starting in a granule if it contains an address
+ * @param granule_id    index of a granule
+ * @param addr          an address
+ * @return              pointer to the page or NULL if there is no page in the granule or `addr` is out of it
+ */
+static slab_page_t * slab_get_page_in_granule(uint32_t granule_id, uintptr_t addr)
+{
+    if(slab_page_map[granule_id] == 0) return NULL;
+
+    uintptr_t page_addr = slab_pool_start + granule_id * SLAB_PAGE_SIZE + (slab_page_map[granule_id] - 1) * 4;
+    if(addr < page_addr || addr >= page_addr + SLAB_PAGE_SIZE) return NULL;
+
+    return (slab_page_t *)page_addr;
+}
+
+static void slab_monitor(lv_mem_monitor_t * mon_p)
+{
+    uint32_t free_size = 0;
+    uint32_t i;
+    for(i = 0; i < _LV_MEM_SLAB_CLASS_CNT; i++) {
+        lv_mem_slab_monitor_t * m = &mon_p->slab[i];
+        uint32_t block_size = slab_class_size[i];
+        uint32_t block_cnt = slab_classes[i].page_cnt * ((SLAB_PAGE_SIZE - SLAB_HEADER_SIZE) / block_size);
+
+        m->block_size = block_size;
+        m->page_cnt = slab_classes[i].page_cnt;
+        m->used_cnt = slab_classes[i].used_cnt;
+        m->free_cnt = block_cnt - m->used_cnt;
+        m->frag_pct = block_cnt ? (m->free_cnt * 100U) / block_cnt : 0;
+
+        mon_p->slab_size += m->page_cnt * SLAB_PAGE_SIZE;
+        free_size += m->free_cnt * block_size;
+    }
+
+    mon_p->slab_frag_pct = mon_p->slab_size ? (free_size * 100U) / mon_p->slab_size : 0;
+}
+#endif
+
+#if LV_MEM_BUF_ARENA_SIZE
+static void arena_init(void)
+{
+    static LV_ATTRIBUTE_LARGE_RAM_ARRAY MEM_UNIT arena_mem[(LV_MEM_BUF_ARENA_SIZE + sizeof(MEM_UNIT) - 1) / sizeof(MEM_UNIT)];
+
+    arena_first.prev = NULL;
+    arena_first.next = NULL;
+    arena_first.buf = (uint8_t *)arena_mem;
+    arena_first.size = sizeof(arena_mem);
+    arena_first.used = 0;
+    arena_first.last_ofs = ARENA_NONE;
+    arena_act = &arena_first;
+    arena_used = 0;
+}
+
+/**
+ * Take a buffer from the end of the arena. Continue in a new chunk if the current one is full.
+ * @param size      the required size
+ * @return          pointer to the buffer or NULL if an extra chunk couldn't be allocated
+ */
+static void * arena_get(uint32_t size)
+{
+    uint32_t block_size = ARENA_ALIGN(size) + ARENA_ALIGN(sizeof(arena_block_t));
+    arena_chunk_t * chunk = arena_act;
+
+    if(chunk->used + block_size > chunk->size) {
+        /*Free the next chunks if the buffer doesn't fit into the first of them. They are all empty.*/
+        arena_chunk_t * next = chunk->next;
+        if(next && next->size < block_size) {
+            while(next) {
+                arena_chunk_t * tmp = next->next;
+                lv_mem_free(next);
+                next = tmp;
+            }
+            chunk->next = NULL;
+        }
+
+        if(next == NULL) {
+            uint32_t chunk_size = LV_MAX(block_size, LV_MEM_BUF_ARENA_SIZE);
+            lv_mem_tag_t tag_prev = lv_mem_tag_set(LV_MEM_TAG_DRAW);
+            next = lv_mem_alloc(ARENA_ALIGN(sizeof(arena_chunk_t)) + chunk_size);
+            lv_mem_tag_set(tag_prev);
+            LV_ASSERT_MSG(next != NULL, "Out of memory, can't allocate a new buffer (increase your LV_MEM_SIZE/heap size)");
+            if(next == NULL) return NULL;
+
+            next->prev = chunk;
+            next->next = NULL;
+            next->buf = (uint8_t *)next + ARENA_ALIGN(sizeof(arena_chunk_t));
+            next->size = chunk_size;
+            next->used = 0;
+            next->last_ofs = ARENA_NONE;
+            chunk->next = next;
+            arena_grow_cnt++;
+            LV_LOG_INFO("the arena is full, allocated a new chunk (increase LV_MEM_BUF_ARENA_SIZE)");
+        }
+
+        chunk = next;
+        arena_act = chunk;
+    }
+
+    arena_block_t * block = (arena_block_t *)(chunk->buf + chunk->used);
+    block->prev_ofs = chunk->last_ofs;
+    block->size = block_size;
+    block->released = 0;
+    chunk->last_ofs = chunk->used;
+    chunk->used += block_size;
+
+    arena_used += block_size;
+    arena_frame_max = LV_MAX(arena_frame_max, arena_used);
+    arena_used_max = LV_MAX(arena_used_max, arena_used);
+
+    MEM_TRACE("allocated at %p", (uint8_t *)block + ARENA_ALIGN(sizeof(arena_block_t)));
+    return (uint8_t *)block + ARENA_ALIGN(sizeof(arena_block_t));
+}
+
+/**
+ * Mark a buffer as released and drop the released buffers from the end of the arena
+ * @param p         pointer to a buffer
+ */
+static void arena_release(void * p)
+{
+    arena_chunk_t * chunk;
+    for(chunk = arena_act; chunk; chunk = chunk->prev) {
+        if((uint8_t *)p >= chunk->buf && (uint8_t *)p < chunk->buf + chunk->used) break;
+    }
+
+    if(chunk == NULL) {
+        LV_LOG_ERROR("p is not a known buffer");
+        return;
+    }
+
+    arena_block_t * block = (arena_block_t *)((uint8_t *)p - ARENA_ALIGN(sizeof(arena_block_t)));
+    block->released = 1;
+
+    /*The buffers are usually released in reverse order so typically the end of the arena can be dropped*/
+    chunk = arena_act;
+    while(1) {
+        while(chunk->last_ofs != ARENA_NONE) {
+            arena_block_t * last = (arena_block_t *)(chunk->buf + chunk->last_ofs);
+            if(last->released == 0) return;
+
+            chunk->used = chunk->last_ofs;
+            chunk->last_ofs = last->prev_ofs;
+            arena_used -= last->size;
+        }
+
+        if(chunk->prev == NULL) return;
+        chunk = chunk->prev;
+        arena_act = chunk;
+    }
+}
+
+/**
+ * Drop all the buffers and free the extra chunks
+ */
+static void arena_reset(void)
+{
+    arena_chunk_t * chunk = arena_first.next;
+    while(chunk) {
+        arena_chunk_t * next = chunk->next;
+        lv_mem_free(chunk);
+        chunk = next;
+    }
+
+    arena_first.next = NULL;
+    arena_first.used = 0;
+    arena_first.last_ofs = ARENA_NONE;
+    arena_act = &arena_first;
+    arena_used = 0;
+
+    arena_last_frame_max = arena_frame_max;
+    arena_frame_max = 0;
+}
+#endif
@@ -25,10 +25,65 @@ extern "C" {
  *      DEFINES
  *********************/
 
+/*Number of the size classes used for the small blocks*/
+#if LV_MEM_CUSTOM == 0 && LV_MEM_SLAB_MAX_SIZE > 0
+#define _LV_MEM_SLAB_CLASS_CNT ((LV_MEM_SLAB_MAX_SIZE >= 8) + (LV_MEM_SLAB_MAX_SIZE >= 16) + \
+                                (LV_MEM_SLAB_MAX_SIZE >= 24) + (LV_MEM_SLAB_MAX_SIZE >= 32) + \
+                                (LV_MEM_SLAB_MAX_SIZE >= 48) + (LV_MEM_SLAB_MAX_SIZE >= 64) + \
+                                (LV_MEM_SLAB_MAX_SIZE >= 96) + (LV_MEM_SLAB_MAX_SIZE >= 128) + \
+                                (LV_MEM_SLAB_MAX_SIZE >= 192) + (LV_MEM_SLAB_MAX_SIZE >= 256) + \
+                                (LV_MEM_SLAB_MAX_SIZE >= 384) + (LV_MEM_SLAB_MAX_SIZE >= 512))
+#else
+#define _LV_MEM_SLAB_CLASS_CNT 0
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
 
+/**
+ * The subsystems the allocations are attributed to if `LV_MEM_TAG` is enabled
+ */
+enum {
+    LV_MEM_TAG_OTHER,       /**< Not attributed to any subsystem*/
+    LV_MEM_TAG_OBJ,         /**< Objects and the data of the widgets*/
+    LV_MEM_TAG_STYLE,       /**< Styles, style lists and transitions*/
+    LV_MEM_TAG_IMG_CACHE,   /**< Image cache and the decoded images*/
+    LV_MEM_TAG_FONT,        /**< Fonts loaded at run time*/
+    LV_MEM_TAG_TIMER,       /**< Timers*/
+    LV_MEM_TAG_ANIM,        /**< Animations*/
+    LV_MEM_TAG_DRAW,        /**< Intermediate buffers, layers and other drawing data*/
+    LV_MEM_TAG_USER,        /**< Free to use by the application*/
+    _LV_MEM_TAG_LAST,
+};
+
+typedef uint8_t lv_mem_tag_t;
+
+#if LV_MEM_TAG
+/**
+ * Live heap usage of a subsystem
+ */
+typedef struct {
+    uint32_t cur_size;      /**< Currently allocated bytes*/
+    uint32_t cur_cnt;       /**< Number of currently allocated blocks*/
+    uint32_t max_size;      /**< Max. allocated bytes*/
+    uint32_t alloc_cnt;     /**< Number of allocations since start-up*/
+} lv_mem_tag_monitor_t;
+#endif
+
+#if _LV_MEM_SLAB_CLASS_CNT
+/**
+ * Usage of a size class
+ */
+typedef struct {
+    uint16_t block_size;    /**< Size of the blocks in the class*/
+    uint16_t page_cnt;      /**< Number of pages allocated for the class*/
+    uint32_t used_cnt;      /**< Number of allocated blocks*/
+    uint32_t free_cnt;      /**< Number of free blocks in the pages of the class*/
+    uint8_t frag_pct;       /**< Percentage of the free blocks. This memory can't be used by other sizes*/
+} lv_mem_slab_monitor_t;
+#endif
+
 /**
  * Heap information structure.
  */
@@ -41,6 +96,11 @@ typedef struct {
     uint32_t max_used; /**< Max size of Heap memory used*/
     uint8_t used_pct; /**< Percentage used*/
     uint8_t frag_pct; /**< Amount of fragmentation*/
+#if _LV_MEM_SLAB_CLASS_CNT
+    uint32_t slab_size;     /**< Memory taken by the pages of the size classes*/
+    uint8_t slab_frag_pct;  /**< Percentage of the free blocks in the pages of the size classes*/
+    lv_mem_slab_monitor_t slab[_LV_MEM_SLAB_CLASS_CNT]; /**< Usage of each size class*/
+#endif
 } lv_mem_monitor_t;
 
 typedef struct {
@@ -51,6 +111,19 @@ typedef struct {
 
 typedef lv_mem_buf_t lv_mem_buf_arr_t[LV_MEM_BUF_MAX_NUM];
 
+#if LV_MEM_BUF_ARENA_SIZE
+/**
+ * Usage of the arena of the intermediate buffers
+ */
+typedef struct {
+    uint32_t size;          /**< Size of the static arena*/
+    uint32_t used;          /**< Currently used bytes*/
+    uint32_t frame_max;     /**< Max. used bytes in the last refresh*/
+    uint32_t used_max;      /**< Max. used bytes ever (high-water mark). `LV_MEM_BUF_ARENA_SIZE` should be at least this*/
+    uint32_t grow_cnt;      /**< Number of extra chunks allocated because the arena was full*/
+} lv_mem_buf_arena_monitor_t;
+#endif
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -63,6 +136,7 @@ void lv_mem_init(void);
 /**
  * Clean up the memory buffer which frees all the allocated memories.
  * @note It work only if `LV_MEM_CUSTOM == 0`
+ * @note With `LV_MEM_THREAD_SAFE` the other threads shouldn't use the heap anymore
  */
 void lv_mem_deinit(void);
 
@@ -101,6 +175,51 @@ lv_res_t lv_mem_test(void);
  */
 void lv_mem_monitor(lv_mem_monitor_t * mon_p);
 
+#if LV_MEM_CUSTOM == 0 && LV_MEM_THREAD_SAFE
+/**
+ * Give back the blocks cached by the calling thread to the heap.
+ * The cache is flushed automatically when the thread exits.
+ */
+void lv_mem_thread_cache_flush(void);
+#endif
+
+#if LV_MEM_TAG
+/**
+ * Set the subsystem the next allocations are attributed to.
+ * Typically the previous tag is restored when the subsystem is done:
+ * `lv_mem_tag_t tag_prev = lv_mem_tag_set(LV_MEM_TAG_...); ... lv_mem_tag_set(tag_prev);`
+ * @param tag   an element of `LV_MEM_TAG_...`
+ * @return      the previous tag
+ */
+lv_mem_tag_t lv_mem_tag_set(lv_mem_tag_t tag);
+
+/**
+ * Give information about the memory allocated by a subsystem
+ * @param tag   an element of `LV_MEM_TAG_...`
+ * @param mon_p pointer to a lv_mem_tag_monitor_t variable,
+ *              the result of the analysis will be stored here
+ */
+void lv_mem_tag_monitor(lv_mem_tag_t tag, lv_mem_tag_monitor_t * mon_p);
+
+/**
+ * Get the name of a tag
+ * @param tag   an element of `LV_MEM_TAG_...`
+ * @return      the name of the subsystem, e.g. "style"
+ */
+const char * lv_mem_tag_get_name(lv_mem_tag_t tag);
+
+/**
+ * Log the live heap usage of the subsystems with `LV_LOG_USER`, the largest first.
+ */
+void lv_mem_tag_dump(void);
+#else
+static inline lv_mem_tag_t lv_mem_tag_set(lv_mem_tag_t tag)
+{
+    LV_UNUSED(tag);
+    return LV_MEM_TAG_OTHER;
+}
+#endif
+
 
 /**
  * Get a temporal buffer with the given size.
@@ -119,6 +238,15 @@ void lv_mem_buf_release(void * p);
  */
 void lv_mem_buf_free_all(void);
 
+#if LV_MEM_BUF_ARENA_SIZE
+/**
+ * Give information about the usage of the intermediate buffer arena
+ * @param mon_p pointer to a lv_mem_buf_arena_monitor_t variable,
+ *              the result of the analysis will be stored here
+ */
+void lv_mem_buf_arena_monitor(lv_mem_buf_arena_monitor_t * mon_p);
+#endif
+
 //! @cond Doxygen_Suppress
 
 #if LV_MEMCPY_MEMSET_STD
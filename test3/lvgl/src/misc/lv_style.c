@@ -253,7 +253,9 @@ bool lv_style_remove_prop(lv_style_t * style, lv_style_prop_t prop)
             }
             else {
                 size_t size = (style->prop_cnt - 1) * (sizeof(lv_style_value_t) + sizeof(uint16_t));
+                lv_mem_tag_t tag_prev = lv_mem_tag_set(LV_MEM_TAG_STYLE);
                 uint8_t * new_values_and_props = lv_mem_alloc(size);
+                lv_mem_tag_set(tag_prev);
                 if(new_values_and_props == NULL) return false;
                 style->v_p.values_and_props = new_values_and_props;
                 style->prop_cnt--;
@@ -463,7 +465,9 @@ static void lv_style_set_prop_internal(lv_style_t * style, lv_style_prop_t prop_
             return;
         }
         size_t size = (style->prop_cnt + 1) * (sizeof(lv_style_value_t) + sizeof(uint16_t));
+        lv_mem_tag_t tag_prev = lv_mem_tag_set(LV_MEM_TAG_STYLE);
         uint8_t * values_and_props = lv_mem_alloc(size);
+        lv_mem_tag_set(tag_prev);
         if(values_and_props == NULL) return;
         lv_style_value_t value_tmp = style->v_p.value1;
         style->v_p.values_and_props = values_and_props;
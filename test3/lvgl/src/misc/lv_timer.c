@@ -11,6 +11,7 @@
 #include "lv_mem.h"
 #include "lv_ll.h"
 #include "lv_gc.h"
+#include "lv_math.h"
 
 /*********************
  *      DEFINES
@@ -18,6 +19,12 @@
 #define IDLE_MEAS_PERIOD 500 /*[ms]*/
 #define DEF_PERIOD 500
 
+/*The deadlines are compared by their signed difference so keep them in half of the tick range*/
+#define MAX_DELAY  ((uint32_t)INT32_MAX)
+
+/*`a` is due earlier than `b`*/
+#define DEADLINE_BEFORE(a, b) ((int32_t)((a) - (b)) < 0)
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -30,14 +37,20 @@ static lv_timer_reset_idle_cb_t reset_idle_time_cb;
 
 static bool lv_timer_exec(lv_timer_t * timer);
 static uint32_t lv_timer_time_remaining(lv_timer_t * timer);
+static void timer_schedule(lv_timer_t * timer, uint32_t delay);
+static void timer_unschedule(lv_timer_t * timer);
+static bool heap_reserve(uint32_t cnt);
+static void heap_sift_up(uint32_t id);
+static void heap_sift_down(uint32_t id);
 
 /**********************
  *  STATIC VARIABLES
  **********************/
 static bool lv_timer_run = false;
 static uint8_t idle_last = 0;
-static bool timer_deleted;
-static bool timer_created;
+static uint32_t timer_cnt;
+static uint32_t heap_cnt;
+static uint32_t heap_size;
 
 /**********************
  *      MACROS
@@ -74,6 +87,10 @@ void lv_timer_reset_idle(void)
 void _lv_timer_core_init(void)
 {
     _lv_ll_init(&LV_GC_ROOT(_lv_timer_ll), sizeof(lv_timer_t));
+    LV_GC_ROOT(_lv_timer_heap) = NULL;
+    timer_cnt = 0;
+    heap_cnt = 0;
+    heap_size = 0;
 
     /*Initially enable the lv_timer handling*/
     lv_timer_enable(true);
@@ -115,39 +132,28 @@ uint32_t LV_ATTRIBUTE_TIMER_HANDLER lv_timer_handler(void)
         }
     }
 
-    /*Run all timer from the list*/
-    lv_timer_t * next;
-    do {
-        timer_deleted             = false;
-        timer_created             = false;
-        LV_GC_ROOT(_lv_timer_act) = _lv_ll_get_head(&LV_GC_ROOT(_lv_timer_ll));
-        while(LV_GC_ROOT(_lv_timer_act)) {
-            /*The timer might be deleted if it runs only once ('repeat_count = 1')
-             *So get next element until the current is surely valid*/
-            next = _lv_ll_get_next(&LV_GC_ROOT(_lv_timer_ll), LV_GC_ROOT(_lv_timer_act));
-
-            if(lv_timer_exec(LV_GC_ROOT(_lv_timer_act))) {
-                /*If a timer was created or deleted then this or the next item might be corrupted*/
-                if(timer_created || timer_deleted) {
-                    TIMER_TRACE("Start from the first timer again because a timer was created or deleted");
-                    break;
-                }
-            }
-
-            LV_GC_ROOT(_lv_timer_act) = next; /*Load the next timer*/
-        }
-    } while(LV_GC_ROOT(_lv_timer_act));
+    /*Run the timers which were due when the handler started in the order of their deadline.
+     *The heap is updated by the timer API so timers created or deleted by the callbacks need no rescan.
+     *The executed timers are scheduled after `handler_start` hence each timer runs at most once per call.*/
+    while(heap_cnt > 0) {
+        lv_timer_t * timer = LV_GC_ROOT(_lv_timer_heap)[0];
+        if(DEADLINE_BEFORE(handler_start, timer->deadline)) break;
 
-    uint32_t time_till_next = LV_NO_TIMER_READY;
-    next = _lv_ll_get_head(&LV_GC_ROOT(_lv_timer_ll));
-    while(next) {
-        if(!next->paused) {
-            uint32_t delay = lv_timer_time_remaining(next);
-            if(delay < time_till_next)
-                time_till_next = delay;
+        LV_GC_ROOT(_lv_timer_act) = timer;
+        lv_timer_exec(timer);
+
+        /*`_lv_timer_act` is cleared if the timer was deleted*/
+        if(LV_GC_ROOT(_lv_timer_act) && timer->heap_id != LV_TIMER_NOT_SCHEDULED) {
+            timer_schedule(timer, lv_timer_time_remaining(timer));
+            if(!DEADLINE_BEFORE(handler_start, timer->deadline)) timer_schedule(timer, 1);
         }
+    }
+    LV_GC_ROOT(_lv_timer_act) = NULL;
 
-        next = _lv_ll_get_next(&LV_GC_ROOT(_lv_timer_ll), next); /*Find the next timer*/
+    uint32_t time_till_next = LV_NO_TIMER_READY;
+    if(heap_cnt > 0) {
+        int32_t delay = (int32_t)(LV_GC_ROOT(_lv_timer_heap)[0]->deadline - lv_tick_get());
+        time_till_next = delay > 0 ? (uint32_t)delay : 0;
     }
 
     busy_time += lv_tick_elaps(handler_start);
@@ -197,18 +203,24 @@ lv_timer_t * lv_timer_create(lv_timer_cb_t timer_xcb, uint32_t period, void * us
 {
     lv_timer_t * new_timer = NULL;
 
-    new_timer = _lv_ll_ins_head(&LV_GC_ROOT(_lv_timer_ll));
+    lv_mem_tag_t tag_prev = lv_mem_tag_set(LV_MEM_TAG_TIMER);
+    /*Make room in the heap for every timer so resuming or rescheduling a timer can't fail later*/
+    if(heap_reserve(timer_cnt + 1)) new_timer = _lv_ll_ins_head(&LV_GC_ROOT(_lv_timer_ll));
+    lv_mem_tag_set(tag_prev);
     LV_ASSERT_MALLOC(new_timer);
     if(new_timer == NULL) return NULL;
 
+    timer_cnt++;
+
     new_timer->period = period;
     new_timer->timer_cb = timer_xcb;
     new_timer->repeat_count = -1;
     new_timer->paused = 0;
     new_timer->last_run = lv_tick_get();
     new_timer->user_data = user_data;
+    new_timer->heap_id = LV_TIMER_NOT_SCHEDULED;
 
-    timer_created = true;
+    timer_schedule(new_timer, period);
 
     return new_timer;
 }
@@ -229,8 +241,12 @@ void lv_timer_set_cb(lv_timer_t * timer, lv_timer_cb_t timer_cb)
  */
 void lv_timer_del(lv_timer_t * timer)
 {
+    timer_unschedule(timer);
     _lv_ll_remove(&LV_GC_ROOT(_lv_timer_ll), timer);
-    timer_deleted = true;
+    timer_cnt--;
+
+    /*Let the handler know that the running timer doesn't exist anymore*/
+    if(LV_GC_ROOT(_lv_timer_act) == timer) LV_GC_ROOT(_lv_timer_act) = NULL;
 
     lv_mem_free(timer);
 }
@@ -242,11 +258,13 @@ void lv_timer_del(lv_timer_t * timer)
 void lv_timer_pause(lv_timer_t * timer)
 {
     timer->paused = true;
+    timer_unschedule(timer);
 }
 
 void lv_timer_resume(lv_timer_t * timer)
 {
     timer->paused = false;
+    timer_schedule(timer, lv_timer_time_remaining(timer));
 }
 
 /**
@@ -257,6 +275,7 @@ void lv_timer_resume(lv_timer_t * timer)
 void lv_timer_set_period(lv_timer_t * timer, uint32_t period)
 {
     timer->period = period;
+    if(!timer->paused) timer_schedule(timer, lv_timer_time_remaining(timer));
 }
 
 /**
@@ -266,6 +285,7 @@ void lv_timer_set_period(lv_timer_t * timer, uint32_t period)
 void lv_timer_ready(lv_timer_t * timer)
 {
     timer->last_run = lv_tick_get() - timer->period - 1;
+    if(!timer->paused) timer_schedule(timer, 0);
 }
 
 /**
@@ -276,6 +296,9 @@ void lv_timer_ready(lv_timer_t * timer)
 void lv_timer_set_repeat_count(lv_timer_t * timer, int32_t repeat_count)
 {
     timer->repeat_count = repeat_count;
+
+    /*The handler deletes the timer on its next call*/
+    if(repeat_count == 0 && !timer->paused) timer_schedule(timer, 0);
 }
 
 /**
@@ -286,6 +309,7 @@ void lv_timer_set_repeat_count(lv_timer_t * timer, int32_t repeat_count)
 void lv_timer_reset(lv_timer_t * timer)
 {
     timer->last_run = lv_tick_get();
+    if(!timer->paused) timer_schedule(timer, timer->period);
 }
 
 /**
@@ -345,7 +369,7 @@ static bool lv_timer_exec(lv_timer_t * timer)
         exec = true;
     }
 
-    if(timer_deleted == false) { /*The timer might be deleted by itself as well*/
+    if(LV_GC_ROOT(_lv_timer_act) == timer) { /*The timer might be deleted by itself as well*/
         if(timer->repeat_count == 0) { /*The repeat count is over, delete the timer*/
             TIMER_TRACE("deleting timer with %p callback because the repeat count is over", *((void **)&timer->timer_cb));
             lv_timer_del(timer);
@@ -368,3 +392,109 @@ static uint32_t lv_timer_time_remaining(lv_timer_t * timer)
         return 0;
     return timer->period - elp;
 }
+
+/**
+ * Set the deadline of a timer and put it to its place in the heap of the scheduled timers.
+ * @param timer pointer to lv_timer
+ * @param delay the timer is due `delay` ms from now
+ */
+static void timer_schedule(lv_timer_t * timer, uint32_t delay)
+{
+    lv_timer_t ** heap = LV_GC_ROOT(_lv_timer_heap);
+
+    uint32_t deadline_prev = timer->deadline;
+    timer->deadline = lv_tick_get() + LV_MIN(delay, MAX_DELAY);
+
+    if(timer->heap_id == LV_TIMER_NOT_SCHEDULED) {
+        /*`heap_reserve` in `lv_timer_create` made room for every timer*/
+        timer->heap_id = heap_cnt;
+        heap[heap_cnt] = timer;
+        heap_cnt++;
+        heap_sift_up(timer->heap_id);
+    }
+    else if(DEADLINE_BEFORE(timer->deadline, deadline_prev)) {
+        heap_sift_up(timer->heap_id);
+    }
+    else {
+        heap_sift_down(timer->heap_id);
+    }
+}
+
+/**
+ * Remove a timer from the heap of the scheduled timers.
+ * @param timer pointer to lv_timer
+ */
+static void timer_unschedule(lv_timer_t * timer)
+{
+    if(timer->heap_id == LV_TIMER_NOT_SCHEDULED) return;
+
+    lv_timer_t ** heap = LV_GC_ROOT(_lv_timer_heap);
+    uint32_t id = timer->heap_id;
+    timer->heap_id = LV_TIMER_NOT_SCHEDULED;
+
+    heap_cnt--;
+    if(id == heap_cnt) return;
+
+    /*Fill the hole with the last timer and move it up or down to its place*/
+    lv_timer_t * last = heap[heap_cnt];
+    heap[id] = last;
+    last->heap_id = id;
+    if(id > 0 && DEADLINE_BEFORE(last->deadline, heap[(id - 1) / 2]->deadline)) heap_sift_up(id);
+    else heap_sift_down(id);
+}
+
+/**
+ * Make sure the heap can store `cnt` timers.
+ * @param cnt the number of timers to store
+ * @return true: success; false: out of memory
+ */
+static bool heap_reserve(uint32_t cnt)
+{
+    if(cnt <= heap_size) return true;
+
+    uint32_t new_size = heap_size ? heap_size * 2 : 8;
+    lv_timer_t ** heap = lv_mem_realloc(LV_GC_ROOT(_lv_timer_heap), new_size * sizeof(lv_timer_t *));
+    if(heap == NULL) return false;
+
+    LV_GC_ROOT(_lv_timer_heap) = heap;
+    heap_size = new_size;
+    return true;
+}
+
+static void heap_sift_up(uint32_t id)
+{
+    lv_timer_t ** heap = LV_GC_ROOT(_lv_timer_heap);
+    lv_timer_t * timer = heap[id];
+
+    while(id > 0) {
+        uint32_t parent = (id - 1) / 2;
+        if(!DEADLINE_BEFORE(timer->deadline, heap[parent]->deadline)) break;
+
+        heap[id] = heap[parent];
+        heap[id]->heap_id = id;
+        id = parent;
+    }
+
+    heap[id] = timer;
+    timer->heap_id = id;
+}
+
+static void heap_sift_down(uint32_t id)
+{
+    lv_timer_t ** heap = LV_GC_ROOT(_lv_timer_heap);
+    lv_timer_t * timer = heap[id];
+
+    while(1) {
+        uint32_t child = id * 2 + 1;
+        if(child >= heap_cnt) break;
+        if(child + 1 < heap_cnt && DEADLINE_BEFORE(heap[child + 1]->deadline, heap[child]->deadline)) child++;
+        if(!DEADLINE_BEFORE(heap[child]->deadline, timer->deadline)) break;
+
+        heap[id] = heap[child];
+        heap[id]->heap_id = id;
+        id = child;
+    }
+
+    heap[id] = timer;
+    timer->heap_id = id;
+}
@@ -26,6 +26,7 @@ extern "C" {
 #endif
 
 #define LV_NO_TIMER_READY 0xFFFFFFFF
+#define LV_TIMER_NOT_SCHEDULED 0xFFFFFFFF
 
 /**********************
  *      TYPEDEFS
@@ -59,6 +60,8 @@ typedef struct _lv_timer_t {
     lv_timer_cb_t timer_cb; /**< Timer function*/
     void * user_data; /**< Custom user data*/
     int32_t repeat_count; /**< 1: One time;  -1 : infinity;  n>0: residual times*/
+    uint32_t deadline; /**< Tick when the timer is due. The key of the timer in the heap of the scheduled timers*/
+    uint32_t heap_id; /**< Index in the heap of the scheduled timers or `LV_TIMER_NOT_SCHEDULED` if it's paused*/
     uint32_t paused : 1;
 } lv_timer_t;
 
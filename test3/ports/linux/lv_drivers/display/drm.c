@@ -685,6 +685,22 @@ static int drm_setup_buffers(void)
 	return 0;
 }
 
+int drm_get_fd(void)
+{
+	return drm_dev.fd;
+}
+
+void drm_handle_event(void)
+{
+	drmHandleEvent(drm_dev.fd, &drm_dev.drm_event_ctx);
+
+	/* The page flip is done, the next flush can commit without waiting */
+	if (drm_dev.req) {
+		drmModeAtomicFree(drm_dev.req);
+		drm_dev.req = NULL;
+	}
+}
+
 void drm_wait_vsync(lv_disp_drv_t *disp_drv)
 {
 	int ret;
@@ -45,6 +45,10 @@ void drm_get_sizes(lv_coord_t *width, lv_coord_t *height, uint32_t *dpi);
 void drm_exit(void);
 void drm_flush(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p);
 void drm_wait_vsync(lv_disp_drv_t * drv);
+/* The DRM fd becomes readable when the requested page flip is done. Then call `drm_handle_event()`
+ * so `drm_flush()` needn't block in `drm_wait_vsync()` */
+int drm_get_fd(void);
+void drm_handle_event(void);
 
 
 /**********************
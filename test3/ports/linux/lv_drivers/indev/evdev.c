@@ -101,6 +101,17 @@ bool evdev_set_file(char* dev_name)
 
      return true;
 }
+
+/**
+ * Get the file descriptor of the evdev device to wait for input events on it.
+ * It changes when `evdev_set_file()` opens an other device.
+ * @return the file descriptor or -1 if no device is open
+ */
+int evdev_get_fd(void)
+{
+    return evdev_fd;
+}
+
 /**
  * Get the current position and state of the evdev
  * @param data store the evdev data here
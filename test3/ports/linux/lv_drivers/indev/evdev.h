@@ -52,6 +52,12 @@ void evdev_init(void);
  *         false: the device file doesn't exist current system
  */
 bool evdev_set_file(char* dev_name);
+/**
+ * Get the file descriptor of the evdev device to wait for input events on it.
+ * It changes when `evdev_set_file()` opens an other device.
+ * @return the file descriptor or -1 if no device is open
+ */
+int evdev_get_fd(void);
 /**
  * Get the current position and state of the evdev
  * @param data store the evdev data here
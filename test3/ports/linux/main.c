@@ -13,6 +13,7 @@
 #include <limits.h>
 #include <errno.h>
 #include <poll.h>
+#include <sys/epoll.h>
 #include "lvgl.h"
 #include "lv_drivers/wayland/wayland.h"
 #include "lv_drivers/display/drm.h"
@@ -20,6 +21,7 @@
 #include "gui_guider.h"
 #include "events_init.h"
 #include "custom.h"
+#include "nxp_gg_loop.h"
 
 lv_ui guider_ui;
 
@@ -31,6 +33,8 @@ int sleep_time;
 static bool close_cb(lv_disp_t * disp)
 {
 }
+#else
+static void loop_init(void);
 #endif
 
 static void hal_init(void);
@@ -73,18 +77,65 @@ int main(void)
         while ((poll(&pfd, 1, sleep_time) < 0) && (errno == EINTR));
     }
 #else
-    uint32_t idle_time;
-
-    while(1) {
-        /* Returns the time to the next timer execution */
-        idle_time = lv_timer_handler();
-	usleep(idle_time * 1000);
+    /* Sleep until the next timer, an input event or a page flip */
+    if (gg_loop_init() == 0) {
+        loop_init();
+        gg_loop_run();
+        gg_loop_deinit();
+    } else {
+        uint32_t idle_time;
+
+        perror("gg_loop_init");
+        while(1) {
+            /* Returns the time to the next timer execution */
+            idle_time = lv_timer_handler();
+            usleep(idle_time * 1000);
+        }
     }
 #endif
 
     return 0;
 }
 
+#if !USE_WAYLAND
+#if USE_EVDEV
+/* Read the input devices now instead of at their next read period */
+static void evdev_ready_cb(int fd, uint32_t events, void * user_data)
+{
+    lv_indev_t * indev = lv_indev_get_next(NULL);
+    while (indev) {
+        if (indev->driver->read_timer)
+            lv_timer_ready(indev->driver->read_timer);
+        indev = lv_indev_get_next(indev);
+    }
+}
+#endif
+
+#if USE_DRM
+static void drm_ready_cb(int fd, uint32_t events, void * user_data)
+{
+    drm_handle_event();
+}
+#endif
+
+/**
+ * Wake the event loop on the input devices and the page flips
+ */
+static void loop_init(void)
+{
+#if USE_EVDEV
+    /* Only the device opened by `evdev_init()` is registered. `evdev_set_file()` closes this fd,
+     * so remove it with `gg_loop_remove_fd()` before switching the device and add the new one after. */
+    if (evdev_get_fd() >= 0 && gg_loop_add_fd(evdev_get_fd(), EPOLLIN, evdev_ready_cb, NULL) < 0)
+        perror("evdev fd");
+#endif
+#if USE_DRM
+    if (drm_get_fd() >= 0 && gg_loop_add_fd(drm_get_fd(), EPOLLIN, drm_ready_cb, NULL) < 0)
+        perror("drm fd");
+#endif
+}
+#endif
+
 /**
  * Initialize the Hardware Abstraction Layer (HAL) for the LVGL graphics library
  */
@@ -0,0 +1,157 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * Copyright 2025 NXP
+ */
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <unistd.h>
+#include <errno.h>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#include "lvgl.h"
+#include "nxp_gg_loop.h"
+
+typedef struct {
+    int fd;
+    gg_loop_fd_cb_t cb;
+    void * user_data;
+    uint32_t gen;   /* Incremented when the slot is reused to drop the events of the previous fd */
+} gg_loop_fd_t;
+
+/* The epoll data of the fds is the slot index and its generation. The timerfd has this index. */
+#define GG_LOOP_TIMER_IDX   GG_LOOP_MAX_FDS
+#define GG_LOOP_DATA(idx, gen)  (((uint64_t)(gen) << 32) | (uint32_t)(idx))
+
+static int epoll_fd = -1;
+static int timer_fd = -1;
+static bool quit;
+static gg_loop_fd_t fds[GG_LOOP_MAX_FDS];
+
+static void timer_arm(uint32_t ms);
+
+int gg_loop_init(void)
+{
+    epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if(epoll_fd < 0) return -1;
+
+    timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if(timer_fd < 0) {
+        gg_loop_deinit();
+        return -1;
+    }
+
+    struct epoll_event ev = { .events = EPOLLIN, .data.u64 = GG_LOOP_DATA(GG_LOOP_TIMER_IDX, 0) };
+    if(epoll_ctl(epoll_fd, EPOLL_CTL_ADD, timer_fd, &ev) < 0) {
+        gg_loop_deinit();
+        return -1;
+    }
+
+    for(int i = 0; i < GG_LOOP_MAX_FDS; i++) fds[i].fd = -1;
+    quit = false;
+
+    return 0;
+}
+
+int gg_loop_add_fd(int fd, uint32_t events, gg_loop_fd_cb_t cb, void * user_data)
+{
+    int idx;
+    for(idx = 0; idx < GG_LOOP_MAX_FDS; idx++) {
+        if(fds[idx].fd < 0) break;
+    }
+    if(idx == GG_LOOP_MAX_FDS) {
+        errno = ENOSPC;
+        return -1;
+    }
+
+    gg_loop_fd_t * slot = &fds[idx];
+    struct epoll_event ev = { .events = events, .data.u64 = GG_LOOP_DATA(idx, slot->gen + 1) };
+    if(epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &ev) < 0) return -1;
+
+    slot->gen++;
+    slot->fd = fd;
+    slot->cb = cb;
+    slot->user_data = user_data;
+
+    return 0;
+}
+
+int gg_loop_remove_fd(int fd)
+{
+    for(int i = 0; i < GG_LOOP_MAX_FDS; i++) {
+        if(fds[i].fd == fd) {
+            /* Clear the slot even if the fd was already closed (and so removed from epoll) */
+            fds[i].fd = -1;
+            fds[i].cb = NULL;
+            if(epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, NULL) < 0 && errno != EBADF) return -1;
+            return 0;
+        }
+    }
+
+    errno = ENOENT;
+    return -1;
+}
+
+void gg_loop_run(void)
+{
+    struct epoll_event events[GG_LOOP_MAX_FDS + 1];
+
+    while(!quit) {
+        /* Returns the time to the next timer execution */
+        uint32_t time_till_next = lv_timer_handler();
+
+        /* A timer is already due, don't sleep */
+        if(time_till_next == 0) continue;
+
+        timer_arm(time_till_next);
+
+        int n = epoll_wait(epoll_fd, events, GG_LOOP_MAX_FDS + 1, -1);
+        if(n < 0) {
+            if(errno == EINTR) continue;
+            LV_LOG_ERROR("epoll_wait failed (errno %d)", errno);
+            return;
+        }
+
+        for(int i = 0; i < n; i++) {
+            uint32_t idx = (uint32_t)events[i].data.u64;
+            uint32_t gen = (uint32_t)(events[i].data.u64 >> 32);
+            if(idx == GG_LOOP_TIMER_IDX) {
+                /* Only clear the expiration, `lv_timer_handler()` runs in the next iteration anyway */
+                uint64_t expirations;
+                while(read(timer_fd, &expirations, sizeof(expirations)) < 0 && errno == EINTR);
+                continue;
+            }
+
+            /* A previous callback might have removed the fd or reused its slot for an other fd */
+            gg_loop_fd_t * slot = &fds[idx];
+            if(slot->fd >= 0 && slot->cb && slot->gen == gen) {
+                slot->cb(slot->fd, events[i].events, slot->user_data);
+            }
+        }
+    }
+}
+
+void gg_loop_quit(void)
+{
+    quit = true;
+}
+
+void gg_loop_deinit(void)
+{
+    if(timer_fd >= 0) close(timer_fd);
+    if(epoll_fd >= 0) close(epoll_fd);
+    timer_fd = -1;
+    epoll_fd = -1;
+}
+
+/* Arm the timerfd to expire `ms` milliseconds from now or disarm it if there is no timer to wait for */
+static void timer_arm(uint32_t ms)
+{
+    struct itimerspec its = { 0 };
+    if(ms != LV_NO_TIMER_READY) {
+        its.it_value.tv_sec = ms / 1000;
+        its.it_value.tv_nsec = (long)(ms % 1000) * 1000000;
+    }
+
+    timerfd_settime(timer_fd, 0, &its, NULL);
+}
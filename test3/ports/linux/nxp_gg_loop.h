@@ -0,0 +1,53 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * Copyright 2025 NXP
+ */
+
+#ifndef NXP_GG_LOOP
+#define NXP_GG_LOOP
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/* Maximum number of file descriptors registered with `gg_loop_add_fd()` */
+#define GG_LOOP_MAX_FDS 16
+
+/* Called by `gg_loop_run()` when `events` (`EPOLLIN`, `EPOLLOUT`, ...) happened on `fd` */
+typedef void (*gg_loop_fd_cb_t)(int fd, uint32_t events, void * user_data);
+
+/*
+ * Create the epoll instance and the timerfd armed to the next LVGL deadline.
+ * Returns 0 on success or -1 with `errno` set.
+ */
+int gg_loop_init(void);
+
+/*
+ * Wake the loop when `events` happen on `fd` and call `cb` with them.
+ * The callback runs in the thread of `gg_loop_run()` so it can use LVGL.
+ * Returns 0 on success or -1 with `errno` set.
+ */
+int gg_loop_add_fd(int fd, uint32_t events, gg_loop_fd_cb_t cb, void * user_data);
+
+/* Stop waiting on `fd`. Returns 0 on success or -1 with `errno` set. */
+int gg_loop_remove_fd(int fd);
+
+/*
+ * Call `lv_timer_handler()` and sleep until the next LVGL deadline or until a registered
+ * file descriptor is ready. Returns after `gg_loop_quit()` or if waiting fails.
+ */
+void gg_loop_run(void);
+
+/* Make `gg_loop_run()` return after the current iteration */
+void gg_loop_quit(void);
+
+/* Close the epoll instance and the timerfd */
+void gg_loop_deinit(void);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* NXP_GG_LOOP */